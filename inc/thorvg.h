@@ -1473,6 +1473,8 @@ public:
      * @param[in] w A new width of the image in pixels.
      * @param[in] h A new height of the image in pixels.
      *
+     * @note If the size is given before load(), it's kept and serves as a decoding hint. The bitmap images such as JPG or WEBP
+     *       could be decoded in a reduced resolution close to the size, which saves the decoding time and memory.
      */
     Result size(float w, float h) noexcept;
 
@@ -1985,6 +1987,22 @@ public:
      */
     static Result term() noexcept;
 
+    /**
+     * @brief Sets the memory budget of the decoded images.
+     *
+     * The PNG, JPG and WEBP pictures of the same contents share their decoded images, which are kept within the budget.
+     * When a canvas finishes a frame over the budget, the least recently used images that weren't drawn in the frame are released,
+     * and they are decoded again on their next use.
+     *
+     * @param[in] bytes The memory budget in bytes, counting the encoded data and the decoded pixels of the images. @c 0 disables the image cache.
+     *
+     * @note The image cache is disabled by default. The budget can be changed at any time, the images loaded from the memory
+     *       while the image cache is disabled are not released.
+     *
+     * @note Experimental API
+     */
+    static Result cache(uint64_t bytes) noexcept;
+
     /**
      * @brief Retrieves the version of the TVG engine.
      *
@@ -2172,6 +2190,7 @@ public:
      * @retval Result::Unknown In case an empty paint is to be saved.
      *
      * @note Saving can be asynchronous if the assigned thread number is greater than zero. To guarantee the saving is done, call sync() afterwards.
+     * @note For PNG, the image is lossless at any @p quality, which trades the compression speed for the size instead. The default @p quality is the balanced compression.
      * @see Saver::sync()
      *
      * @since 0.5
@@ -2194,6 +2213,8 @@ public:
      *
      * @note A higher frames per second (FPS) would result in a larger file size. It is recommended to use the default value.
      * @note Saving can be asynchronous if the assigned thread number is greater than zero. To guarantee the saving is done, call sync() afterwards.
+     * @note For GIF, a @p quality below 90 chooses a histogram color quantizer, which is faster and suits gradients well, but approximates the colors of flat images.
+     * @note Y4M is a raw YUV 4:2:0 frame sequence for the video encoders, its frames are composed over black unless a background is given. It ignores the @p quality.
      *
      * @see Saver::sync()
      *
@@ -2201,6 +2222,34 @@ public:
      */
     Result save(Animation* animation, const char* filename, uint32_t quality = 100, uint32_t fps = 0) noexcept;
 
+    /**
+     * @brief Export the provided animation data through the given write function instead of a file.
+     *
+     * The encoded data is handed over to @p func in order, chunk by chunk, as the frames are encoded.
+     * This lets you stream the output (e.g., to a network connection) before the whole animation is rendered, or gather it in memory.
+     *
+     * @param[in] animation The animation to be saved, including all associated properties.
+     * @param[in] mimeType The output format such as "gif" or "y4m".
+     * @param[in] func The write function receiving the encoded data chunks and their sizes in bytes. Return @c false to abort the saving.
+     * @param[in] data Data passed to the @p func as its argument.
+     * @param[in] quality The encoded quality level. @c 0 is the minimum, @c 100 is the maximum value(recommended).
+     * @param[in] fps The desired frames per second (FPS). For example, to encode data at 60 FPS, pass 60. Pass 0 to keep the original frame data.
+     *
+     * @retval Result::InvalidArguments if the @p animation or the @p func is invalid.
+     * @retval Result::InsufficientCondition if there are ongoing resource-saving operations.
+     * @retval Result::NonSupport if an attempt is made to save in an unsupported format.
+     * @retval Result::Unknown if attempting to save an empty paint.
+     *
+     * @note The chunks are valid only during the @p func call. The @p func is called on the thread performing the saving, which can be a worker thread.
+     * @note Saving can be asynchronous if the assigned thread number is greater than zero. To guarantee the saving is done, call sync() afterwards.
+     *
+     * @see Saver::save(Animation* animation, const char* filename, uint32_t quality, uint32_t fps)
+     * @see Saver::sync()
+     *
+     * @note Experimental API
+     */
+    Result save(Animation* animation, const char* mimeType, std::function<bool(const uint8_t* chunk, uint32_t size, void* data)> func, void* data, uint32_t quality = 100, uint32_t fps = 0) noexcept;
+
     /**
      * @brief Guarantees that the saving task is finished.
      *
@@ -2208,6 +2257,9 @@ public:
      * Thus, if you wish to have a benefit of it, you must call sync() after the save() in the proper delayed time.
      * Otherwise, you can call sync() immediately.
      *
+     * @retval Result::InsufficientCondition if there is no saving in progress.
+     * @retval Result::Unknown if the saving has failed, e.g. the output couldn't be written or the write function aborted it.
+     *
      * @note The asynchronous tasking is dependent on the Saver module implementation.
      * @see Saver::save()
      *
@@ -37,6 +37,32 @@ static inline bool _floatExact(float a, float b)
 }
 
 
+//the significand times the power of ten, rounded into the float at once.
+static float _scale(unsigned long long significand, int exponent)
+{
+    static constexpr double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    if (significand == 0) return 0.0f;
+
+    auto val = static_cast<double>(significand);
+    //out of the float range anyway
+    if (exponent > 400) exponent = 400;
+    else if (exponent < -400) exponent = -400;
+
+    while (exponent > 22) {
+        val *= 1e22;
+        exponent -= 22;
+    }
+    while (exponent < -22) {
+        val /= 1e22;
+        exponent += 22;
+    }
+    val = (exponent < 0) ? (val / pow10[-exponent]) : (val * pow10[exponent]);
+    return static_cast<float>(val);
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -63,7 +89,9 @@ float toFloat(const char *str, char **end)
     auto a = str;
     auto iter = str;
     auto val = 0.0f;
-    unsigned long long integerPart = 0;
+    unsigned long long significand = 0;    //the digits of the integer and the decimal parts, scaled once
+    int digits = 0;                         //significant digits in the significand
+    int exponent = 0;                       //power of ten of the significand
     int minus = 1;
 
     //ignore leading whitespaces
@@ -102,39 +130,38 @@ float toFloat(const char *str, char **end)
     //Optional: integer part before dot
     if (isdigit(*iter)) {
         for (; isdigit(*iter); iter++) {
-            integerPart = integerPart * 10ULL + (unsigned long long) (*iter - '0');
+            if (digits < 19) {
+                significand = significand * 10ULL + static_cast<unsigned long long>(*iter - '0');
+                if (significand > 0) ++digits;
+            } else ++exponent;
         }
         a = iter;
     } else if (*iter != '.') {
         goto success;
     }
 
-    val = static_cast<float>(integerPart);
-
     //Optional: decimal part after dot
     if (*iter == '.') {
-        unsigned long long decimalPart = 0;
-        unsigned long long pow10 = 1;
-        int count = 0;
-
         iter++;
 
         if (isdigit(*iter)) {
-            for (; isdigit(*iter); iter++, count++) {
-                if (count < 19) {
-                    decimalPart = decimalPart * 10ULL + +static_cast<unsigned long long>(*iter - '0');
-                    pow10 *= 10ULL;
+            for (; isdigit(*iter); iter++) {
+                if (digits < 19) {
+                    significand = significand * 10ULL + static_cast<unsigned long long>(*iter - '0');
+                    if (significand > 0) ++digits;
+                    --exponent;
                 }
             }
         } else if (isspace(*iter)) { //skip if there is a space after the dot.
+            val = _scale(significand, exponent);
             a = iter;
             goto success;
         }
-
-        val += static_cast<float>(decimalPart) / static_cast<float>(pow10);
         a = iter;
     }
 
+    val = _scale(significand, exponent);
+
     //Optional: exponent
     if (*iter == 'e' || *iter == 'E') {
         ++iter;
@@ -161,7 +188,7 @@ float toFloat(const char *str, char **end)
         if (isdigit(*iter)) {
             while (*iter == '0') iter++;
             for (; isdigit(*iter); iter++) {
-                exponentPart = exponentPart * 10U + static_cast<unsigned int>(*iter - '0');
+                if (exponentPart < 10000U) exponentPart = exponentPart * 10U + static_cast<unsigned int>(*iter - '0');
             }
         } else if (!isdigit(*(a - 1))) {
             a = str;
@@ -179,17 +206,7 @@ float toFloat(const char *str, char **end)
         }
 
         a = iter;
-        auto scale = 1.0f;
-
-        while (exponentPart >= 8U) {
-            scale *= 1E8f;
-            exponentPart -= 8U;
-        }
-        while (exponentPart > 0U) {
-            scale *= 10.0f;
-            exponentPart--;
-        }
-        val = (minus_e == -1) ? (val / scale) : (val * scale);
+        val = _scale(significand, exponent + minus_e * static_cast<int>(exponentPart));
     } else if ((iter > str) && !isdigit(*(iter - 1))) {
         a = str;
         goto success;
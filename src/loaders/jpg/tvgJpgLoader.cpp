@@ -38,10 +38,10 @@ void JpgLoader::clear()
 
 void JpgLoader::run(unsigned tid)
 {
-    surface.buf8 = jpgdDecompress(decoder);
-    surface.stride = static_cast<uint32_t>(w);
-    surface.w = static_cast<uint32_t>(w);
-    surface.h = static_cast<uint32_t>(h);
+    surface.buf8 = jpgdDecompress(decoder, scale);
+    surface.w = (static_cast<uint32_t>(w) + (1 << scale) - 1) >> scale;
+    surface.h = (static_cast<uint32_t>(h) + (1 << scale) - 1) >> scale;
+    surface.stride = surface.w;
     surface.cs = ColorSpace::ARGB8888;
     surface.channelSize = sizeof(uint32_t);
     surface.premultiplied = true;
@@ -121,6 +121,18 @@ bool JpgLoader::read()
 }
 
 
+bool JpgLoader::hint(float w, float h)
+{
+    if (readied || w <= 0.0f || h <= 0.0f) return false;
+
+    //the largest 1/2, 1/4 or 1/8 scale not smaller than the desired size
+    auto s = std::min(w / this->w, h / this->h);
+    scale = 0;
+    while (scale < 3 && s * float(2 << scale) <= 1.0f) ++scale;
+    return scale > 0;
+}
+
+
 bool JpgLoader::close()
 {
     if (!LoadModule::close()) return false;
@@ -129,6 +141,14 @@ bool JpgLoader::close()
 }
 
 
+char* JpgLoader::handover()
+{
+    if (!freeData) return nullptr;
+    freeData = false;
+    return data;
+}
+
+
 RenderSurface* JpgLoader::bitmap()
 {
     this->done();
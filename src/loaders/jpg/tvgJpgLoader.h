@@ -32,6 +32,7 @@ class JpgLoader : public ImageLoader, public Task
 private:
     jpeg_decoder* decoder = nullptr;
     char* data = nullptr;
+    int scale = 0;          //the dct domain downscaling: 1/(2^scale)
     bool freeData = false;
 
     void clear();
@@ -45,6 +46,8 @@ public:
     bool open(const char* data, uint32_t size, const char* rpath, bool copy) override;
     bool read() override;
     bool close() override;
+    bool hint(float w, float h) override;
+    char* handover() override;
 
     RenderSurface* bitmap() override;
 };
@@ -38,6 +38,12 @@
 #include "tvgCommon.h"
 #include "tvgJpgd.h"
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    #include <immintrin.h>
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+    #include <arm_neon.h>
+#endif
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -141,6 +147,10 @@ public:
     // Call this method after constructing the object to begin decompression.
     // If JPGD_SUCCESS is returned you may then call decode() on each scanline.
     int begin_decoding();
+    // Call this method before begin_decoding() to decode the image in 1/2, 1/4 or 1/8 size (shift 1, 2 or 3) in the DCT domain.
+    inline void set_scale(int shift) { if (!m_ready_flag) m_scale = shift; }
+    // Call this method before begin_decoding() to decode by the scalar paths even if the vector paths are built.
+    inline void set_simd(bool simd) { if (!m_ready_flag) m_simd = simd; }
     // Returns the next scan line.
     // For grayscale images, pScan_line will point to a buffer containing 8-bit pixels (get_bytes_per_pixel() will return 1).
     // Otherwise, it will always point to a buffer containing 32-bit RGBA pixels (A will always be 255, and get_bytes_per_pixel() will return 4).
@@ -151,6 +161,8 @@ public:
     inline jpgd_status get_error_code() const { return m_error_code; }
     inline int get_width() const { return m_image_x_size; }
     inline int get_height() const { return m_image_y_size; }
+    inline int get_scaled_width() const { return (m_image_x_size + (1 << m_scale) - 1) >> m_scale; }
+    inline int get_scaled_height() const { return (m_image_y_size + (1 << m_scale) - 1) >> m_scale; }
     inline int get_num_components() const { return m_comps_in_frame; }
     inline int get_bytes_per_pixel() const { return m_dest_bytes_per_pixel; }
     inline int get_bytes_per_scan_line() const { return m_image_x_size * get_bytes_per_pixel(); }
@@ -247,6 +259,8 @@ private:
     int m_expanded_blocks_per_row;
     int m_expanded_blocks_per_component;
     bool  m_freq_domain_chroma_upsample;
+    int m_scale;                                  // the DCT domain downscaling shift (0 ~ 3)
+    bool m_simd;                                  // use the vector idct and color conversion if they are built
     int m_max_mcus_per_col;
     uint32_t m_last_dc_val[JPGD_MAX_COMPONENTS];
     jpgd_block_t* m_pMCU_coefficients;
@@ -305,6 +319,7 @@ private:
     void H1V1Convert();
     void gray_convert();
     void expanded_convert();
+    void scaled_convert();
     void find_eoi();
     inline uint32_t get_char();
     inline uint32_t get_char(bool *pPadding_flag);
@@ -517,6 +532,157 @@ struct Col<1>
 };
 
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+
+// SIMD IDCT, 4 rows or columns of the 8x8 block per vector in 32-bit lanes.
+// The arithmetic is the same as Row<8> and Col<8> above, so the results are identical with the scalar path.
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+
+typedef __m128i SimdInt;
+
+static inline SimdInt simdLoad4(const jpgd_block_t* p) { return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)p)); }
+static inline SimdInt simdZero() { return _mm_setzero_si128(); }
+static inline SimdInt simdAdd(SimdInt a, SimdInt b) { return _mm_add_epi32(a, b); }
+static inline SimdInt simdSub(SimdInt a, SimdInt b) { return _mm_sub_epi32(a, b); }
+static inline SimdInt simdMul(SimdInt a, int32_t b) { return _mm_mullo_epi32(a, _mm_set1_epi32(b)); }
+static inline SimdInt simdAddConst(SimdInt a, int32_t b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+#define SIMD_SHL(a, n) _mm_slli_epi32(a, n)
+#define SIMD_SAR(a, n) _mm_srai_epi32(a, n)
+
+static inline void simdTranspose4(SimdInt& a, SimdInt& b, SimdInt& c, SimdInt& d)
+{
+    auto t0 = _mm_unpacklo_epi32(a, b);
+    auto t1 = _mm_unpacklo_epi32(c, d);
+    auto t2 = _mm_unpackhi_epi32(a, b);
+    auto t3 = _mm_unpackhi_epi32(c, d);
+    a = _mm_unpacklo_epi64(t0, t1);
+    b = _mm_unpackhi_epi64(t0, t1);
+    c = _mm_unpacklo_epi64(t2, t3);
+    d = _mm_unpackhi_epi64(t2, t3);
+}
+
+//saturates to 0 ~ 255 as CLAMP() does
+static inline void simdStore8(uint8_t* p, SimdInt lo, SimdInt hi)
+{
+    auto v = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64((__m128i*)p, _mm_packus_epi16(v, v));
+}
+
+#else
+
+typedef int32x4_t SimdInt;
+
+static inline SimdInt simdLoad4(const jpgd_block_t* p) { return vmovl_s16(vld1_s16(p)); }
+static inline SimdInt simdZero() { return vdupq_n_s32(0); }
+static inline SimdInt simdAdd(SimdInt a, SimdInt b) { return vaddq_s32(a, b); }
+static inline SimdInt simdSub(SimdInt a, SimdInt b) { return vsubq_s32(a, b); }
+static inline SimdInt simdMul(SimdInt a, int32_t b) { return vmulq_n_s32(a, b); }
+static inline SimdInt simdAddConst(SimdInt a, int32_t b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+#define SIMD_SHL(a, n) vshlq_n_s32(a, n)
+#define SIMD_SAR(a, n) vshrq_n_s32(a, n)
+
+static inline void simdTranspose4(SimdInt& a, SimdInt& b, SimdInt& c, SimdInt& d)
+{
+    auto p = vtrnq_s32(a, b);
+    auto q = vtrnq_s32(c, d);
+    a = vcombine_s32(vget_low_s32(p.val[0]), vget_low_s32(q.val[0]));
+    b = vcombine_s32(vget_low_s32(p.val[1]), vget_low_s32(q.val[1]));
+    c = vcombine_s32(vget_high_s32(p.val[0]), vget_high_s32(q.val[0]));
+    d = vcombine_s32(vget_high_s32(p.val[1]), vget_high_s32(q.val[1]));
+}
+
+//saturates to 0 ~ 255 as CLAMP() does
+static inline void simdStore8(uint8_t* p, SimdInt lo, SimdInt hi)
+{
+    vst1_u8(p, vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))));
+}
+
+#endif
+
+
+//8x8 matrix in the halves of 4 columns: lo[row] = cols 0~3, hi[row] = cols 4~7
+static inline void simdTranspose8(SimdInt* lo, SimdInt* hi)
+{
+    simdTranspose4(lo[0], lo[1], lo[2], lo[3]);
+    simdTranspose4(hi[4], hi[5], hi[6], hi[7]);
+    simdTranspose4(hi[0], hi[1], hi[2], hi[3]);
+    simdTranspose4(lo[4], lo[5], lo[6], lo[7]);
+    for (int i = 0; i < 4; ++i) {
+        auto t = hi[i];
+        hi[i] = lo[i + 4];
+        lo[i + 4] = t;
+    }
+}
+
+
+template<int SHIFT, int32_t BIAS>
+static inline void simdIdct1D(SimdInt* v)
+{
+    const auto z2 = v[2], z3 = v[6];
+    const auto z1 = simdMul(simdAdd(z2, z3), FIX_0_541196100);
+    const auto tmp2 = simdAdd(z1, simdMul(z3, -FIX_1_847759065));
+    const auto tmp3 = simdAdd(z1, simdMul(z2, FIX_0_765366865));
+
+    const auto tmp0 = SIMD_SHL(simdAdd(v[0], v[4]), CONST_BITS);
+    const auto tmp1 = SIMD_SHL(simdSub(v[0], v[4]), CONST_BITS);
+
+    const auto tmp10 = simdAdd(tmp0, tmp3), tmp13 = simdSub(tmp0, tmp3), tmp11 = simdAdd(tmp1, tmp2), tmp12 = simdSub(tmp1, tmp2);
+
+    const auto atmp0 = v[7], atmp1 = v[5], atmp2 = v[3], atmp3 = v[1];
+
+    const auto bz1 = simdAdd(atmp0, atmp3), bz2 = simdAdd(atmp1, atmp2), bz3 = simdAdd(atmp0, atmp2), bz4 = simdAdd(atmp1, atmp3);
+    const auto bz5 = simdMul(simdAdd(bz3, bz4), FIX_1_175875602);
+
+    const auto az1 = simdMul(bz1, -FIX_0_899976223);
+    const auto az2 = simdMul(bz2, -FIX_2_562915447);
+    const auto az3 = simdAdd(simdMul(bz3, -FIX_1_961570560), bz5);
+    const auto az4 = simdAdd(simdMul(bz4, -FIX_0_390180644), bz5);
+
+    const auto btmp0 = simdAdd(simdAdd(simdMul(atmp0, FIX_0_298631336), az1), az3);
+    const auto btmp1 = simdAdd(simdAdd(simdMul(atmp1, FIX_2_053119869), az2), az4);
+    const auto btmp2 = simdAdd(simdAdd(simdMul(atmp2, FIX_3_072711026), az2), az3);
+    const auto btmp3 = simdAdd(simdAdd(simdMul(atmp3, FIX_1_501321110), az1), az4);
+
+    #define SIMD_DESCALE(x) SIMD_SAR(simdAddConst(x, BIAS + (SCALEDONE << (SHIFT - 1))), SHIFT)
+    v[0] = SIMD_DESCALE(simdAdd(tmp10, btmp3));
+    v[7] = SIMD_DESCALE(simdSub(tmp10, btmp3));
+    v[1] = SIMD_DESCALE(simdAdd(tmp11, btmp2));
+    v[6] = SIMD_DESCALE(simdSub(tmp11, btmp2));
+    v[2] = SIMD_DESCALE(simdAdd(tmp12, btmp1));
+    v[5] = SIMD_DESCALE(simdSub(tmp12, btmp1));
+    v[3] = SIMD_DESCALE(simdAdd(tmp13, btmp0));
+    v[4] = SIMD_DESCALE(simdSub(tmp13, btmp0));
+    #undef SIMD_DESCALE
+}
+
+
+static void simdIdct(const jpgd_block_t* pSrc, uint8_t* pDst, int rows, int cols)
+{
+    SimdInt lo[8], hi[8];
+
+    for (int i = 0; i < 8; ++i) {
+        lo[i] = (i < rows) ? simdLoad4(pSrc + i * 8) : simdZero();
+        hi[i] = (i < rows && cols > 4) ? simdLoad4(pSrc + i * 8 + 4) : simdZero();
+    }
+
+    //row pass over the transposed block: the lanes are the rows.
+    simdTranspose8(lo, hi);
+    simdIdct1D<CONST_BITS - PASS1_BITS, 0>(lo);
+    simdIdct1D<CONST_BITS - PASS1_BITS, 0>(hi);
+
+    //column pass: the lanes are the columns.
+    simdTranspose8(lo, hi);
+    simdIdct1D<CONST_BITS + PASS1_BITS + 3, (128 << (CONST_BITS + PASS1_BITS + 3))>(lo);
+    simdIdct1D<CONST_BITS + PASS1_BITS + 3, (128 << (CONST_BITS + PASS1_BITS + 3))>(hi);
+
+    for (int i = 0; i < 8; ++i, pDst += 8) simdStore8(pDst, lo[i], hi[i]);
+}
+
+#endif
+
+
+
 static const uint8_t s_idct_row_table[] = {
     1,0,0,0,0,0,0,0, 2,0,0,0,0,0,0,0, 2,1,0,0,0,0,0,0, 2,1,1,0,0,0,0,0, 2,2,1,0,0,0,0,0, 3,2,1,0,0,0,0,0, 4,2,1,0,0,0,0,0, 4,3,1,0,0,0,0,0,
     4,3,2,0,0,0,0,0, 4,3,2,1,0,0,0,0, 4,3,2,1,1,0,0,0, 4,3,2,2,1,0,0,0, 4,3,3,2,1,0,0,0, 4,4,3,2,1,0,0,0, 5,4,3,2,1,0,0,0, 6,4,3,2,1,0,0,0,
@@ -532,7 +698,7 @@ static const uint8_t s_idct_row_table[] = {
 static const uint8_t s_idct_col_table[] = { 1, 1, 2, 3, 3, 3, 3, 3, 3, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8 };
 
 
-void idct(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag)
+void idct(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag, TVG_UNUSED bool simd)
 {
     JPGD_ASSERT(block_max_zag >= 1);
     JPGD_ASSERT(block_max_zag <= 64);
@@ -550,6 +716,13 @@ void idct(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag)
       return;
     }
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (simd) {
+        simdIdct(pSrc_ptr, pDst_ptr, s_idct_col_table[block_max_zag - 1], 8);
+        return;
+    }
+#endif
+
     int temp[64];
     const jpgd_block_t* pSrc = pSrc_ptr;
     int* pTemp = temp;
@@ -591,8 +764,15 @@ void idct(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag)
 }
 
 
-void idct_4x4(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr)
+void idct_4x4(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, TVG_UNUSED bool simd)
 {
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (simd) {
+        simdIdct(pSrc_ptr, pDst_ptr, 4, 4);
+        return;
+    }
+#endif
+
     int temp[64];
     int* pTemp = temp;
     const jpgd_block_t* pSrc = pSrc_ptr;
@@ -613,6 +793,93 @@ void idct_4x4(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr)
 }
 
 
+// Reduced size IDCTs for the DCT domain downscaling, after the IJG's jidctred.c.
+#define FIX_0_211164243  ((int32_t)1730)
+#define FIX_0_509795579  ((int32_t)4176)
+#define FIX_0_601344887  ((int32_t)4926)
+#define FIX_0_720959822  ((int32_t)5906)
+#define FIX_0_850430095  ((int32_t)6967)
+#define FIX_1_061594337  ((int32_t)8697)
+#define FIX_1_272758580  ((int32_t)10426)
+#define FIX_1_451774981  ((int32_t)11893)
+#define FIX_2_172734803  ((int32_t)17799)
+#define FIX_3_624509785  ((int32_t)29692)
+
+
+// 4 points from 8 coefficients with the given stride
+static inline void idct4(const int* in, int stride, int& o0, int& o1, int& o2, int& o3, int shift, int bias)
+{
+    const int tmp0 = static_cast<unsigned int>(in[0]) << (CONST_BITS + 1);
+    const int tmp2 = MULTIPLY(in[stride * 2], FIX_1_847759065) + MULTIPLY(in[stride * 6], - FIX_0_765366865);
+    const int tmp10 = tmp0 + tmp2, tmp12 = tmp0 - tmp2;
+
+    const int z1 = in[stride * 7], z2 = in[stride * 5], z3 = in[stride * 3], z4 = in[stride * 1];
+    const int otmp0 = MULTIPLY(z1, - FIX_0_211164243) + MULTIPLY(z2, FIX_1_451774981) + MULTIPLY(z3, - FIX_2_172734803) + MULTIPLY(z4, FIX_1_061594337);
+    const int otmp2 = MULTIPLY(z1, - FIX_0_509795579) + MULTIPLY(z2, - FIX_0_601344887) + MULTIPLY(z3, FIX_0_899976223) + MULTIPLY(z4, FIX_2_562915447);
+
+    const int half = (SCALEDONE << (shift - 1)) + bias;
+    o0 = (tmp10 + otmp2 + half) >> shift;
+    o3 = (tmp10 - otmp2 + half) >> shift;
+    o1 = (tmp12 + otmp0 + half) >> shift;
+    o2 = (tmp12 - otmp0 + half) >> shift;
+}
+
+
+// 2 points from 8 coefficients with the given stride
+static inline void idct2(const int* in, int stride, int& o0, int& o1, int shift, int bias)
+{
+    const int tmp10 = static_cast<unsigned int>(in[0]) << (CONST_BITS + 2);
+    const int tmp0 = MULTIPLY(in[stride * 7], - FIX_0_720959822) + MULTIPLY(in[stride * 5], FIX_0_850430095) + MULTIPLY(in[stride * 3], - FIX_1_272758580) + MULTIPLY(in[stride * 1], FIX_3_624509785);
+
+    const int half = (SCALEDONE << (shift - 1)) + bias;
+    o0 = (tmp10 + tmp0 + half) >> shift;
+    o1 = (tmp10 - tmp0 + half) >> shift;
+}
+
+
+// Outputs the (8 >> shift) x (8 >> shift) pixels in the top-left of the 8x8 destination block.
+void idct_scaled(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag, int shift)
+{
+    const int size = 8 >> shift;
+
+    if (block_max_zag <= 1 || shift == 3) {
+        int k = ((pSrc_ptr[0] + 4) >> 3) + 128;
+        k = CLAMP(k);
+        for (int y = 0; y < size; ++y, pDst_ptr += 8) {
+            for (int x = 0; x < size; ++x) pDst_ptr[x] = static_cast<uint8_t>(k);
+        }
+        return;
+    }
+
+    int src[64], temp[64];
+    for (int i = 0; i < 64; ++i) src[i] = pSrc_ptr[i];
+
+    //columns, then rows
+    if (size == 4) {
+        for (int x = 0; x < 8; ++x) {
+            if (x == 4) continue;  //not used by the second pass
+            idct4(src + x, 8, temp[x], temp[8 + x], temp[16 + x], temp[24 + x], CONST_BITS - PASS1_BITS + 1, 0);
+        }
+        for (int y = 0; y < 4; ++y, pDst_ptr += 8) {
+            int o[4];
+            idct4(temp + y * 8, 1, o[0], o[1], o[2], o[3], CONST_BITS + PASS1_BITS + 3 + 1, 128 << (CONST_BITS + PASS1_BITS + 3 + 1));
+            for (int x = 0; x < 4; ++x) pDst_ptr[x] = static_cast<uint8_t>(CLAMP(o[x]));
+        }
+    } else {
+        for (int x = 0; x < 8; ++x) {
+            if (x == 2 || x == 4 || x == 6) continue;  //not used by the second pass
+            idct2(src + x, 8, temp[x], temp[8 + x], CONST_BITS - PASS1_BITS + 2, 0);
+        }
+        for (int y = 0; y < 2; ++y, pDst_ptr += 8) {
+            int o[2];
+            idct2(temp + y * 8, 1, o[0], o[1], CONST_BITS + PASS1_BITS + 3 + 2, 128 << (CONST_BITS + PASS1_BITS + 3 + 2));
+            pDst_ptr[0] = static_cast<uint8_t>(CLAMP(o[0]));
+            pDst_ptr[1] = static_cast<uint8_t>(CLAMP(o[1]));
+        }
+    }
+}
+
+
 // Retrieve one character from the input stream.
 inline uint32_t jpeg_decoder::get_char()
 {
@@ -1524,6 +1791,8 @@ void jpeg_decoder::init(jpeg_decoder_stream *pStream)
     m_expanded_blocks_per_mcu = 0;
     m_expanded_blocks_per_row = 0;
     m_freq_domain_chroma_upsample = false;
+    m_scale = 0;
+    m_simd = true;
 
     memset(m_mcu_org, 0, sizeof(m_mcu_org));
 
@@ -1589,6 +1858,116 @@ void jpeg_decoder::init(jpeg_decoder_stream *pStream)
 #define FIX(x)    ((int) ((x) * (1L<<SCALEBITS) + 0.5f))
 
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+
+// Converts 8 pixels into RGBA with the same fixed point math as the look up tables, so the results are identical.
+// If half is true, 4 chroma samples are horizontally doubled for the 8 pixels.
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+
+static inline __m128i simdChroma(const uint8_t* c, bool half)
+{
+    if (half) {
+        uint32_t v;
+        memcpy(&v, c, 4);
+        auto p = _mm_cvtsi32_si128(v);
+        return _mm_unpacklo_epi8(p, p);
+    }
+    return _mm_loadl_epi64((const __m128i*)c);
+}
+
+
+static inline __m128i simdYcc(__m128i y, __m128i k1, int32_t f1, __m128i k2, int32_t f2, int32_t bias)
+{
+    auto v = _mm_add_epi32(_mm_mullo_epi32(k1, _mm_set1_epi32(f1)), _mm_set1_epi32(bias));
+    if (f2) v = _mm_add_epi32(v, _mm_mullo_epi32(k2, _mm_set1_epi32(f2)));
+    return _mm_add_epi32(y, _mm_srai_epi32(v, SCALEBITS));
+}
+
+
+static void simdYccToRgba(uint8_t* d, const uint8_t* y, const uint8_t* cb, const uint8_t* cr, bool half)
+{
+    auto zero = _mm_setzero_si128();
+    auto k128 = _mm_set1_epi16(128);
+    auto yy = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)y), zero);
+    auto kb = _mm_sub_epi16(_mm_unpacklo_epi8(simdChroma(cb, half), zero), k128);
+    auto kr = _mm_sub_epi16(_mm_unpacklo_epi8(simdChroma(cr, half), zero), k128);
+
+    __m128i rgb[3];
+    for (int i = 0; i < 2; ++i) {
+        auto y32 = i ? _mm_cvtepi16_epi32(_mm_srli_si128(yy, 8)) : _mm_cvtepi16_epi32(yy);
+        auto kb32 = i ? _mm_cvtepi16_epi32(_mm_srli_si128(kb, 8)) : _mm_cvtepi16_epi32(kb);
+        auto kr32 = i ? _mm_cvtepi16_epi32(_mm_srli_si128(kr, 8)) : _mm_cvtepi16_epi32(kr);
+        auto r = simdYcc(y32, kr32, FIX(1.40200f), zero, 0, ONE_HALF);
+        auto g = simdYcc(y32, kr32, -FIX(0.71414f), kb32, -FIX(0.34414f), ONE_HALF);
+        auto b = simdYcc(y32, kb32, FIX(1.77200f), zero, 0, ONE_HALF);
+        if (i) {
+            rgb[0] = _mm_packs_epi32(rgb[0], r);
+            rgb[1] = _mm_packs_epi32(rgb[1], g);
+            rgb[2] = _mm_packs_epi32(rgb[2], b);
+        } else {
+            rgb[0] = r;
+            rgb[1] = g;
+            rgb[2] = b;
+        }
+    }
+    auto rg = _mm_unpacklo_epi8(_mm_packus_epi16(rgb[0], rgb[0]), _mm_packus_epi16(rgb[1], rgb[1]));
+    auto ba = _mm_unpacklo_epi8(_mm_packus_epi16(rgb[2], rgb[2]), _mm_set1_epi8(-1));
+    _mm_storeu_si128((__m128i*)d, _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128((__m128i*)(d + 16), _mm_unpackhi_epi16(rg, ba));
+}
+
+#else
+
+static inline int16x8_t simdChroma(const uint8_t* c, bool half)
+{
+    uint8x8_t v;
+    if (half) {
+        uint32_t p;
+        memcpy(&p, c, 4);
+        auto t = vreinterpret_u8_u32(vdup_n_u32(p));
+        v = vzip_u8(t, t).val[0];
+    } else v = vld1_u8(c);
+    return vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+}
+
+
+static inline int32x4_t simdYcc(int32x4_t y, int32x4_t k1, int32_t f1, int32x4_t k2, int32_t f2, int32_t bias)
+{
+    auto v = vaddq_s32(vmulq_n_s32(k1, f1), vdupq_n_s32(bias));
+    if (f2) v = vaddq_s32(v, vmulq_n_s32(k2, f2));
+    return vaddq_s32(y, vshrq_n_s32(v, SCALEBITS));
+}
+
+
+static void simdYccToRgba(uint8_t* d, const uint8_t* y, const uint8_t* cb, const uint8_t* cr, bool half)
+{
+    auto yy = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y)));
+    auto kb = simdChroma(cb, half);
+    auto kr = simdChroma(cr, half);
+
+    int16x4_t r[2], g[2], b[2];
+    for (int i = 0; i < 2; ++i) {
+        auto y32 = vmovl_s16(i ? vget_high_s16(yy) : vget_low_s16(yy));
+        auto kb32 = vmovl_s16(i ? vget_high_s16(kb) : vget_low_s16(kb));
+        auto kr32 = vmovl_s16(i ? vget_high_s16(kr) : vget_low_s16(kr));
+        r[i] = vqmovn_s32(simdYcc(y32, kr32, FIX(1.40200f), kr32, 0, ONE_HALF));
+        g[i] = vqmovn_s32(simdYcc(y32, kr32, -FIX(0.71414f), kb32, -FIX(0.34414f), ONE_HALF));
+        b[i] = vqmovn_s32(simdYcc(y32, kb32, FIX(1.77200f), kb32, 0, ONE_HALF));
+    }
+    uint8x8x4_t rgba;
+    rgba.val[0] = vqmovun_s16(vcombine_s16(r[0], r[1]));
+    rgba.val[1] = vqmovun_s16(vcombine_s16(g[0], g[1]));
+    rgba.val[2] = vqmovun_s16(vcombine_s16(b[0], b[1]));
+    rgba.val[3] = vdup_n_u8(255);
+    vst4_u8(d, rgba);
+}
+
+#endif
+
+#endif
+
+
 // Create a few tables that allow us to quickly convert YCbCr to RGB.
 void jpeg_decoder::create_look_ups()
 {
@@ -1626,8 +2005,17 @@ void jpeg_decoder::transform_mcu(int mcu_row)
     jpgd_block_t* pSrc_ptr = m_pMCU_coefficients;
     uint8_t* pDst_ptr = m_pSample_buf + mcu_row * m_blocks_per_mcu * 64;
 
+    if (m_scale > 0) {
+        for (int mcu_block = 0; mcu_block < m_blocks_per_mcu; mcu_block++) {
+            idct_scaled(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block], m_scale);
+            pSrc_ptr += 64;
+            pDst_ptr += 64;
+        }
+        return;
+    }
+
     for (int mcu_block = 0; mcu_block < m_blocks_per_mcu; mcu_block++) {
-        idct(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block]);
+        idct(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block], m_simd);
         pSrc_ptr += 64;
         pDst_ptr += 64;
     }
@@ -1651,7 +2039,7 @@ void jpeg_decoder::transform_mcu_expand(int mcu_row)
     // Y IDCT
     int mcu_block;
     for (mcu_block = 0; mcu_block < m_expanded_blocks_per_component; mcu_block++) {
-        idct(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block]);
+        idct(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block], m_simd);
         pSrc_ptr += 64;
         pDst_ptr += 64;
     }
@@ -1738,19 +2126,19 @@ void jpeg_decoder::transform_mcu_expand(int mcu_row)
         DCT_Upsample::Matrix44& d = R;
 
         DCT_Upsample::Matrix44::add_and_store(temp_block, a, c);
-        idct_4x4(temp_block, pDst_ptr);
+        idct_4x4(temp_block, pDst_ptr, m_simd);
         pDst_ptr += 64;
 
         DCT_Upsample::Matrix44::sub_and_store(temp_block, a, c);
-        idct_4x4(temp_block, pDst_ptr);
+        idct_4x4(temp_block, pDst_ptr, m_simd);
         pDst_ptr += 64;
 
         DCT_Upsample::Matrix44::add_and_store(temp_block, b, d);
-        idct_4x4(temp_block, pDst_ptr);
+        idct_4x4(temp_block, pDst_ptr, m_simd);
         pDst_ptr += 64;
 
         DCT_Upsample::Matrix44::sub_and_store(temp_block, b, d);
-        idct_4x4(temp_block, pDst_ptr);
+        idct_4x4(temp_block, pDst_ptr, m_simd);
         pDst_ptr += 64;
         pSrc_ptr += 64;
     }
@@ -1947,6 +2335,15 @@ void jpeg_decoder::H1V1Convert()
     uint8_t *d = m_pScan_line_0;
     uint8_t *s = m_pSample_buf + row * 8;
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (m_simd) {
+        for (int i = m_max_mcus_per_row; i > 0; i--, s += 64*3, d += 32) {
+            simdYccToRgba(d, s, s + 64, s + 128, false);
+        }
+        return;
+    }
+#endif
+
     for (int i = m_max_mcus_per_row; i > 0; i--) {
         for (int j = 0; j < 8; j++) {
             int y = s[j];
@@ -1972,6 +2369,19 @@ void jpeg_decoder::H2V1Convert()
     uint8_t *y = m_pSample_buf + row * 8;
     uint8_t *c = m_pSample_buf + 2*64 + row * 8;
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (m_simd) {
+        for (int i = m_max_mcus_per_row; i > 0; i--) {
+            for (int l = 0; l < 2; l++, y += 64, c += 4, d0 += 32) {
+                simdYccToRgba(d0, y, c, c + 64, true);
+            }
+            y += 64*4 - 64*2;
+            c += 64*4 - 8;
+        }
+        return;
+    }
+#endif
+
     for (int i = m_max_mcus_per_row; i > 0; i--) {
         for (int l = 0; l < 2; l++) {
             for (int j = 0; j < 4; j++) {
@@ -2018,6 +2428,16 @@ void jpeg_decoder::H1V2Convert()
 
     c = m_pSample_buf + 64*2 + (row >> 1) * 8;
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (m_simd) {
+        for (int i = m_max_mcus_per_row; i > 0; i--, y += 64*4, c += 64*4, d0 += 32, d1 += 32) {
+            simdYccToRgba(d0, y, c, c + 64, false);
+            simdYccToRgba(d1, y + 8, c, c + 64, false);
+        }
+        return;
+    }
+#endif
+
     for (int i = m_max_mcus_per_row; i > 0; i--) {
         for (int j = 0; j < 8; j++) {
             int cb = c[0+j];
@@ -2062,6 +2482,20 @@ void jpeg_decoder::H2V2Convert()
 
     c = m_pSample_buf + 64*4 + (row >> 1) * 8;
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (m_simd) {
+        for (int i = m_max_mcus_per_row; i > 0; i--) {
+            for (int l = 0; l < 2; l++, y += 64, c += 4, d0 += 32, d1 += 32) {
+                simdYccToRgba(d0, y, c, c + 64, true);
+                simdYccToRgba(d1, y + 8, c, c + 64, true);
+            }
+            y += 64*6 - 64*2;
+            c += 64*6 - 8;
+        }
+        return;
+    }
+#endif
+
     for (int i = m_max_mcus_per_row; i > 0; i--) {
         for (int l = 0; l < 2; l++) {
             for (int j = 0; j < 8; j += 2) {
@@ -2136,6 +2570,14 @@ void jpeg_decoder::expanded_convert()
             const int Y_ofs = k * 8;
             const int Cb_ofs = Y_ofs + 64 * m_expanded_blocks_per_component;
             const int Cr_ofs = Y_ofs + 64 * m_expanded_blocks_per_component * 2;
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+            if (m_simd) {
+                simdYccToRgba(d, Py + Y_ofs, Py + Cb_ofs, Py + Cr_ofs, false);
+                d += 32;
+                continue;
+            }
+#endif
             for (int j = 0; j < 8; j++) {
                 int y = Py[Y_ofs + j];
                 int cb = Py[Cb_ofs + j];
@@ -2154,6 +2596,40 @@ void jpeg_decoder::expanded_convert()
 }
 
 
+// Any subsampling of the DCT domain downscaled blocks to RGB or 8-bit grayscale.
+// The blocks keep the 8 pixels stride and the chroma is upsampled by the nearest sample.
+void jpeg_decoder::scaled_convert()
+{
+    const int size = 8 >> m_scale;
+    const int row = m_max_mcu_y_size - m_mcu_lines_left;
+    const int hsamp = m_comp_h_samp[0];
+    const int vsamp = m_comp_v_samp[0];
+    const int luma = (row / size) * hsamp * 64 + (row % size) * 8;
+    const int chroma = hsamp * vsamp * 64 + (row / vsamp) * 8;
+    const uint8_t* s = m_pSample_buf;
+    uint8_t* d = m_pScan_line_0;
+
+    for (int i = m_max_mcus_per_row; i > 0; i--) {
+        for (int x = 0; x < m_max_mcu_x_size; x++) {
+            int y = s[luma + (x / size) * 64 + (x % size)];
+            if (m_scan_type == JPGD_GRAYSCALE) {
+                *d++ = static_cast<uint8_t>(y);
+                continue;
+            }
+            int cb = s[chroma + x / hsamp];
+            int cr = s[chroma + 64 + x / hsamp];
+
+            d[0] = clamp(y + m_crr[cr]);
+            d[1] = clamp(y + ((m_crg[cr] + m_cbg[cb]) >> 16));
+            d[2] = clamp(y + m_cbb[cb]);
+            d[3] = 255;
+            d += 4;
+        }
+        s += m_max_blocks_per_mcu * 64;
+    }
+}
+
+
 // Find end of image (EOI) marker, so we can return to the user the exact size of the input stream.
 void jpeg_decoder::find_eoi()
 {
@@ -2185,7 +2661,10 @@ int jpeg_decoder::decode(const void** pScan_line, uint32_t* pScan_line_len)
         m_mcu_lines_left = m_max_mcu_y_size;
     }
 
-    if (m_freq_domain_chroma_upsample) {
+    if (m_scale > 0) {
+        scaled_convert();
+        *pScan_line = m_pScan_line_0;
+    } else if (m_freq_domain_chroma_upsample) {
         expanded_convert();
         *pScan_line = m_pScan_line_0;
     } else {
@@ -2477,7 +2956,7 @@ bool jpeg_decoder::init_frame()
     else m_dest_bytes_per_pixel = 4;
 
     m_dest_bytes_per_scan_line = ((m_image_x_size + 15) & 0xFFF0) * m_dest_bytes_per_pixel;
-    m_real_dest_bytes_per_scan_line = (m_image_x_size * m_dest_bytes_per_pixel);
+    m_real_dest_bytes_per_scan_line = (get_scaled_width() * m_dest_bytes_per_pixel);
 
     // Initialize two scan line buffers.
     m_pScan_line_0 = (uint8_t *)alloc(m_dest_bytes_per_scan_line, true);
@@ -2503,7 +2982,7 @@ bool jpeg_decoder::init_frame()
     // Freq. domain chroma upsampling is only supported for H2V2 subsampling factor (the most common one I've seen).
     m_freq_domain_chroma_upsample = false;
 #if JPGD_SUPPORT_FREQ_DOMAIN_UPSAMPLING
-    m_freq_domain_chroma_upsample = (m_expanded_blocks_per_mcu == 4*3);
+    m_freq_domain_chroma_upsample = (m_expanded_blocks_per_mcu == 4*3) && (m_scale == 0);
 #endif
 
     if (m_freq_domain_chroma_upsample)
@@ -2513,6 +2992,14 @@ bool jpeg_decoder::init_frame()
 
     m_total_lines_left = m_image_y_size;
     m_mcu_lines_left = 0;
+
+    // The MCU sizes are in the output pixels from here.
+    if (m_scale > 0) {
+        m_max_mcu_x_size >>= m_scale;
+        m_max_mcu_y_size >>= m_scale;
+        m_total_lines_left = get_scaled_height();
+    }
+
     create_look_ups();
 
     return true;
@@ -2957,15 +3444,18 @@ void jpgdDelete(jpeg_decoder* decoder)
 }
 
 
-unsigned char* jpgdDecompress(jpeg_decoder* decoder)
+unsigned char* jpgdDecompress(jpeg_decoder* decoder, int scale, bool simd)
 {
     if (!decoder) return nullptr;
 
     int req_comps = 4;  //TODO: fixed 4 channel components now?
     if ((req_comps != 1) && (req_comps != 3) && (req_comps != 4)) return nullptr;
 
-    auto image_width = decoder->get_width();
-    auto image_height = decoder->get_height();
+    decoder->set_scale(scale);
+    decoder->set_simd(simd);
+
+    auto image_width = decoder->get_scaled_width();
+    auto image_height = decoder->get_scaled_height();
     //auto actual_comps = decoder->get_num_components();
 
     if (decoder->begin_decoding() != JPGD_SUCCESS) return nullptr;
@@ -960,6 +960,7 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
 
     //text string
     int idx = 0;
+    uint32_t slot = 0;
     auto totalChars = strlen(p);
     while (true) {
         //TODO: remove nested scenes.
@@ -1034,13 +1035,16 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
                 }
 
                 auto& textGroupMatrix = textGroup->transform();
-                auto shape = text->pooling();
-                shape->reset();
-                ARRAY_FOREACH(p, glyph->children) {
-                    auto group = static_cast<LottieGroup*>(*p);
-                    ARRAY_FOREACH(p, group->children) {
-                        if (static_cast<LottiePath*>(*p)->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps)) {
-                            PAINT(shape)->mark(RenderUpdateFlag::Path);
+                bool reuse;
+                auto shape = text->pooling(slot++, glyph, reuse);
+                if (!reuse) {
+                    shape->reset();
+                    ARRAY_FOREACH(p, glyph->children) {
+                        auto group = static_cast<LottieGroup*>(*p);
+                        ARRAY_FOREACH(p, group->children) {
+                            if (static_cast<LottiePath*>(*p)->pathset(frameNo, SHAPE(shape)->rs.path, nullptr, tween, exps)) {
+                                PAINT(shape)->mark(RenderUpdateFlag::Path);
+                            }
                         }
                     }
                 }
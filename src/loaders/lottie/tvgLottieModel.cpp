@@ -352,6 +352,51 @@ void LottieFont::prepare()
 }
 
 
+void LottieGlyph::prepare()
+{
+    len = strlen(code);
+
+    ARRAY_FOREACH(p, children) {
+        auto group = static_cast<LottieGroup*>(*p);
+        ARRAY_FOREACH(p, group->children) {
+            auto& pathset = static_cast<LottiePath*>(*p)->pathset;
+            if (pathset.frames || pathset.exp) {
+                statical = false;
+                return;
+            }
+        }
+    }
+}
+
+
+//The characters keep the same shapes over the frames in their order,
+//so the static glyph outlines are built only once.
+Shape* LottieText::pooling(uint32_t slot, LottieGlyph* glyph, bool& reuse)
+{
+    if (slot >= pooler.count || pooler[slot]->refCnt() != 1) {
+        slot = pooler.count;
+        ARRAY_FOREACH(p, pooler) {
+            if ((*p)->refCnt() == 1) {
+                slot = p - pooler.begin();
+                break;
+            }
+        }
+        if (slot == pooler.count) {
+            auto shape = Shape::gen();
+            shape->ref();
+            pooler.push(shape);
+        }
+    }
+
+    while (outlines.count < pooler.count) outlines.push(nullptr);
+
+    reuse = (outlines[slot] == glyph && glyph->statical);
+    outlines[slot] = glyph;
+
+    return pooler[slot];
+}
+
+
 void LottieImage::prepare()
 {
     LottieObject::type = LottieObject::Image;
@@ -300,11 +300,9 @@ struct LottieGlyph
     char* style = nullptr;
     uint16_t size;
     uint8_t len;
+    bool statical = true;            //the outline is not animated
 
-    void prepare()
-    {
-        len = strlen(code);
-    }
+    void prepare();
 
     ~LottieGlyph()
     {
@@ -479,6 +477,9 @@ struct LottieText : LottieObject, LottieRenderPooler<tvg::Shape>
     LottieFont* font = nullptr;
     LottieTextFollowPath* followPath = nullptr;
     Array<LottieTextRange*> ranges;
+    Array<LottieGlyph*> outlines;    //the glyph which each pooled shape has built
+
+    Shape* pooling(uint32_t slot, LottieGlyph* glyph, bool& reuse);
 
     ~LottieText()
     {
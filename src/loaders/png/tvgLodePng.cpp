@@ -47,6 +47,12 @@
 #include "tvgCommon.h"
 #include "tvgLodePng.h"
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    #include <immintrin.h>
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+    #include <arm_neon.h>
+#endif
+
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -84,17 +90,15 @@
 where a full C library is not available. The compiler can recognize them and compile
 to something as fast. */
 
-static void lodepng_memcpy(void* LODEPNG_RESTRICT dst, const void* LODEPNG_RESTRICT src, size_t size)
+static LODEPNG_INLINE void lodepng_memcpy(void* LODEPNG_RESTRICT dst, const void* LODEPNG_RESTRICT src, size_t size)
 {
-    size_t i;
-    for (i = 0; i < size; i++) ((char*)dst)[i] = ((const char*)src)[i];
+    memcpy(dst, src, size);
 }
 
 
-static void lodepng_memset(void* LODEPNG_RESTRICT dst, int value, size_t num)
+static LODEPNG_INLINE void lodepng_memset(void* LODEPNG_RESTRICT dst, int value, size_t num)
 {
-    size_t i;
-    for (i = 0; i < num; i++) ((char*)dst)[i] = (char)value;
+    memset(dst, value, num);
 }
 
 
@@ -211,6 +215,14 @@ static unsigned lodepng_read32bitInt(const unsigned char* buffer)
 }
 
 
+/* little endian 64-bit word, the compilers fold it into a single load */
+static LODEPNG_INLINE uint64_t lodepng_read64bitLE(const unsigned char* buffer)
+{
+    return ((uint64_t)buffer[0] | ((uint64_t)buffer[1] << 8u) | ((uint64_t)buffer[2] << 16u) | ((uint64_t)buffer[3] << 24u) |
+            ((uint64_t)buffer[4] << 32u) | ((uint64_t)buffer[5] << 40u) | ((uint64_t)buffer[6] << 48u) | ((uint64_t)buffer[7] << 56u));
+}
+
+
 /* ////////////////////////////////////////////////////////////////////////// */
 /* ////////////////////////////////////////////////////////////////////////// */
 /* // End of common code and tools. Begin of Zlib related code.            // */
@@ -299,7 +311,11 @@ static LODEPNG_INLINE unsigned ensureBits25(LodePNGBitReader* reader, size_t nbi
 {
     size_t start = reader->bp >> 3u;
     size_t size = reader->size;
-    if (start + 3u < size) {
+    /* wide word fast path, one load covers all the bits of any bit offset */
+    if (start + 8u <= size) {
+        reader->buffer = (unsigned)(lodepng_read64bitLE(reader->data + start) >> (reader->bp & 7u));
+        return 1;
+    } else if (start + 3u < size) {
         reader->buffer = (unsigned)reader->data[start + 0] | ((unsigned)reader->data[start + 1] << 8u) |  ((unsigned)reader->data[start + 2] << 16u) | ((unsigned)reader->data[start + 3] << 24u);
         reader->buffer >>= (reader->bp & 7u);
         return 1;
@@ -319,7 +335,11 @@ static LODEPNG_INLINE unsigned ensureBits32(LodePNGBitReader* reader, size_t nbi
 {
     size_t start = reader->bp >> 3u;
     size_t size = reader->size;
-    if(start + 4u < size) {
+    /* wide word fast path, one load covers all the bits of any bit offset */
+    if (start + 8u <= size) {
+        reader->buffer = (unsigned)(lodepng_read64bitLE(reader->data + start) >> (reader->bp & 7u));
+        return 1;
+    } else if (start + 4u < size) {
         reader->buffer = (unsigned)reader->data[start + 0] | ((unsigned)reader->data[start + 1] << 8u) | ((unsigned)reader->data[start + 2] << 16u) | ((unsigned)reader->data[start + 3] << 24u);
         reader->buffer >>= (reader->bp & 7u);
         reader->buffer |= (((unsigned)reader->data[start + 4] << 24u) << (8u - (reader->bp & 7u)));
@@ -872,7 +892,8 @@ static unsigned inflateHuffmanBlock(ucvector* out, LodePNGBitReader* reader, uns
         ensureBits25(reader, 20); /* up to 15 for the huffman symbol, up to 5 for the length extra bits */
         code_ll = huffmanDecodeSymbol(reader, &tree_ll);
         if (code_ll <= 255) /*literal symbol*/ {
-            if (!ucvector_resize(out, out->size + 1)) ERROR_BREAK(83 /*alloc fail*/);
+            if (out->size < out->allocsize) ++out->size;
+            else if (!ucvector_resize(out, out->size + 1)) ERROR_BREAK(83 /*alloc fail*/);
             out->data[out->size - 1] = (unsigned char)code_ll;
         } else if (code_ll >= FIRST_LENGTH_CODE_INDEX && code_ll <= LAST_LENGTH_CODE_INDEX) /*length code*/ {
             unsigned code_d, distance;
@@ -914,12 +935,17 @@ static unsigned inflateHuffmanBlock(ucvector* out, LodePNGBitReader* reader, uns
             backward = start - distance;
 
             if (!ucvector_resize(out, out->size + length)) ERROR_BREAK(83 /*alloc fail*/);
-            if (distance < length) {
-                size_t forward;
-                lodepng_memcpy(out->data + start, out->data + backward, distance);
-                start += distance;
-                for (forward = distance; forward < length; ++forward) {
-                  out->data[start++] = out->data[backward++];
+            if (distance == 1) {
+                lodepng_memset(out->data + start, out->data[backward], length);
+            } else if (distance < length) {
+                /* the copied range repeats by the distance, so it doubles the copyable size every step */
+                unsigned char* dst = out->data + start;
+                const unsigned char* src = out->data + backward;
+                while (length > 0) {
+                    size_t chunk = LODEPNG_MIN(length, (size_t)(dst - src));
+                    lodepng_memcpy(dst, src, chunk);
+                    dst += chunk;
+                    length -= chunk;
                 }
             } else {
                 lodepng_memcpy(out->data + start, out->data + backward, length);
@@ -1761,7 +1787,23 @@ static void getPixelColorsRGBA8(unsigned char* LODEPNG_RESTRICT buffer, size_t n
         }
     } else if (mode->colortype == LCT_RGB) {
         if (mode->bitdepth == 8) {
-            for (i = 0; i != numpixels; ++i, buffer += num_channels) {
+            i = 0;
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+            /* 4 pixels per step, the 16 bytes loads must not exceed the input */
+            auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            auto alpha = _mm_set1_epi32(0xff000000);
+            for (; i + 6 <= numpixels; i += 4, buffer += 4 * num_channels) {
+                auto rgb = _mm_loadu_si128((const __m128i*)&in[i * 3]);
+                _mm_storeu_si128((__m128i*)buffer, _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+            }
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+            for (; i + 8 <= numpixels; i += 8, buffer += 8 * num_channels) {
+                auto rgb = vld3_u8(&in[i * 3]);
+                uint8x8x4_t rgba = {{rgb.val[0], rgb.val[1], rgb.val[2], vdup_n_u8(255)}};
+                vst4_u8(buffer, rgba);
+            }
+#endif
+            for (; i != numpixels; ++i, buffer += num_channels) {
                 lodepng_memcpy(buffer, &in[i * 3], 3);
                 buffer[3] = 255;
             }
@@ -2074,6 +2116,175 @@ static void Adam7_getpassvalues(unsigned passw[7], unsigned passh[7], size_t fil
 /* / PNG Decoder                                                            / */
 /* ////////////////////////////////////////////////////////////////////////// */
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+
+/* SIMD unfilters for the 3 and 4 bytes per pixel scanlines (8-bit RGB & RGBA, 16-bit grey alpha).
+   Sub, Average and Paeth depend on the left pixel, so the pixels go one by one with all the channels at once. */
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+
+typedef __m128i SimdPixel;
+
+static LODEPNG_INLINE SimdPixel simdPixel(uint32_t v)
+{
+    return _mm_cvtsi32_si128((int)v);
+}
+
+static LODEPNG_INLINE uint32_t simdValue(SimdPixel v)
+{
+    return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+static LODEPNG_INLINE SimdPixel simdAdd(SimdPixel a, SimdPixel b)
+{
+    return _mm_add_epi8(a, b);
+}
+
+static LODEPNG_INLINE SimdPixel simdAvg(SimdPixel a, SimdPixel b)
+{
+    /* _mm_avg_epu8 rounds up, while png floors the average */
+    auto lsb = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1));
+    return _mm_sub_epi8(_mm_avg_epu8(a, b), lsb);
+}
+
+static LODEPNG_INLINE SimdPixel simdPaeth(SimdPixel a, SimdPixel b, SimdPixel c)
+{
+    auto zero = _mm_setzero_si128();
+    auto a16 = _mm_unpacklo_epi8(a, zero);
+    auto b16 = _mm_unpacklo_epi8(b, zero);
+    auto c16 = _mm_unpacklo_epi8(c, zero);
+
+    auto bc = _mm_sub_epi16(b16, c16);
+    auto ac = _mm_sub_epi16(a16, c16);
+    auto pc = _mm_add_epi16(bc, ac);
+    auto pa = _mm_max_epi16(bc, _mm_sub_epi16(zero, bc));
+    auto pb = _mm_max_epi16(ac, _mm_sub_epi16(zero, ac));
+    pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+    /* the same priority with paethPredictor(): a, b and then c */
+    auto smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+    auto isb = _mm_cmpeq_epi16(smallest, pb);
+    auto nearest = _mm_or_si128(_mm_and_si128(isb, b16), _mm_andnot_si128(isb, c16));
+    auto isa = _mm_cmpeq_epi16(smallest, pa);
+    nearest = _mm_or_si128(_mm_and_si128(isa, a16), _mm_andnot_si128(isa, nearest));
+
+    return _mm_packus_epi16(nearest, nearest);
+}
+
+#else
+
+typedef uint8x8_t SimdPixel;
+
+static LODEPNG_INLINE SimdPixel simdPixel(uint32_t v)
+{
+    return vreinterpret_u8_u32(vdup_n_u32(v));
+}
+
+static LODEPNG_INLINE uint32_t simdValue(SimdPixel v)
+{
+    return vget_lane_u32(vreinterpret_u32_u8(v), 0);
+}
+
+static LODEPNG_INLINE SimdPixel simdAdd(SimdPixel a, SimdPixel b)
+{
+    return vadd_u8(a, b);
+}
+
+static LODEPNG_INLINE SimdPixel simdAvg(SimdPixel a, SimdPixel b)
+{
+    return vhadd_u8(a, b);
+}
+
+static LODEPNG_INLINE SimdPixel simdPaeth(SimdPixel a, SimdPixel b, SimdPixel c)
+{
+    auto a16 = vreinterpretq_s16_u16(vmovl_u8(a));
+    auto b16 = vreinterpretq_s16_u16(vmovl_u8(b));
+    auto c16 = vreinterpretq_s16_u16(vmovl_u8(c));
+
+    auto bc = vsubq_s16(b16, c16);
+    auto ac = vsubq_s16(a16, c16);
+    auto pa = vabsq_s16(bc);
+    auto pb = vabsq_s16(ac);
+    auto pc = vabsq_s16(vaddq_s16(bc, ac));
+
+    /* the same priority with paethPredictor(): a, b and then c */
+    auto smallest = vminq_s16(pc, vminq_s16(pa, pb));
+    auto nearest = vbslq_s16(vceqq_s16(smallest, pb), b16, c16);
+    nearest = vbslq_s16(vceqq_s16(smallest, pa), a16, nearest);
+
+    return vmovn_u16(vreinterpretq_u16_s16(nearest));
+}
+
+#endif
+
+
+/* the 4th byte of the 3 bytes pixel is a don't care, but not loaded beyond the scanline */
+template<size_t bytewidth>
+static LODEPNG_INLINE SimdPixel simdLoad(const unsigned char* p, bool tail)
+{
+    uint32_t v = 0;
+    if (bytewidth == 4 || !tail) memcpy(&v, p, 4);
+    else memcpy(&v, p, bytewidth);
+    return simdPixel(v);
+}
+
+template<size_t bytewidth>
+static LODEPNG_INLINE void simdStore(unsigned char* p, SimdPixel v)
+{
+    auto t = simdValue(v);
+    memcpy(p, &t, bytewidth);
+}
+
+
+template<size_t bytewidth>
+static void unfilterScanlineSimd(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, unsigned char filterType, size_t length)
+{
+    /* a: left, b: up, c: upper left */
+    auto a = simdPixel(0);
+    auto b = a;
+    auto c = a;
+
+    if (filterType == 1) {
+        for (size_t i = 0; i + bytewidth <= length; i += bytewidth) {
+            auto tail = (i + 4 > length);
+            a = simdAdd(simdLoad<bytewidth>(scanline + i, tail), a);
+            simdStore<bytewidth>(recon + i, a);
+        }
+    } else if (filterType == 3) {
+        for (size_t i = 0; i + bytewidth <= length; i += bytewidth) {
+            auto tail = (i + 4 > length);
+            if (precon) b = simdLoad<bytewidth>(precon + i, tail);
+            a = simdAdd(simdLoad<bytewidth>(scanline + i, tail), simdAvg(a, b));
+            simdStore<bytewidth>(recon + i, a);
+        }
+    } else {
+        for (size_t i = 0; i + bytewidth <= length; i += bytewidth) {
+            auto tail = (i + 4 > length);
+            b = simdLoad<bytewidth>(precon + i, tail);
+            a = simdAdd(simdLoad<bytewidth>(scanline + i, tail), simdPaeth(a, b, c));
+            simdStore<bytewidth>(recon + i, a);
+            c = b;
+        }
+    }
+}
+
+
+/* returns false if the filter type is not covered by the simd path */
+static bool unfilterScanlineSimd(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, unsigned char filterType, size_t length)
+{
+    if (filterType != 1 && filterType != 3 && filterType != 4) return false;
+    /* paeth of the first row is the sub filter */
+    if (filterType == 4 && !precon) filterType = 1;
+
+    if (bytewidth == 4) unfilterScanlineSimd<4>(recon, scanline, precon, filterType, length);
+    else if (bytewidth == 3) unfilterScanlineSimd<3>(recon, scanline, precon, filterType, length);
+    else return false;
+    return true;
+}
+
+#endif
+
+
 static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, unsigned char filterType, size_t length)
 {
     /* For PNG filter method 0
@@ -2083,6 +2294,10 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
        the incoming scanlines do NOT include the filtertype byte, that one is given in the parameter filterType instead
        recon and scanline MAY be the same memory address! precon must be disjoint. */
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (unfilterScanlineSimd(recon, scanline, precon, bytewidth, filterType, length)) return 0;
+#endif
+
     size_t i;
     switch (filterType) {
         case 0:
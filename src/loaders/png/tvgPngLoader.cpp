@@ -144,6 +144,14 @@ bool PngLoader::read()
 }
 
 
+char* PngLoader::handover()
+{
+    if (!freeData) return nullptr;
+    freeData = false;
+    return (char*) data;
+}
+
+
 RenderSurface* PngLoader::bitmap()
 {
     this->done();
@@ -44,6 +44,7 @@ public:
     bool open(const char* path) override;
     bool open(const char* data, uint32_t size, const char* rpath, bool copy) override;
     bool read() override;
+    char* handover() override;
 
     RenderSurface* bitmap() override;
 };
@@ -51,7 +51,10 @@ bool RawLoader::open(const uint32_t* data, uint32_t w, uint32_t h, ColorSpace cs
         if (!surface.buf32) return false;
         memcpy((void*)surface.buf32, data, sizeof(uint32_t) * w * h);
     }
-    else surface.buf32 = const_cast<uint32_t*>(data);
+    else {
+        surface.buf32 = const_cast<uint32_t*>(data);
+        surface.shared = true;
+    }
 
     //setup the surface
     surface.stride = w;
@@ -0,0 +1,560 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSvgCache.h"
+
+#ifdef THORVG_FILE_IO_SUPPORT
+
+#include <atomic>
+#include <cstdio>
+#ifdef _WIN32
+    #include <process.h>
+    #define getpid _getpid
+#else
+    #include <unistd.h>
+#endif
+#include "tvgArray.h"
+#include "tvgMath.h"
+#include "tvgShape.h"
+#include "tvgScene.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+/*
+ * Binary layout (native endian):
+ *
+ * Header: magic(4) | version(4) | content hash(16) | content size(4) | width(4) | height(4)
+ * Paint:  type(1) | id(4) | opacity(1) | transform(36) | clip(1) [Shape] | mask method(1) [Paint] | Shape or Scene
+ * Shape:  cmds count(4) | cmds | pts count(4) | pts | fill rule(1) | Fill | stroke(1) [Stroke]
+ * Stroke: width(4) | Fill | dash count(4) | dash pattern | dash offset(4) | miterlimit(4) | cap(1) | join(1) | first(1)
+ * Fill:   kind(1) | color(4) or gradient(linear: 16, radial: 24) | spread(1) | transform(36) | stops count(4) | stops
+ * Scene:  effects count(4) | effects (GaussianBlur: sigma(4) | direction(1) | border(1) | quality(1)) | children count(4) | Paints
+ */
+
+#define SVG_CACHE_MAGIC "TVGS"
+#define SVG_CACHE_VERSION 2
+#define SVG_CACHE_PATH_MAX 1024
+
+enum class SvgCacheFill : uint8_t {Color = 0, Linear, Radial};
+
+
+struct SvgCacheWriter
+{
+    Array<uint8_t> buf;
+
+    void write(const void* data, uint32_t size)
+    {
+        if (size == 0) return;
+        buf.grow(size);
+        memcpy(buf.data + buf.count, data, size);
+        buf.count += size;
+    }
+
+    template<typename T>
+    void write(T val)
+    {
+        write(&val, sizeof(T));
+    }
+};
+
+
+struct SvgCacheReader
+{
+    const uint8_t* ptr;
+    const uint8_t* end;
+
+    bool read(void* data, uint32_t size)
+    {
+        if (uint32_t(end - ptr) < size) return false;
+        memcpy(data, ptr, size);
+        ptr += size;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T& val)
+    {
+        return read(&val, sizeof(T));
+    }
+
+    template<typename T>
+    bool read(Array<T>& arr)
+    {
+        uint32_t cnt;
+        if (!read(cnt) || uint32_t(end - ptr) / sizeof(T) < cnt) return false;
+        arr.reserve(cnt);
+        arr.count = cnt;
+        return read(arr.data, cnt * sizeof(T));
+    }
+};
+
+
+//the content digest, the entries of the other library or format versions never match.
+struct SvgCacheKey
+{
+    uint64_t h1, h2;
+
+    bool operator==(const SvgCacheKey& rhs) const
+    {
+        return h1 == rhs.h1 && h2 == rhs.h2;
+    }
+};
+
+
+static const char* _dir()
+{
+#ifdef THORVG_SVG_CACHE_DIR
+    return THORVG_SVG_CACHE_DIR;
+#else
+    return nullptr;
+#endif
+}
+
+
+static void _hash(SvgCacheKey& key, const uint8_t* data, uint32_t size)
+{
+    //djb2 and fnv-1a in a pass, the content may not be null-terminated.
+    for (uint32_t i = 0; i < size; ++i) {
+        key.h1 = ((key.h1 << 5) + key.h1) + data[i];
+        key.h2 = (key.h2 ^ data[i]) * 0x100000001b3ULL;
+    }
+}
+
+
+static SvgCacheKey _key(const char* content, uint32_t size)
+{
+    SvgCacheKey key = {5381, 0xcbf29ce484222325ULL};
+    char version[32];
+    auto len = snprintf(version, sizeof(version), "%s/%d", THORVG_VERSION_STRING, SVG_CACHE_VERSION);
+    _hash(key, (const uint8_t*)version, len);
+    _hash(key, (const uint8_t*)content, size);
+    return key;
+}
+
+
+static bool _path(const char* dir, uint32_t size, const SvgCacheKey& key, char* path, size_t len)
+{
+    auto ret = snprintf(path, len, "%s/%016llx%016llx-%08x.tvgs", dir, (unsigned long long)key.h1, (unsigned long long)key.h2, size);
+    return (ret > 0 && size_t(ret) < len);
+}
+
+
+static void _writeFill(SvgCacheWriter& writer, const Fill* fill, const RenderColor& color)
+{
+    if (!fill) {
+        writer.write(SvgCacheFill::Color);
+        writer.write(color);
+        return;
+    }
+
+    if (fill->type() == Type::LinearGradient) {
+        float pts[4];
+        static_cast<const LinearGradient*>(fill)->linear(pts, pts + 1, pts + 2, pts + 3);
+        writer.write(SvgCacheFill::Linear);
+        writer.write(pts, sizeof(pts));
+    } else {
+        float pts[6];
+        static_cast<const RadialGradient*>(fill)->radial(pts, pts + 1, pts + 2, pts + 3, pts + 4, pts + 5);
+        writer.write(SvgCacheFill::Radial);
+        writer.write(pts, sizeof(pts));
+    }
+
+    writer.write(fill->spread());
+    writer.write(fill->transform());
+
+    const Fill::ColorStop* stops;
+    auto cnt = fill->colorStops(&stops);
+    writer.write(cnt);
+    writer.write(stops, cnt * sizeof(Fill::ColorStop));
+}
+
+
+static bool _writePaint(SvgCacheWriter& writer, Paint* paint);
+
+
+static bool _writeShape(SvgCacheWriter& writer, Shape* shape)
+{
+    auto& rs = SHAPE(shape)->rs;
+
+    //the trimming isn't serialized, the svg loader doesn't generate it.
+    if (rs.trimpath()) return false;
+
+    writer.write(rs.path.cmds.count);
+    writer.write(rs.path.cmds.data, rs.path.cmds.count * sizeof(PathCommand));
+    writer.write(rs.path.pts.count);
+    writer.write(rs.path.pts.data, rs.path.pts.count * sizeof(Point));
+    writer.write(rs.rule);
+    _writeFill(writer, rs.fill, rs.color);
+
+    writer.write(uint8_t(rs.stroke ? 1 : 0));
+    if (!rs.stroke) return true;
+
+    auto stroke = rs.stroke;
+    writer.write(stroke->width);
+    _writeFill(writer, stroke->fill, stroke->color);
+    writer.write(stroke->dash.count);
+    writer.write(stroke->dash.pattern, stroke->dash.count * sizeof(float));
+    writer.write(stroke->dash.offset);
+    writer.write(stroke->miterlimit);
+    writer.write(stroke->cap);
+    writer.write(stroke->join);
+    writer.write(uint8_t(stroke->first ? 1 : 0));
+
+    return true;
+}
+
+
+static bool _writeScene(SvgCacheWriter& writer, Scene* scene)
+{
+    auto effects = SCENE(scene)->effects;
+    uint32_t cnt = effects ? effects->count : 0;
+
+    writer.write(cnt);
+    for (uint32_t i = 0; i < cnt; ++i) {
+        //the svg loader generates the gaussian blur only
+        if ((*effects)[i]->type != SceneEffect::GaussianBlur) return false;
+        auto effect = static_cast<RenderEffectGaussianBlur*>((*effects)[i]);
+        writer.write(effect->type);
+        writer.write(effect->sigma);
+        writer.write(effect->direction);
+        writer.write(effect->border);
+        writer.write(effect->quality);
+    }
+
+    auto& paints = scene->paints();
+    writer.write(uint32_t(paints.size()));
+    for (auto paint : paints) {
+        if (!_writePaint(writer, paint)) return false;
+    }
+    return true;
+}
+
+
+static bool _writePaint(SvgCacheWriter& writer, Paint* paint)
+{
+    auto type = paint->type();
+
+    //pictures and texts depend on the external resources, they can't be cached.
+    if (type != Type::Shape && type != Type::Scene) return false;
+
+    writer.write(type);
+    writer.write(paint->id);
+    writer.write(paint->opacity());
+    writer.write(paint->transform());
+
+    auto clipper = paint->clip();
+    writer.write(uint8_t(clipper ? 1 : 0));
+    if (clipper && !_writePaint(writer, clipper)) return false;
+
+    const Paint* target = nullptr;
+    auto method = paint->mask(&target);
+    writer.write(method);
+    if (method != MaskMethod::None && !_writePaint(writer, const_cast<Paint*>(target))) return false;
+
+    if (type == Type::Shape) return _writeShape(writer, static_cast<Shape*>(paint));
+    return _writeScene(writer, static_cast<Scene*>(paint));
+}
+
+
+static Fill* _readFill(SvgCacheReader& reader, RenderColor& color, bool& result)
+{
+    result = false;
+
+    SvgCacheFill kind;
+    if (!reader.read(kind)) return nullptr;
+
+    if (kind == SvgCacheFill::Color) {
+        result = reader.read(color);
+        return nullptr;
+    }
+
+    Fill* fill;
+    if (kind == SvgCacheFill::Linear) {
+        float pts[4];
+        if (!reader.read(pts, sizeof(pts))) return nullptr;
+        auto linear = LinearGradient::gen();
+        linear->linear(pts[0], pts[1], pts[2], pts[3]);
+        fill = linear;
+    } else if (kind == SvgCacheFill::Radial) {
+        float pts[6];
+        if (!reader.read(pts, sizeof(pts))) return nullptr;
+        auto radial = RadialGradient::gen();
+        radial->radial(pts[0], pts[1], pts[2], pts[3], pts[4], pts[5]);
+        fill = radial;
+    } else return nullptr;
+
+    FillSpread spread;
+    Matrix m;
+    Array<Fill::ColorStop> stops;
+
+    if (!reader.read(spread) || !reader.read(m) || !reader.read(stops)) {
+        delete(fill);
+        return nullptr;
+    }
+
+    fill->spread(spread);
+    fill->transform(m);
+    fill->colorStops(stops.data, stops.count);
+
+    result = true;
+    return fill;
+}
+
+
+static Paint* _readPaint(SvgCacheReader& reader, int depth);
+
+
+static bool _readShape(SvgCacheReader& reader, Shape* shape)
+{
+    auto& path = SHAPE(shape)->rs.path;
+    if (!reader.read(path.cmds) || !reader.read(path.pts)) return false;
+    SHAPE(shape)->impl.mark(RenderUpdateFlag::Path);
+
+    FillRule rule;
+    if (!reader.read(rule)) return false;
+    shape->fillRule(rule);
+
+    RenderColor color;
+    bool result;
+    if (auto fill = _readFill(reader, color, result)) shape->fill(fill);
+    else if (result) shape->fill(color.r, color.g, color.b, color.a);
+    else return false;
+
+    uint8_t stroking;
+    if (!reader.read(stroking)) return false;
+    if (!stroking) return true;
+
+    float width;
+    if (!reader.read(width)) return false;
+    shape->strokeWidth(width);
+
+    if (auto fill = _readFill(reader, color, result)) shape->strokeFill(fill);
+    else if (result) shape->strokeFill(color.r, color.g, color.b, color.a);
+    else return false;
+
+    Array<float> pattern;
+    float offset, miterlimit;
+    StrokeCap cap;
+    StrokeJoin join;
+    uint8_t first;
+    if (!reader.read(pattern) || !reader.read(offset) || !reader.read(miterlimit) || !reader.read(cap) || !reader.read(join) || !reader.read(first)) return false;
+
+    if (pattern.count > 0) shape->strokeDash(pattern.data, pattern.count, offset);
+    shape->strokeMiterlimit(miterlimit);
+    shape->strokeCap(cap);
+    shape->strokeJoin(join);
+    shape->order(first);
+
+    return true;
+}
+
+
+static bool _readScene(SvgCacheReader& reader, Scene* scene, int depth)
+{
+    uint32_t cnt;
+    if (!reader.read(cnt)) return false;
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        SceneEffect type;
+        float sigma;
+        uint8_t direction, border, quality;
+        if (!reader.read(type) || type != SceneEffect::GaussianBlur) return false;
+        if (!reader.read(sigma) || !reader.read(direction) || !reader.read(border) || !reader.read(quality)) return false;
+        scene->push(SceneEffect::GaussianBlur, (double)sigma, (int)direction, (int)border, (int)quality);
+    }
+
+    if (!reader.read(cnt)) return false;
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto paint = _readPaint(reader, depth + 1);
+        if (!paint) return false;
+        scene->push(paint);
+    }
+    return true;
+}
+
+
+static Paint* _readPaint(SvgCacheReader& reader, int depth)
+{
+    //the same limitation with the scene builder
+    if (depth > 2192) return nullptr;
+
+    Type type;
+    uint32_t id;
+    uint8_t opacity;
+    Matrix m;
+    uint8_t clipping;
+
+    if (!reader.read(type) || !reader.read(id) || !reader.read(opacity) || !reader.read(m) || !reader.read(clipping)) return nullptr;
+
+    Paint* paint;
+    if (type == Type::Shape) paint = Shape::gen();
+    else if (type == Type::Scene) paint = Scene::gen();
+    else return nullptr;
+
+    paint->id = id;
+    paint->opacity(opacity);
+    if (!tvg::identity((const Matrix*)&m)) paint->transform(m);
+
+    if (clipping) {
+        auto clipper = _readPaint(reader, depth + 1);
+        if (!clipper || clipper->type() != Type::Shape) {
+            delete(clipper);
+            delete(paint);
+            return nullptr;
+        }
+        paint->clip(static_cast<Shape*>(clipper));
+    }
+
+    MaskMethod method;
+    if (!reader.read(method)) {
+        delete(paint);
+        return nullptr;
+    }
+    if (method != MaskMethod::None) {
+        auto target = _readPaint(reader, depth + 1);
+        if (!target) {
+            delete(paint);
+            return nullptr;
+        }
+        paint->mask(target, method);
+    }
+
+    auto result = (type == Type::Shape) ? _readShape(reader, static_cast<Shape*>(paint)) : _readScene(reader, static_cast<Scene*>(paint), depth);
+    if (!result) {
+        delete(paint);
+        return nullptr;
+    }
+    return paint;
+}
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool svgCacheLoad(const char* content, uint32_t size, Scene** root, float* w, float* h)
+{
+    //the hashing is skipped entirely unless the cache is enabled
+    auto dir = _dir();
+    if (!dir || !content || size == 0) return false;
+
+    auto key = _key(content, size);
+    char path[SVG_CACHE_PATH_MAX];
+    if (!_path(dir, size, key, path, sizeof(path))) return false;
+
+    auto f = fopen(path, "rb");
+    if (!f) return false;
+
+    fseek(f, 0, SEEK_END);
+    auto len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    auto data = tvg::malloc<uint8_t*>(len > 0 ? len : 1);
+    auto ret = false;
+
+    if (len > 0 && fread(data, len, 1, f) == 1) {
+        SvgCacheReader reader = {data, data + len};
+
+        char magic[4];
+        uint32_t version, csize;
+        SvgCacheKey ckey;
+        float cw, ch;
+
+        if (reader.read(magic, sizeof(magic)) && !memcmp(magic, SVG_CACHE_MAGIC, sizeof(magic)) &&
+            reader.read(version) && version == SVG_CACHE_VERSION &&
+            reader.read(ckey) && ckey == key && reader.read(csize) && csize == size &&
+            reader.read(cw) && reader.read(ch)) {
+            auto paint = _readPaint(reader, 0);
+            if (paint && paint->type() == Type::Scene && reader.ptr == reader.end) {
+                *root = static_cast<Scene*>(paint);
+                *w = cw;
+                *h = ch;
+                ret = true;
+            } else {
+                TVGLOG("SVG", "The cache \"%s\" is broken, ignored.", path);
+                delete(paint);
+            }
+        }
+    }
+
+    tvg::free(data);
+    fclose(f);
+
+    return ret;
+}
+
+
+bool svgCacheSave(const char* content, uint32_t size, Scene* root, float w, float h)
+{
+    auto dir = _dir();
+    if (!dir || !content || size == 0 || !root) return false;
+
+    auto key = _key(content, size);
+    char path[SVG_CACHE_PATH_MAX];
+    if (!_path(dir, size, key, path, sizeof(path))) return false;
+
+    SvgCacheWriter writer;
+    writer.write(SVG_CACHE_MAGIC, 4);
+    writer.write(uint32_t(SVG_CACHE_VERSION));
+    writer.write(key);
+    writer.write(size);
+    writer.write(w);
+    writer.write(h);
+
+    if (!_writePaint(writer, root)) return false;
+
+    //write to a temporary file first, so that the other processes never see a partial cache.
+    //the process id and the sequence number keep the temporary files of the concurrent writers apart.
+    static std::atomic<uint32_t> seq{0};
+    char tmp[SVG_CACHE_PATH_MAX];
+    auto ret = snprintf(tmp, sizeof(tmp), "%s.%d.%u.tmp", path, (int)getpid(), seq++);
+    if (ret <= 0 || size_t(ret) >= sizeof(tmp)) return false;
+
+    auto f = fopen(tmp, "wb");
+    if (!f) return false;
+
+    auto success = (fwrite(writer.buf.data, writer.buf.count, 1, f) == 1);
+    fclose(f);
+
+    if (!success || rename(tmp, path) != 0) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+#else
+
+bool svgCacheLoad(TVG_UNUSED const char* content, TVG_UNUSED uint32_t size, TVG_UNUSED Scene** root, TVG_UNUSED float* w, TVG_UNUSED float* h)
+{
+    return false;
+}
+
+
+bool svgCacheSave(TVG_UNUSED const char* content, TVG_UNUSED uint32_t size, TVG_UNUSED Scene* root, TVG_UNUSED float w, TVG_UNUSED float h)
+{
+    return false;
+}
+
+#endif //THORVG_FILE_IO_SUPPORT
@@ -21,12 +21,93 @@
  */
 
 #include "tvgStr.h"
+#include "tvgCompressor.h"
 #include "tvgSvgCssStyle.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+//Hash table of the style sheet rules keyed by the (tag, name) selector.
+//Class selectors (.name) are the CssStyle typed rules, so both lookups share the table.
+struct SvgCssIndex
+{
+    SvgNode** slots = nullptr;  //open addressing, the capacity is power of two
+    uint32_t capacity = 0;
+    uint32_t count = 0;         //indexed rules
+    uint32_t synced = 0;        //style sheet rules visited so far
+
+    ~SvgCssIndex()
+    {
+        tvg::free(slots);
+    }
+};
+
+
+static inline uint32_t _hash(SvgNodeType type, const char* name)
+{
+    return uint32_t(name ? djb2Encode(name) : 0) * 31 + uint32_t(type);
+}
+
+
+static inline bool _match(const SvgNode* rule, SvgNodeType type, const char* name)
+{
+    if (rule->type != type) return false;
+    if (!name) return !rule->id;
+    return rule->id && !strcmp(rule->id, name);
+}
+
+
+static SvgNode* _lookup(const SvgNode* style, const char* name, SvgNodeType type)
+{
+    auto index = style->node.cssStyle.index;
+
+    if (index && index->capacity > 0) {
+        auto mask = index->capacity - 1;
+        for (auto i = _hash(type, name) & mask; index->slots[i]; i = (i + 1) & mask) {
+            if (_match(index->slots[i], type, name)) return index->slots[i];
+        }
+    }
+
+    //the rules appended after the last cssUpdateIndex() call
+    for (auto i = index ? index->synced : 0; i < style->child.count; ++i) {
+        if (_match(style->child[i], type, name)) return style->child[i];
+    }
+    return nullptr;
+}
+
+
+static void _insert(SvgCssIndex* index, SvgNode* rule)
+{
+    auto mask = index->capacity - 1;
+    auto i = _hash(rule->type, rule->id) & mask;
+    while (index->slots[i]) i = (i + 1) & mask;
+    index->slots[i] = rule;
+    ++index->count;
+}
+
+
+static void _grow(SvgCssIndex* index, uint32_t count)
+{
+    //keep the load factor under 0.5
+    if ((count * 2) <= index->capacity) return;
+
+    auto capacity = index->capacity > 0 ? index->capacity : 16;
+    while (capacity < count * 2) capacity <<= 1;
+
+    auto slots = index->slots;
+    auto old = index->capacity;
+
+    index->slots = tvg::calloc<SvgNode**>(capacity, sizeof(SvgNode*));
+    index->capacity = capacity;
+    index->count = 0;
+
+    for (uint32_t i = 0; i < old; ++i) {
+        if (slots[i]) _insert(index, slots[i]);
+    }
+    tvg::free(slots);
+}
+
 static bool _isImportanceApplicable(SvgStyleFlags &toFlagsImportance, SvgStyleFlags fromFlagsImportance, SvgStyleFlags flag)
 {
     if (!(toFlagsImportance & flag) && (fromFlagsImportance & flag)) {
@@ -209,26 +290,14 @@ void cssCopyStyleAttr(SvgNode* to, const SvgNode* from)
 SvgNode* cssFindStyleNode(const SvgNode* style, const char* title, SvgNodeType type)
 {
     if (!style) return nullptr;
-
-    ARRAY_FOREACH(p, style->child) {
-        if ((*p)->type == type) {
-            if ((!title && !(*p)->id) || (title && (*p)->id && !strcmp((*p)->id, title))) return *p;
-        }
-    }
-    return nullptr;
+    return _lookup(style, title, type);
 }
 
 
 SvgNode* cssFindStyleNode(const SvgNode* style, const char* title)
 {
     if (!style || !title) return nullptr;
-
-    ARRAY_FOREACH(p, style->child) {
-        if ((*p)->type == SvgNodeType::CssStyle) {
-            if ((*p)->id && !strcmp((*p)->id, title)) return *p;
-        }
-    }
-    return nullptr;
+    return _lookup(style, title, SvgNodeType::CssStyle);
 }
 
 
@@ -258,3 +327,30 @@ void cssApplyStyleToPostponeds(Array<SvgNodeIdPair>& postponeds, SvgNode* style)
         }
     }
 }
+
+
+void cssUpdateIndex(SvgNode* style)
+{
+    if (!style || style->type != SvgNodeType::CssStyle) return;
+
+    auto& index = style->node.cssStyle.index;
+    if (!index) index = new SvgCssIndex;
+    if (index->synced == style->child.count) return;
+
+    _grow(index, index->count + (style->child.count - index->synced));
+
+    for (; index->synced < style->child.count; ++index->synced) {
+        auto rule = style->child[index->synced];
+        //the first declared rule wins, the same as the linear search
+        if (_lookup(style, rule->id, rule->type) != rule) continue;
+        _insert(index, rule);
+    }
+}
+
+
+void cssFreeIndex(SvgNode* style)
+{
+    if (!style || style->type != SvgNodeType::CssStyle) return;
+    delete(style->node.cssStyle.index);
+    style->node.cssStyle.index = nullptr;
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include "tvgMath.h"
+#include "tvgShape.h"
+#include "tvgScene.h"
+#include "tvgSvgIndex.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define SVG_INDEX_NODE 16      //node capacity
+#define SVG_INDEX_MIN 32       //minimum top-level elements to build the index
+#define SVG_INDEX_DIRTY (RenderUpdateFlag::Path | RenderUpdateFlag::Stroke | RenderUpdateFlag::Transform | RenderUpdateFlag::Image)  //changes that could move the bounds
+
+struct SvgIndexNode
+{
+    Point min, max;
+    uint32_t idx;              //leaf: order of the element in the layer, inner: first child node
+    uint32_t cnt;              //leaf: 0, inner: number of the child nodes
+};
+
+
+struct SvgIndexCulled
+{
+    Paint* paint;
+    uint32_t idx;              //order of the element in the layer
+};
+
+
+struct SvgIndex
+{
+    Array<SvgIndexNode> nodes; //packed level by level, the leaves first and the root at last
+    Array<uint32_t> stack;     //query scratch
+    Array<uint8_t> hits;       //query result per element
+    Array<uint8_t> unbounded;  //elements that must be always visible (post effects, unknown bounds)
+    Array<Paint*> elements;    //layer elements which the bounds were taken from
+    Array<SvgIndexCulled> culled;  //elements hidden by the index, referenced until they are shown again
+    Paint* root = nullptr;     //the scene tree which the bounds were taken from, built lazily at the first culling
+    uint32_t depth = 0;        //distance from the root to the layer
+};
+
+
+static void _merge(Point& min, Point& max, const Point& pt)
+{
+    if (pt.x < min.x) min.x = pt.x;
+    if (pt.y < min.y) min.y = pt.y;
+    if (pt.x > max.x) max.x = pt.x;
+    if (pt.y > max.y) max.y = pt.y;
+}
+
+
+//conservative bounds of the paint in the space of the matrix m, false if it's not bounded.
+static bool _bounds(Paint* paint, const Matrix& m, Point& min, Point& max)
+{
+    auto p = PAINT(paint);
+
+    //masking target could extend the region. (ie. MaskMethod::Add)
+    if (p->maskData && !_bounds(p->maskData->target, m, min, max)) return false;
+
+    auto pm = m * p->transform();
+
+    switch (paint->type()) {
+        case Type::Shape: {
+            auto& rs = SHAPE(paint)->rs;
+            float x, y, w, h;
+            if (!rs.path.bounds(&pm, &x, &y, &w, &h)) return true;   //nothing to draw
+            if (rs.stroke) {
+                //the stroke outline could go further than the half width by the joins and the caps
+                auto sx = sqrtf(pm.e11 * pm.e11 + pm.e21 * pm.e21);
+                auto sy = sqrtf(pm.e12 * pm.e12 + pm.e22 * pm.e22);
+                auto ext = 1.4143f;
+                if (rs.stroke->join == StrokeJoin::Miter && rs.stroke->miterlimit > ext) ext = rs.stroke->miterlimit;
+                auto feather = rs.stroke->width * std::max(sx, sy) * ext * 0.5f;
+                x -= feather;
+                y -= feather;
+                w += feather * 2.0f;
+                h += feather * 2.0f;
+            }
+            _merge(min, max, {x, y});
+            _merge(min, max, {x + w, y + h});
+            return true;
+        }
+        case Type::Scene: {
+            auto scene = SCENE(paint);
+            if (scene->effects) return false;
+            for (auto child : scene->paints) {
+                if (!_bounds(child, pm, min, max)) return false;
+            }
+            return true;
+        }
+        default: {
+            Point pt4[4];
+            auto tm = m;
+            if (p->bounds(pt4, &tm, false, true) != Result::Success) return false;
+            for (int i = 0; i < 4; ++i) _merge(min, max, pt4[i]);
+            return true;
+        }
+    }
+}
+
+
+//any pending change of the bounds in the subtree since the last update? (ie. edited by the user via Accessor)
+static bool _dirty(Paint* paint)
+{
+    auto p = PAINT(paint);
+    if (p->renderFlag & SVG_INDEX_DIRTY) return true;
+    //the clippers and the fast-tracked masking targets could only shrink the region, they don't affect the bounds.
+    if (p->maskData && !(PAINT(p->maskData->target)->ctxFlag & ContextFlag::FastTrack) && _dirty(p->maskData->target)) return true;
+    if (paint->type() == Type::Scene) {
+        for (auto child : SCENE(paint)->paints) {
+            if (_dirty(child)) return true;
+        }
+    }
+    return false;
+}
+
+
+//the post effects of the outer scenes (ie. blur, drop shadow) could pull the offscreen content into the viewport.
+static bool _effects(Paint* paint)
+{
+    for (auto parent = PAINT(paint)->parent; parent; parent = PAINT(parent)->parent) {
+        if (parent->type() == Type::Scene && SCENE(parent)->effects) return true;
+    }
+    return false;
+}
+
+
+//Sort-Tile-Recursive ordering, it keeps the neighbors in the same node.
+static void _sort(SvgIndexNode* nodes, uint32_t count)
+{
+    std::sort(nodes, nodes + count, [](const SvgIndexNode& a, const SvgIndexNode& b) {
+        return a.min.x + a.max.x < b.min.x + b.max.x;
+    });
+
+    auto slice = SVG_INDEX_NODE * uint32_t(ceilf(sqrtf(ceilf(float(count) / SVG_INDEX_NODE))));
+
+    for (uint32_t i = 0; i < count; i += slice) {
+        auto end = std::min(i + slice, count);
+        std::sort(nodes + i, nodes + end, [](const SvgIndexNode& a, const SvgIndexNode& b) {
+            return a.min.y + a.max.y < b.min.y + b.max.y;
+        });
+    }
+}
+
+
+//the first scene which has multiple children, the single-child wrappers (clipping layer, doc, groups) are passed through.
+static uint32_t _depth(Paint* paint)
+{
+    uint32_t depth = 0;
+    while (paint->type() == Type::Scene) {
+        auto scene = SCENE(paint);
+        if (scene->effects || PAINT(paint)->maskData) break;
+        if (scene->paints.size() != 1) return depth;
+        paint = scene->paints.front();
+        ++depth;
+    }
+    return UINT32_MAX;
+}
+
+
+//the layer scene at the depth. culling is false if the culling is not allowed by the effects or the masking on the way.
+static Scene* _layer(Paint* paint, Matrix& m, uint32_t depth, bool& culling)
+{
+    culling = true;
+    for (uint32_t i = 0; i <= depth; ++i) {
+        if (paint->type() != Type::Scene) return nullptr;
+        auto scene = SCENE(paint);
+        if (scene->effects || PAINT(paint)->maskData) culling = false;
+        m *= PAINT(paint)->transform();
+        if (i == depth) return static_cast<Scene*>(paint);
+        if (scene->paints.size() != 1) return nullptr;
+        paint = scene->paints.front();
+    }
+    return nullptr;
+}
+
+
+//pack the bounds of the layer elements into the tree
+static void _build(SvgIndex* index, Paint* root, Scene* layer)
+{
+    auto count = uint32_t(SCENE(layer)->paints.size());
+
+    index->root = root;
+    index->nodes.clear();
+    index->elements.clear();
+    index->elements.reserve(count);
+    index->hits.reserve(count);
+    index->unbounded.reserve(count);
+    index->hits.count = index->unbounded.count = count;
+
+    //leaves
+    auto m = tvg::identity();
+    uint32_t idx = 0;
+    for (auto child : SCENE(layer)->paints) {
+        index->elements.push(child);
+        SvgIndexNode node = {{FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX}, idx, 0};
+        if (_bounds(child, m, node.min, node.max)) {
+            index->unbounded[idx] = 0;
+            if (node.min.x <= node.max.x) index->nodes.push(node);
+        } else index->unbounded[idx] = 1;
+        ++idx;
+    }
+
+    //pack the nodes level by level up to the root
+    uint32_t begin = 0;
+    uint32_t end = index->nodes.count;
+
+    while (end - begin > 1) {
+        _sort(index->nodes.data + begin, end - begin);
+        for (auto i = begin; i < end; i += SVG_INDEX_NODE) {
+            SvgIndexNode node = {{FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX}, i, std::min(uint32_t(SVG_INDEX_NODE), end - i)};
+            for (auto j = i; j < i + node.cnt; ++j) {
+                _merge(node.min, node.max, index->nodes[j].min);
+                _merge(node.min, node.max, index->nodes[j].max);
+            }
+            index->nodes.push(node);
+        }
+        begin = end;
+        end = index->nodes.count;
+    }
+}
+
+
+static void _query(SvgIndex* index, const Matrix& m, const RenderRegion& vport)
+{
+    //viewport region in the layer space
+    Matrix inv;
+    if (vport.invalid() || !tvg::inverse(&m, &inv)) {
+        memset(index->hits.data, 1, index->hits.count);
+        return;
+    }
+
+    memcpy(index->hits.data, index->unbounded.data, index->hits.count);
+    if (index->nodes.empty()) return;
+
+    //1 pixel margin for the anti-aliasing
+    Point min = {FLT_MAX, FLT_MAX}, max = {-FLT_MAX, -FLT_MAX};
+    _merge(min, max, Point{float(vport.min.x - 1), float(vport.min.y - 1)} * inv);
+    _merge(min, max, Point{float(vport.max.x + 1), float(vport.min.y - 1)} * inv);
+    _merge(min, max, Point{float(vport.max.x + 1), float(vport.max.y + 1)} * inv);
+    _merge(min, max, Point{float(vport.min.x - 1), float(vport.max.y + 1)} * inv);
+
+    index->stack.clear();
+    index->stack.push(index->nodes.count - 1);
+
+    while (!index->stack.empty()) {
+        auto& node = index->nodes[index->stack.last()];
+        index->stack.pop();
+        if (node.max.x < min.x || node.min.x > max.x || node.max.y < min.y || node.min.y > max.y) continue;
+        if (node.cnt == 0) index->hits[node.idx] = 1;
+        else {
+            for (uint32_t i = 0; i < node.cnt; ++i) index->stack.push(node.idx + i);
+        }
+    }
+}
+
+
+//show the element again, unless the user has taken over its visibility in the meantime.
+static void _show(Paint* paint, bool damage)
+{
+    auto p = PAINT(paint);
+    if (p->hidden) {
+        if (damage) p->visible(false);
+        else p->hidden = false;
+    }
+    p->unrefx(true);
+}
+
+
+static void _restore(SvgIndex* index, bool damage)
+{
+    ARRAY_FOREACH(p, index->culled) _show(p->paint, damage);
+    index->culled.clear();
+}
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+SvgIndex* svgIndexBuild(Scene* root)
+{
+#ifdef THORVG_SVG_CULLING_SUPPORT
+    if (!root) return nullptr;
+
+    auto depth = _depth(root);
+    if (depth == UINT32_MAX) return nullptr;
+
+    auto m = tvg::identity();
+    bool culling;
+    auto layer = _layer(root, m, depth, culling);
+    if (!layer || SCENE(layer)->paints.size() < SVG_INDEX_MIN) return nullptr;
+
+    auto index = new SvgIndex;
+    index->depth = depth;
+    return index;
+#else
+    return nullptr;
+#endif
+}
+
+
+//the elements out of the viewport are hidden. it doesn't touch the elements hidden by the user,
+//and the ones moved or detached by the user are shown again.
+void svgIndexCull(SvgIndex* index, Paint* root, const Matrix& transform, const RenderRegion& vport)
+{
+    if (!index || !root) return;
+
+    auto m = transform;
+    bool culling;
+    auto layer = _layer(root, m, index->depth, culling);   //null if the scene tree was restructured by the user
+    if (culling) culling = !_effects(root);
+
+    if (!layer || !culling) {
+        _restore(index, true);
+        return;
+    }
+
+    //the bounds are taken right before the first culling, then whenever the user changed the elements.
+    auto& paints = SCENE(layer)->paints;
+    auto& elements = index->elements;
+    auto stale = (index->root != root || paints.size() != elements.count);
+    if (!stale) {
+        auto element = elements.data;
+        for (auto child : paints) {
+            if ((stale = (child != *element++ || _dirty(child)))) break;
+        }
+    }
+    if (stale) _build(index, root, layer);
+    _query(index, m, vport);
+
+    auto& hits = index->hits;
+    auto& culled = index->culled;
+
+    //keep the ones still out of the viewport
+    uint32_t cnt = 0;
+    ARRAY_FOREACH(p, culled) {
+        if (p->idx < elements.count && elements[p->idx] == p->paint && !hits[p->idx]) {
+            hits[p->idx] = 1;
+            if (PAINT(p->paint)->hidden) culled[cnt++] = *p;
+            else PAINT(p->paint)->unrefx(true);   //shown by the user
+        } else _show(p->paint, true);
+    }
+    culled.count = cnt;
+
+    //hide the newly culled ones
+    for (uint32_t i = 0; i < elements.count; ++i) {
+        if (hits[i]) continue;
+        auto p = PAINT(elements[i]);
+        if (p->hidden) continue;
+        p->visible(true);
+        p->ref();   //hold it while it's hidden, a detached one is shown again at the next culling
+        culled.push({elements[i], i});
+    }
+}
+
+
+void svgIndexFree(SvgIndex* index)
+{
+    if (!index) return;
+    //the document is going away, no need to redraw
+    _restore(index, false);
+    delete(index);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_SVG_INDEX_H_
+#define _TVG_SVG_INDEX_H_
+
+#include "tvgCommon.h"
+#include "tvgRender.h"
+
+/*
+ * Spatial index (packed R-tree) of the top-level element bounds of the built svg scene.
+ * The elements that are out of the viewport are hidden, so they skip the rasterization.
+ * It's enabled by the svg_culling build option and built only if the document has enough top-level elements to pay off.
+ * The bounds are taken again whenever the elements were changed since the last update.
+ */
+
+struct SvgIndex;
+
+SvgIndex* svgIndexBuild(Scene* root);
+void svgIndexCull(SvgIndex* index, Paint* root, const Matrix& transform, const RenderRegion& vport);
+void svgIndexFree(SvgIndex* index);
+
+#endif //_TVG_SVG_INDEX_H_
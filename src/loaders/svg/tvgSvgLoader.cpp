@@ -29,6 +29,8 @@
 #include "tvgSvgLoader.h"
 #include "tvgSvgSceneBuilder.h"
 #include "tvgSvgCssStyle.h"
+#include "tvgSvgCache.h"
+#include "tvgSvgIndex.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -3530,6 +3532,7 @@ static void _svgLoaderParserXmlCssStyle(SvgLoaderData* loader, const char* conte
         tvg::free(tag);
         tvg::free(name);
     }
+    cssUpdateIndex(loader->cssStyle);
     loader->openedTag = OpenedTagType::Other;
 }
 
@@ -3733,6 +3736,10 @@ static void _freeNode(SvgNode* node)
              tvg::free(node->node.text.fontFamily);
              break;
          }
+         case SvgNodeType::CssStyle: {
+             cssFreeIndex(node);
+             break;
+         }
          default: {
              break;
          }
@@ -3812,6 +3819,12 @@ void SvgLoader::clear(bool all)
 
     if (!all) return;
 
+    ARRAY_FOREACH(p, loaderData.tasks) {
+        (*p)->done();
+        delete(*p);
+    }
+    loaderData.tasks.reset();
+
     ARRAY_FOREACH(p, loaderData.images) tvg::free(*p);
     loaderData.images.reset();
 
@@ -3824,6 +3837,9 @@ void SvgLoader::clear(bool all)
 
     if (copy) tvg::free((char*)content);
 
+    svgIndexFree(index);
+    index = nullptr;
+
     delete(root);
     root = nullptr;
 
@@ -3890,6 +3906,9 @@ void SvgLoader::run(unsigned tid)
             w = loaderData.doc->node.doc.w;
             h = loaderData.doc->node.doc.h;
         }
+
+        svgCacheSave(content, size, root, w, h);
+        index = svgIndexBuild(root);
     }
 
     clear(false);
@@ -3898,6 +3917,12 @@ void SvgLoader::run(unsigned tid)
 
 bool SvgLoader::header()
 {
+    //Skip the whole parsing and building if the scene was cached already.
+    if (svgCacheLoad(content, size, &root, &w, &h)) {
+        index = svgIndexBuild(root);
+        return true;
+    }
+
     //For valid check, only <svg> tag is parsed first.
     //If the <svg> tag is found, the loaded file is valid and stores viewbox information.
     //After that, the remaining content data is parsed in order with async.
@@ -4023,6 +4048,12 @@ bool SvgLoader::resize(Paint* paint, float w, float h)
 }
 
 
+void SvgLoader::cull(Paint* paint, const Matrix& transform, const RenderRegion& vport)
+{
+    svgIndexCull(index, paint, transform, vport);
+}
+
+
 bool SvgLoader::read()
 {
     if (!content || size == 0) return false;
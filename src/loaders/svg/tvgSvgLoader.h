@@ -25,6 +25,7 @@
 
 #include "tvgTaskScheduler.h"
 #include "tvgSvgLoaderCommon.h"
+#include "tvgSvgIndex.h"
 
 class SvgLoader : public ImageLoader, public Task
 {
@@ -36,6 +37,7 @@ public:
 
     SvgLoaderData loaderData;
     Scene* root = nullptr;
+    SvgIndex* index = nullptr;   //top-level elements for the viewport culling
 
     bool copy = false;
 
@@ -45,6 +47,7 @@ public:
     bool open(const char* path) override;
     bool open(const char* data, uint32_t size, const char* rpath, bool copy) override;
     bool resize(Paint* paint, float w, float h) override;
+    void cull(Paint* paint, const Matrix& transform, const RenderRegion& vport) override;
     bool read() override;
     bool close() override;
 
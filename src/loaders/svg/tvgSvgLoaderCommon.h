@@ -27,6 +27,7 @@
 #include "tvgArray.h"
 #include "tvgInlist.h"
 #include "tvgColor.h"
+#include "tvgTaskScheduler.h"
 
 using SvgColor = tvg::RGB;
 
@@ -375,8 +376,11 @@ struct SvgMaskNode
     bool userSpace;
 };
 
+struct SvgCssIndex;
+
 struct SvgCssStyleNode
 {
+    SvgCssIndex* index;         //selector lookup table of the style sheet, see cssUpdateIndex()
 };
 
 struct SvgTextNode
@@ -597,6 +601,7 @@ struct SvgLoaderData
     Array<SvgNodeIdPair> nodesToStyle;
     Array<char*> images;        //embedded images
     Array<FontFace> fonts;
+    Array<Task*> tasks;         //scene build jobs, released after the workers are done with them
     int level = 0;
     bool result = false;
     OpenedTagType openedTag = OpenedTagType::Other;
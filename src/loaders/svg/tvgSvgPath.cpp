@@ -33,9 +33,21 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+static inline bool _isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+static inline bool _isDigit(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+
 static char* _skipComma(const char* content)
 {
-    while (*content && isspace(*content)) {
+    while (_isSpace(*content)) {
         content++;
     }
     if (*content == ',') return (char*)content + 1;
@@ -43,12 +55,87 @@ static char* _skipComma(const char* content)
 }
 
 
+//Fast path for the plain decimal numbers, which are the majority of the path data.
+//The significand and the power of ten are both exactly representable, so a single
+//multiplication or division gives the correctly rounded result (Clinger's fast path).
+//Anything else (inf, nan, too many digits, large exponents, malformed input) returns false.
+static bool _parseFloat(const char* str, float* number, char** end)
+{
+    static constexpr float pow10f[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    static constexpr double pow10d[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    auto p = str;
+    auto minus = false;
+
+    if (*p == '-') {
+        minus = true;
+        ++p;
+    } else if (*p == '+') ++p;
+
+    uint64_t significand = 0;
+    auto digits = 0;        //significant digits
+    auto exponent = 0;
+
+    auto begin = p;
+    for (; _isDigit(*p); ++p) {
+        if (digits < 19) {
+            significand = significand * 10 + (*p - '0');
+            if (significand > 0) ++digits;
+        } else ++exponent;
+    }
+    auto intDigits = p - begin;
+
+    if (*p == '.') {
+        begin = ++p;
+        for (; _isDigit(*p); ++p) {
+            if (digits < 19) {
+                significand = significand * 10 + (*p - '0');
+                if (significand > 0) ++digits;
+                --exponent;
+            }
+        }
+        //a dangling dot has the special treatments in toFloat()
+        if (p == begin) return false;
+    } else if (intDigits == 0) return false;
+
+    if (*p == 'e' || *p == 'E') {
+        auto q = p + 1;
+        auto minusE = false;
+        if (*q == '-') {
+            minusE = true;
+            ++q;
+        } else if (*q == '+') ++q;
+        if (!_isDigit(*q)) return false;
+        auto e = 0;
+        for (; _isDigit(*q); ++q) {
+            if (e < 10000) e = e * 10 + (*q - '0');
+        }
+        exponent += minusE ? -e : e;
+        p = q;
+    }
+
+    float val;
+    if (significand == 0) val = 0.0f;
+    else if (significand <= (1ULL << 24) && exponent >= -10 && exponent <= 10) {
+        val = (exponent < 0) ? (float(significand) / pow10f[-exponent]) : (float(significand) * pow10f[exponent]);
+    } else if (significand <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        val = float((exponent < 0) ? (double(significand) / pow10d[-exponent]) : (double(significand) * pow10d[exponent]));
+    } else return false;
+
+    *number = minus ? -val : val;
+    *end = (char*)p;
+    return true;
+}
+
+
 static bool _parseNumber(char** content, float* number)
 {
     char* end = NULL;
-    *number = toFloat(*content, &end);
-    //If the start of string is not number
-    if ((*content) == end) return false;
+    if (!_parseFloat(*content, number, &end)) {
+        *number = toFloat(*content, &end);
+        //If the start of string is not number
+        if ((*content) == end) return false;
+    }
     //Skip comma if any
     *content = _skipComma(end);
     return true;
@@ -417,6 +504,11 @@ bool svgPathToShape(const char* svgPath, RenderPath& out)
     auto isQuadratic = false;
     auto closed = false;
 
+    //Reserve the buffers in advance, a point takes roughly 8 characters in the typical path data.
+    auto len = strlen(svgPath);
+    out.pts.grow(len / 8);
+    out.cmds.grow(len / 16);
+
     while ((path[0] != '\0')) {
         path = _nextCommand(path, &cmd, numberArray, &numberCount, &closed);
         if (!path) break;
@@ -35,8 +35,10 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+struct SvgSceneTask;
+
 static bool _appendClipShape(SvgLoaderData& loaderData, SvgNode* node, Shape* shape, const Box& vBox, const string& svgPath, const Matrix* transform);
-static Scene* _sceneBuildHelper(SvgLoaderData& loaderData, const SvgNode* node, const Box& vBox, const string& svgPath, bool mask, int depth);
+static Scene* _sceneBuildHelper(SvgLoaderData& loaderData, const SvgNode* node, const Box& vBox, const string& svgPath, bool mask, int depth, SvgSceneTask** tasks = nullptr);
 
 
 static inline bool _isGroupType(SvgNodeType type)
@@ -886,7 +888,120 @@ static Paint* _textBuildHelper(SvgLoaderData& loaderData, const SvgNode* node, c
 }
 
 
-static Scene* _sceneBuildHelper(SvgLoaderData& loaderData, const SvgNode* node, const Box& vBox, const string& svgPath, bool mask, int depth)
+#ifdef THORVG_THREAD_SUPPORT
+
+//Builds an independent top-level group on a worker thread.
+//Whichever thread claims the job first builds it, so the dominant builder never blocks on a queued job.
+struct SvgSceneTask : Task
+{
+    SvgLoaderData* loaderData;
+    const SvgNode* node;
+    Box vBox;
+    const string* svgPath;
+    Scene* scene = nullptr;
+
+    mutex mtx;
+    condition_variable cv;
+    bool claimed = false;
+    bool built = false;
+
+    SvgSceneTask(SvgLoaderData* loaderData, const SvgNode* node, const Box& vBox, const string* svgPath) : loaderData(loaderData), node(node), vBox(vBox), svgPath(svgPath) {}
+
+    bool claim()
+    {
+        lock_guard<mutex> lock(mtx);
+        if (claimed) return false;
+        claimed = true;
+        return true;
+    }
+
+    void build()
+    {
+        auto ret = _sceneBuildHelper(*loaderData, node, vBox, *svgPath, false, 1);
+        {
+            lock_guard<mutex> lock(mtx);
+            scene = ret;
+            built = true;
+        }
+        cv.notify_one();
+    }
+
+    Scene* get()
+    {
+        if (claim()) build();
+        else {
+            unique_lock<mutex> lock(mtx);
+            while (!built) cv.wait(lock);
+        }
+        return scene;
+    }
+
+protected:
+    void run(unsigned tid) override
+    {
+        if (claim()) build();
+    }
+};
+
+
+//Subtrees referring to the other nodes (clip, mask, filter, use) or touching the shared loader data (image, text) are built serially.
+static bool _independent(const SvgNode* node)
+{
+    if (node->type == SvgNodeType::Use || node->type == SvgNodeType::Image || node->type == SvgNodeType::Text) return false;
+    if (node->style->clipPath.node || node->style->mask.node || node->style->filter.node) return false;
+
+    ARRAY_FOREACH(p, node->child) {
+        if (!_independent(*p)) return false;
+    }
+    return true;
+}
+
+
+static SvgSceneTask** _requestSceneTasks(SvgLoaderData& loaderData, const SvgNode* doc, const Box& vBox, const string& svgPath)
+{
+    if (TaskScheduler::threads() < 2 || !doc->style->display || doc->style->opacity == 0) return nullptr;
+
+    auto tasks = tvg::calloc<SvgSceneTask**>(doc->child.count, sizeof(SvgSceneTask*));
+    auto cnt = 0;
+
+    for (uint32_t i = 0; i < doc->child.count; ++i) {
+        auto child = doc->child[i];
+        if (child->type != SvgNodeType::G || child->child.empty() || !_independent(child)) continue;
+        tasks[i] = new SvgSceneTask(&loaderData, child, vBox, &svgPath);
+        ++cnt;
+    }
+
+    //not worth it
+    if (cnt < 2) {
+        for (uint32_t i = 0; i < doc->child.count; ++i) delete(tasks[i]);
+        tvg::free(tasks);
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < doc->child.count; ++i) {
+        if (!tasks[i]) continue;
+        loaderData.tasks.push(tasks[i]);
+        TaskScheduler::request(tasks[i]);
+    }
+    return tasks;
+}
+
+#else
+
+struct SvgSceneTask
+{
+    Scene* get() { return nullptr; }
+};
+
+static SvgSceneTask** _requestSceneTasks(TVG_UNUSED SvgLoaderData& loaderData, TVG_UNUSED const SvgNode* doc, TVG_UNUSED const Box& vBox, TVG_UNUSED const string& svgPath)
+{
+    return nullptr;
+}
+
+#endif
+
+
+static Scene* _sceneBuildHelper(SvgLoaderData& loaderData, const SvgNode* node, const Box& vBox, const string& svgPath, bool mask, int depth, SvgSceneTask** tasks)
 {
     /* Exception handling: Prevent invalid SVG data input.
        The size is the arbitrary value, we need an experimental size. */
@@ -908,7 +1023,9 @@ static Scene* _sceneBuildHelper(SvgLoaderData& loaderData, const SvgNode* node,
     ARRAY_FOREACH(p, node->child) {
         auto child = *p;
         if (_isGroupType(child->type)) {
-            if (child->type == SvgNodeType::Use)
+            if (tasks && tasks[p - node->child.begin()])
+                scene->push(tasks[p - node->child.begin()]->get());
+            else if (child->type == SvgNodeType::Use)
                 scene->push(_useBuildHelper(loaderData, child, vBox, svgPath, depth + 1));
             else if (!(child->type == SvgNodeType::Symbol && node->type != SvgNodeType::Use))
                 scene->push(_sceneBuildHelper(loaderData, child, vBox, svgPath, false, depth + 1));
@@ -998,7 +1115,10 @@ Scene* svgSceneBuild(SvgLoaderData& loaderData, Box vBox, float w, float h, Aspe
 
     _loadFonts(loaderData.fonts);
 
-    auto docNode = _sceneBuildHelper(loaderData, loaderData.doc, vBox, svgPath, false, 0);
+    //fan out the independent top-level groups onto the workers, they are assembled in the document order.
+    auto tasks = _requestSceneTasks(loaderData, loaderData.doc, vBox, svgPath);
+    auto docNode = _sceneBuildHelper(loaderData, loaderData.doc, vBox, svgPath, false, 0, tasks);
+    tvg::free(tasks);
 
     if (!(viewFlag & SvgViewFlag::Viewbox)) _updateInvalidViewSize(docNode, vBox, w, h, viewFlag);
 
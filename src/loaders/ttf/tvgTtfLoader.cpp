@@ -22,6 +22,7 @@
 
 
 #include "tvgStr.h"
+#include "tvgShape.h"
 #include "tvgTtfLoader.h"
 
 #if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
@@ -37,6 +38,10 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+static atomic<uint32_t> _fid{0};
+#endif
+
 #ifdef THORVG_FILE_IO_SUPPORT
 
 #if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
@@ -196,6 +201,17 @@ static uint32_t* _codepoints(const char* text, size_t n)
 }
 
 
+static void _append(RenderPath& path, const RenderPath& glyph, const Point& offset)
+{
+    path.cmds.push(glyph.cmds);
+    path.pts.grow(glyph.pts.count);
+
+    auto dst = path.pts.end();
+    ARRAY_FOREACH(p, glyph.pts) *dst++ = *p + offset;
+    path.pts.count += glyph.pts.count;
+}
+
+
 void TtfLoader::clear()
 {
     if (nomap) {
@@ -210,12 +226,42 @@ void TtfLoader::clear()
 #endif
     }
 
+    for (int i = 0; i < 256; ++i) {
+        delete[] glyphs[i];
+        glyphs[i] = nullptr;
+    }
+
     tvg::free(name);
     name = nullptr;
     shape = nullptr;
 }
 
 
+TtfGlyph* TtfLoader::glyph(uint32_t codepoint)
+{
+    auto id = reader.glyph(codepoint);
+    if (id > 0xffff) {
+        TVGERR("TTF", "invalid glyph id, codepoint(0x%x)", codepoint);
+        return nullptr;
+    }
+
+    auto& page = glyphs[id >> 8];
+    if (!page) page = new TtfGlyph[256];
+
+    auto glyph = &page[id & 0xff];
+    if (!glyph->loaded) {
+        if (!reader.glyphMetrics(id, glyph->metrics)) {
+            TVGERR("TTF", "invalid glyph id, codepoint(0x%x)", codepoint);
+            return nullptr;
+        }
+        glyph->id = id;
+        glyph->broken = !reader.convert(glyph->path, glyph->metrics, {0.0f, 0.0f}, {0.0f, 0.0f}, 1U);
+        glyph->loaded = true;
+    }
+    return glyph;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -250,6 +296,9 @@ bool TtfLoader::open(const char* path)
 #ifdef THORVG_FILE_IO_SUPPORT
     clear();
     if (!_map(this, path)) return false;
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+    fid = ++_fid;
+#endif
 
     name = tvg::filename(path);
 
@@ -264,6 +313,9 @@ bool TtfLoader::open(const char* data, uint32_t size, TVG_UNUSED const char* rpa
 {
     reader.size = size;
     nomap = true;
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+    fid = ++_fid;
+#endif
 
     if (copy) {
         reader.data = tvg::malloc<uint8_t*>(size);
@@ -276,37 +328,80 @@ bool TtfLoader::open(const char* data, uint32_t size, TVG_UNUSED const char* rpa
 }
 
 
-bool TtfLoader::read(Shape* shape, char* text, FontMetrics& out)
+bool TtfLoader::read(Shape* shape, char* text, FontMetrics& out, FontRun& run)
 {
     if (!text) return false;
 
-    shape->reset();
-
     auto n = strlen(text);
     auto code = _codepoints(text, n);
     if (!code) return false;
 
-    //TODO: optimize with the texture-atlas?
-    TtfGlyphMetrics gmetrics;
+    //the glyph outlines are decoded once, and then appended with the pen offsets.
+    ScopedLock lock(key);
+
+    //the glyphs of the unchanged prefix are kept as they were.
+    uint32_t idx = 0;
+    while (idx < run.glyphs.count && code[idx] && code[idx] == run.glyphs[idx].codepoint) ++idx;
+
+    if (idx == run.glyphs.count && !code[idx]) {
+        tvg::free(code);
+        return true;
+    }
+
+    auto& path = SHAPE(shape)->rs.path;
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+    auto& layout = SHAPE(shape)->rs.glyphs;     //for the glyph coverage cache of the sw engine
+#endif
     Point offset = {0.0f, reader.metrics.hhea.ascent};
     Point kerning = {0.0f, 0.0f};
     auto lglyph = INVALID_GLYPH;
-    auto loadMinw = true;
 
-    size_t idx = 0;
+    //resume from the layout state of the last unchanged glyph.
+    if (idx > 0) {
+        auto& state = run.glyphs[idx - 1];
+        offset = state.pen;
+        lglyph = state.lglyph;
+        path.cmds.count = state.cmds;
+        path.pts.count = state.pts;
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        layout.count = state.layout;
+#endif
+    } else {
+        path.cmds.clear();
+        path.pts.clear();
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        layout.clear();
+#endif
+    }
+    run.glyphs.count = idx;
+    SHAPE(shape)->impl.mark(RenderUpdateFlag::Path);
+
+    auto loadMinw = path.cmds.empty();
+
     while (code[idx] && idx < n) {
-        auto rglyph = reader.glyph(code[idx], gmetrics);
-        if (rglyph != INVALID_GLYPH) {
-            if (lglyph != INVALID_GLYPH) reader.kerning(lglyph, rglyph, kerning);
-            if (!reader.convert(shape, gmetrics, offset, kerning, 1U)) break;
-            offset.x += (gmetrics.advanceWidth + kerning.x);
-            lglyph = rglyph;
+        auto rglyph = glyph(code[idx]);
+        if (rglyph) {
+            if (lglyph != INVALID_GLYPH) reader.kerning(lglyph, rglyph->id, kerning);
+            if (rglyph->broken) break;
+            if (!rglyph->path.cmds.empty()) {
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+                layout.push({(uint64_t(fid) << 32) | rglyph->id, offset + kerning, rglyph->path.cmds.count, rglyph->path.pts.count});
+#endif
+                _append(path, rglyph->path, offset + kerning);
+            }
+            offset.x += (rglyph->metrics.advanceWidth + kerning.x);
+            lglyph = rglyph->id;
             //store the first glyph with outline min size for italic transform.
-            if (loadMinw && gmetrics.outline) {
-                out.minw = gmetrics.minw;
+            if (loadMinw && rglyph->metrics.outline) {
+                out.minw = rglyph->metrics.minw;
                 loadMinw = false;
             }
         }
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        run.glyphs.push({code[idx], lglyph, offset, path.cmds.count, path.pts.count, layout.count});
+#else
+        run.glyphs.push({code[idx], lglyph, offset, path.cmds.count, path.pts.count});
+#endif
         ++idx;
     }
 
@@ -24,16 +24,33 @@
 #define _TVG_TTF_LOADER_H_
 
 #include "tvgLoader.h"
+#include "tvgLock.h"
 #include "tvgTaskScheduler.h"
 #include "tvgTtfReader.h"
 
 
+//decoded glyph, the outline is placed at the origin in the font units.
+struct TtfGlyph
+{
+    RenderPath path;
+    TtfGlyphMetrics metrics;
+    uint32_t id;
+    bool loaded = false;    //decoded already
+    bool broken = false;    //the outline data is broken
+};
+
+
 struct TtfLoader : public FontLoader
 {
 #if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
     void* mapping = nullptr;
 #endif
     TtfReader reader;
+    TtfGlyph* glyphs[256] = {};   //glyph cache, paged by the upper 8 bits of the glyph id
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+    uint32_t fid = 0;             //unique font id for the glyph keys
+#endif
+    Key key;
     char* text = nullptr;
     Shape* shape = nullptr;
     bool nomap = false;
@@ -48,8 +65,9 @@ struct TtfLoader : public FontLoader
     bool open(const char* path) override;
     bool open(const char *data, uint32_t size, const char* rpath, bool copy) override;
     float transform(Paint* paint, FontMetrics& metrices, float fontSize, bool italic) override;
-    bool read(Shape* shape, char* text, FontMetrics& out) override;
+    bool read(Shape* shape, char* text, FontMetrics& out, FontRun& run) override;
     void clear();
+    TtfGlyph* glyph(uint32_t codepoint);
 };
 
 #endif //_TVG_PNG_LOADER_H_
@@ -22,7 +22,6 @@
 
 #include "tvgTtfReader.h"
 #include "tvgMath.h"
-#include "tvgShape.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -188,6 +187,256 @@ uint32_t TtfReader::cmap_6(uint32_t table, uint32_t codepoint) const
 }
 
 
+#define CMAP_PAGES (0x110000 >> 8)
+#define CMAP_UNKNOWN 0xffff           //not in the table, falls back to the subtable lookup
+#define CMAP_EXPANSION 0x40000        //expanded codepoints at most, it bounds the work of the crafted fonts
+#define KERNING_EMPTY 0xffffffff
+
+
+static inline uint32_t _kerningHash(uint32_t key)
+{
+    key = (key ^ (key >> 16)) * 0x45d9f3b;
+    return key ^ (key >> 16);
+}
+
+
+//select the unicode cmap subtable in the priority of the full repertory and the BMP.
+void TtfReader::encodingSelect()
+{
+    encoding.table = 0;
+    encoding.format = 0;
+
+    auto cmap = this->cmap = table("cmap");
+    if (!validate(cmap, 4)) return;
+
+    auto entryCnt = _u16(data, cmap + 2);
+    if (!validate(cmap, 4 + entryCnt * 8)) return;
+
+    //full repertory (non-BMP map).
+    for (auto idx = 0; idx < entryCnt; ++idx) {
+        auto entry = cmap + 4 + idx * 8;
+        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
+        //unicode map
+        if (type == 0004 || type == 0312) {
+            auto table = cmap + _u32(data, entry + 4);
+            if (!validate(table, 8)) return;
+            if (_u16(data, table) == 12) {
+                encoding.table = table;
+                encoding.format = 12;
+            }
+            return;
+        }
+    }
+
+    //Try looking for a BMP map.
+    for (auto idx = 0; idx < entryCnt; ++idx) {
+        auto entry = cmap + 4 + idx * 8;
+        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
+        //Unicode BMP
+        if (type == 0003 || type == 0301) {
+            auto table = cmap + _u32(data, entry + 4);
+            if (!validate(table, 6)) return;
+            auto format = _u16(data, table);
+            if (format == 4 || format == 6) {
+                encoding.table = table + 6;
+                encoding.format = format;
+            }
+            return;
+        }
+    }
+}
+
+
+uint32_t TtfReader::lookup(uint32_t codepoint) const
+{
+    switch (encoding.format) {
+        case 12: return cmap_12_13(encoding.table, codepoint, 12);
+        case 4: return cmap_4(encoding.table, codepoint);
+        case 6: return cmap_6(encoding.table, codepoint);
+        default: return -1;
+    }
+}
+
+
+void TtfReader::cmapSet(uint32_t codepoint, uint32_t glyph)
+{
+    if (codepoint >= 0x110000 || glyph >= CMAP_UNKNOWN) return;
+
+    auto& page = cmapPages[codepoint >> 8];
+    if (!page) {
+        page = tvg::malloc<uint16_t*>(256 * sizeof(uint16_t));
+        memset(page, 0xff, 256 * sizeof(uint16_t));
+    }
+    //the first matched one has the priority as the subtable lookup does.
+    auto& entry = page[codepoint & 0xff];
+    if (entry == CMAP_UNKNOWN) entry = static_cast<uint16_t>(glyph);
+}
+
+
+//Expand the mapped ranges of the subtable into the codepoint pages.
+//The codepoints out of the ranges are resolved by the subtable lookup as before.
+void TtfReader::cmapBuild()
+{
+    auto table = encoding.table;
+
+    if (encoding.format == 12) {
+        auto len = _u32(data, table + 4);
+        if (len < 16 || !validate(table, len)) return;
+        auto entryCnt = _u32(data, table + 12);
+        if (entryCnt > (len - 16) / 12) return;
+
+        cmapPages = tvg::calloc<uint16_t**>(CMAP_PAGES, sizeof(uint16_t*));
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < entryCnt; ++i) {
+            auto firstCode = _u32(data, table + (i * 12) + 16);
+            auto lastCode = _u32(data, table + (i * 12) + 16 + 4);
+            auto glyphOffset = _u32(data, table + (i * 12) + 16 + 8);
+            if (lastCode > 0x10ffff) lastCode = 0x10ffff;
+            if (firstCode > lastCode) continue;
+            //stop at the oversized range, it and the following groups are left to the subtable lookup in the same order.
+            if (lastCode - firstCode >= CMAP_EXPANSION - total) break;
+            total += lastCode - firstCode + 1;
+            for (auto code = firstCode; code <= lastCode; ++code) {
+                cmapSet(code, (code - firstCode) + glyphOffset);
+            }
+        }
+    } else if (encoding.format == 4) {
+        if (!validate(table, 8)) return;
+        auto segmentCnt = _u16(data, table);
+        if ((segmentCnt & 1) || segmentCnt == 0) return;
+
+        auto endCodes = table + 8;
+        auto startCodes = endCodes + segmentCnt + 2;
+        auto idDeltas = startCodes + segmentCnt;
+        auto idRangeOffsets = idDeltas + segmentCnt;
+        if (!validate(idRangeOffsets, segmentCnt)) return;
+
+        //the segments must be sorted for the binary search, otherwise leave them to the subtable lookup.
+        for (uint32_t i = 2; i < segmentCnt; i += 2) {
+            if (_u16(data, endCodes + i - 2) >= _u16(data, endCodes + i)) return;
+        }
+
+        cmapPages = tvg::calloc<uint16_t**>(CMAP_PAGES, sizeof(uint16_t*));
+        uint32_t begin = 0;
+        for (uint32_t i = 0; i < segmentCnt; i += 2) {
+            uint32_t startCode = _u16(data, startCodes + i);
+            uint32_t endCode = _u16(data, endCodes + i);
+            auto delta = _u16(data, idDeltas + i);
+            auto idRangeOffset = _u16(data, idRangeOffsets + i);
+            //the codes below the previous segment end belong to that segment.
+            for (auto code = std::max(startCode, begin); code <= endCode; ++code) {
+                //intentional integer under- and overflow.
+                if (idRangeOffset == 0) {
+                    cmapSet(code, (code + delta) & 0xffff);
+                    continue;
+                }
+                auto offset = idRangeOffsets + i + idRangeOffset + 2U * (code - startCode);
+                if (offset > size || size - offset < 2) continue;
+                auto id = _u16(data, offset);
+                cmapSet(code, id > 0 ? ((id + delta) & 0xffff) : 0);
+            }
+            begin = endCode + 1;
+        }
+    } else if (encoding.format == 6) {
+        uint32_t firstCode = _u16(data, table);
+        auto entryCnt = _u16(data, table + 2);
+        if (!validate(table, 4 + 2 * entryCnt)) return;
+
+        cmapPages = tvg::calloc<uint16_t**>(CMAP_PAGES, sizeof(uint16_t*));
+        for (uint32_t i = 0; i < entryCnt; ++i) {
+            cmapSet(firstCode + i, _u16(data, table + 4 + 2 * i));
+        }
+    }
+}
+
+
+//Gather the pairs of the horizontal kerning subtables into a hash map of the accumulated values.
+//As the table search does, the subtables are accumulated while the first pair wins in a subtable.
+void TtfReader::kerningBuild()
+{
+    #define HORIZONTAL_KERNING 0x01
+    #define MINIMUM_KERNING 0x02
+    #define CROSS_STREAM_KERNING 0x04
+
+    auto kern = this->kern.load();
+    if (!kern) return;
+
+    //count the pairs
+    uint32_t pairCnt = 0;
+    auto tableCnt = _u16(data, kern + 2);
+    auto offset = kern + 4;
+    for (auto i = 0; i < tableCnt; ++i) {
+        if (!validate(offset, 6)) return;
+        auto length = _u16(data, offset + 2);
+        auto format = _u8(data, offset + 4);
+        auto flags = _u8(data, offset + 5);
+        if (format == 0 && (flags & HORIZONTAL_KERNING) && !(flags & MINIMUM_KERNING)) {
+            if (!validate(offset + 6, 8)) return;
+            auto cnt = _u16(data, offset + 6);
+            if (!validate(offset + 14, cnt * 6)) return;
+            pairCnt += cnt;
+            offset += 8;
+        }
+        //the same walk with the table search
+        offset += 6 + length;
+    }
+    if (pairCnt == 0) return;
+
+    uint32_t capacity = 16;
+    while (capacity < pairCnt * 2) capacity <<= 1;
+
+    kernPairs = tvg::malloc<TtfKerningPair*>(capacity * sizeof(TtfKerningPair));
+    kernMask = capacity - 1;
+    for (uint32_t i = 0; i < capacity; ++i) kernPairs[i].key = KERNING_EMPTY;
+
+    offset = kern + 4;
+    for (auto i = 0; i < tableCnt; ++i) {
+        auto length = _u16(data, offset + 2);
+        auto format = _u8(data, offset + 4);
+        auto flags = _u8(data, offset + 5);
+        if (format == 0 && (flags & HORIZONTAL_KERNING) && !(flags & MINIMUM_KERNING)) {
+            auto cnt = _u16(data, offset + 6);
+            auto pair = offset + 14;
+            for (auto j = 0; j < cnt; ++j, pair += 6) {
+                auto key = _u32(data, pair);
+                //not representable, leave the pairs to the table search.
+                if (key == KERNING_EMPTY) {
+                    tvg::free(kernPairs);
+                    kernPairs = nullptr;
+                    return;
+                }
+                auto idx = _kerningHash(key) & kernMask;
+                while (kernPairs[idx].key != KERNING_EMPTY && kernPairs[idx].key != key) idx = (idx + 1) & kernMask;
+                auto& entry = kernPairs[idx];
+                if (entry.key == KERNING_EMPTY) {
+                    entry.key = key;
+                    entry.value = {0.0f, 0.0f};
+                } else if (entry.table == i) continue;   //duplicated pair in the subtable
+                entry.table = i;
+                auto value = _i16(data, pair + 4);
+                if (flags & CROSS_STREAM_KERNING) entry.value.y += value;
+                else entry.value.x += value;
+            }
+            offset += 8;
+        }
+        offset += 6 + length;
+    }
+}
+
+
+void TtfReader::reset()
+{
+    if (cmapPages) {
+        for (int i = 0; i < CMAP_PAGES; ++i) tvg::free(cmapPages[i]);
+        tvg::free(cmapPages);
+        cmapPages = nullptr;
+    }
+    tvg::free(kernPairs);
+    kernPairs = nullptr;
+    kernMask = 0;
+}
+
+
 //Returns the offset into the font that the glyph's outline is stored at
 uint32_t TtfReader::outlineOffset(uint32_t glyph)
 {
@@ -294,8 +543,16 @@ bool TtfReader::flags(uint32_t *outline, uint8_t* flags, uint32_t flagsCnt)
 /* External Class Implementation                                        */
 /************************************************************************/
 
+TtfReader::~TtfReader()
+{
+    reset();
+}
+
+
 bool TtfReader::header()
 {
+    reset();
+
     if (!validate(0, 12)) return false;
 
     //verify ttf(scalable font)
@@ -325,55 +582,24 @@ bool TtfReader::header()
         if (_u16(data, kern) != 0) return false;
     }
 
+    //direct lookup tables for the per character accesses.
+    encodingSelect();
+    cmapBuild();
+    kerningBuild();
+
     return true;
 }
 
 
 uint32_t TtfReader::glyph(uint32_t codepoint)
 {
-    auto cmap = this->cmap.load();
-    if (cmap == 0) {
-        this->cmap = cmap = table("cmap");
-        if (!validate(cmap, 4)) return -1;
-    }
-
-    auto entryCnt = _u16(data, cmap + 2);
-    if (!validate(cmap, 4 + entryCnt * 8)) return -1;
-
-    //full repertory (non-BMP map).
-    for (auto idx = 0; idx < entryCnt; ++idx) {
-        auto entry = cmap + 4 + idx * 8;
-        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
-        //unicode map
-        if (type == 0004 || type == 0312) {
-            auto table = cmap + _u32(data, entry + 4);
-            if (!validate(table, 8)) return -1;
-            //dispatch based on cmap format.
-            auto format = _u16(data, table);
-            switch (format) {
-                case 12: return cmap_12_13(table, codepoint, 12);
-                default: return -1;
-            }
+    if (cmapPages && codepoint < 0x110000) {
+        if (auto page = cmapPages[codepoint >> 8]) {
+            auto glyph = page[codepoint & 0xff];
+            if (glyph != CMAP_UNKNOWN) return glyph;
         }
     }
-
-    //Try looking for a BMP map.
-    for (auto idx = 0; idx < entryCnt; ++idx) {
-        auto entry = cmap + 4 + idx * 8;
-        auto type = _u16(data, entry) * 0100 + _u16(data, entry + 2);
-        //Unicode BMP
-        if (type == 0003 || type == 0301) {
-            auto table = cmap + _u32(data, entry + 4);
-            if (!validate(table, 6)) return -1;
-            //Dispatch based on cmap format.
-            switch (_u16(data, table)) {
-                case 4: return cmap_4(table + 6, codepoint);
-                case 6: return cmap_6(table + 6, codepoint);
-                default: return -1;
-            }
-        }
-    }
-    return -1;
+    return lookup(codepoint);
 }
 
 
@@ -436,7 +662,7 @@ bool TtfReader::glyphMetrics(uint32_t glyphIndex, TtfGlyphMetrics& gmetrics)
     return true;
 }
 
-bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
+bool TtfReader::convert(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
 {
     #define ON_CURVE 0x01
 
@@ -451,7 +677,7 @@ bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& of
             maxComponentDepth = _u16(data, maxp + 30);
         }
         if (componentDepth > maxComponentDepth) return false;
-        return convertComposite(shape, gmetrics, offset, kerning, componentDepth + 1);
+        return convertComposite(path, gmetrics, offset, kerning, componentDepth + 1);
     }
     auto cntrsCnt = (uint32_t) outlineCnt;
 
@@ -474,7 +700,6 @@ bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& of
     if (!this->points(outline, flags, pts, ptsCnt, offset + kerning)) return false;
 
     //generate tvg paths.
-    auto& path = SHAPE(shape)->rs.path;
     path.cmds.reserve(ptsCnt);
     path.pts.reserve(ptsCnt);
 
@@ -514,7 +739,7 @@ bool TtfReader::convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& of
     return true;
 }
 
-bool TtfReader::convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
+bool TtfReader::convertComposite(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth)
 {
     #define ARG_1_AND_2_ARE_WORDS 0x0001
     #define ARGS_ARE_XY_VALUES 0x0002
@@ -576,7 +801,7 @@ bool TtfReader::convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const
             pointer += 8U;
         }
         if (!glyphMetrics(glyphIndex, componentGmetrics)) return false;
-        if (!convert(shape, componentGmetrics, offset + componentOffset, kerning, componentDepth)) return false;
+        if (!convert(path, componentGmetrics, offset + componentOffset, kerning, componentDepth)) return false;
     } while (flags & MORE_COMPONENTS);
     return true;
 }
@@ -584,16 +809,25 @@ bool TtfReader::convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const
 
 void TtfReader::kerning(uint32_t lglyph, uint32_t rglyph, Point& out)
 {
-    #define HORIZONTAL_KERNING 0x01
-    #define MINIMUM_KERNING 0x02
-    #define CROSS_STREAM_KERNING 0x04
-
     if (!kern) return;
 
     auto kern = this->kern.load();
 
     out.x = out.y = 0.0f;
 
+    if (kernPairs) {
+        auto key = (lglyph & 0xffff) << 16 | (rglyph & 0xffff);
+        auto idx = _kerningHash(key) & kernMask;
+        while (kernPairs[idx].key != KERNING_EMPTY) {
+            if (kernPairs[idx].key == key) {
+                out = kernPairs[idx].value;
+                return;
+            }
+            idx = (idx + 1) & kernMask;
+        }
+        return;
+    }
+
     //kern tables
     auto tableCnt = _u16(data, kern + 2);
     kern += 4;
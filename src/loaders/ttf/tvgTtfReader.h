@@ -26,6 +26,7 @@
 #include <atomic>
 #include "tvgCommon.h"
 #include "tvgArray.h"
+#include "tvgRender.h"
 
 #define INVALID_GLYPH ((uint32_t)-1)
 
@@ -41,6 +42,14 @@ struct TtfGlyphMetrics
 };
 
 
+struct TtfKerningPair
+{
+    uint32_t key;        //left glyph id << 16 | right glyph id
+    Point value;
+    uint16_t table;      //the last subtable which added the value
+};
+
+
 struct TtfReader
 {
 public:
@@ -61,10 +70,14 @@ public:
         uint8_t locaFormat;    //0 for short offsets, 1 for long
     } metrics;
 
+    ~TtfReader();
+
     bool header();
+    uint32_t glyph(uint32_t codepoint);
     uint32_t glyph(uint32_t codepoint, TtfGlyphMetrics& gmetrics);
+    bool glyphMetrics(uint32_t glyphIndex, TtfGlyphMetrics& gmetrics);
     void kerning(uint32_t lglyph, uint32_t rglyph, Point& out);
-    bool convert(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
+    bool convert(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
 
 private:
     //table offsets
@@ -75,15 +88,30 @@ private:
     atomic<uint32_t> kern{};
     atomic<uint32_t> maxp{};
 
+    //the selected unicode cmap subtable
+    struct {
+        uint32_t table = 0;
+        uint16_t format = 0;     //0: no supported subtable
+    } encoding;
+
+    //the direct lookup tables, built on the font open
+    uint16_t** cmapPages = nullptr;     //codepoint to glyph id, in pages of 256 codepoints
+    TtfKerningPair* kernPairs = nullptr;  //horizontal kerning pairs, in an open addressing hash
+    uint32_t kernMask = 0;
+
+    uint32_t lookup(uint32_t codepoint) const;
+    void encodingSelect();
+    void cmapBuild();
+    void cmapSet(uint32_t codepoint, uint32_t glyph);
+    void kerningBuild();
+    void reset();
     uint32_t cmap_12_13(uint32_t table, uint32_t codepoint, int which) const;
     uint32_t cmap_4(uint32_t table, uint32_t codepoint) const;
     uint32_t cmap_6(uint32_t table, uint32_t codepoint) const;
     bool validate(uint32_t offset, uint32_t margin) const;
     uint32_t table(const char* tag);
     uint32_t outlineOffset(uint32_t glyph);
-    uint32_t glyph(uint32_t codepoint);
-    bool glyphMetrics(uint32_t glyphIndex, TtfGlyphMetrics& gmetrics);
-    bool convertComposite(Shape* shape, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
+    bool convertComposite(RenderPath& path, TtfGlyphMetrics& gmetrics, const Point& offset, const Point& kerning, uint16_t componentDepth);
     bool genPath(uint8_t* flags, uint16_t basePoint, uint16_t count);
     bool genSimpleOutline(Shape* shape, uint32_t outline, uint32_t cntrsCnt);
     bool points(uint32_t outline, uint8_t* flags, Point* pts, uint32_t ptsCnt, const Point& offset);
@@ -35,17 +35,20 @@ void WebpLoader::clear()
 
 void WebpLoader::run(unsigned tid)
 {
-    if (surface.cs == ColorSpace::ARGB8888 || surface.cs == ColorSpace::ARGB8888S) {
-        surface.buf8 = WebPDecodeBGRA(data, size, nullptr, nullptr);
-        surface.cs = ColorSpace::ARGB8888;
-    } else  {
-        surface.buf8 = WebPDecodeRGBA(data, size, nullptr, nullptr);
-        surface.cs = ColorSpace::ABGR8888;
+    auto bgra = (surface.cs == ColorSpace::ARGB8888 || surface.cs == ColorSpace::ARGB8888S);
+
+    if (scaledW > 0) {
+        surface.buf8 = bgra ? WebPDecodeScaledBGRA(data, size, scaledW, scaledH) : WebPDecodeScaledRGBA(data, size, scaledW, scaledH);
+        surface.w = scaledW;
+        surface.h = scaledH;
+    } else {
+        surface.buf8 = bgra ? WebPDecodeBGRA(data, size, nullptr, nullptr) : WebPDecodeRGBA(data, size, nullptr, nullptr);
+        surface.w = static_cast<uint32_t>(w);
+        surface.h = static_cast<uint32_t>(h);
     }
 
-    surface.stride = static_cast<uint32_t>(w);
-    surface.w = static_cast<uint32_t>(w);
-    surface.h = static_cast<uint32_t>(h);
+    surface.cs = bgra ? ColorSpace::ARGB8888 : ColorSpace::ABGR8888;
+    surface.stride = surface.w;
     surface.channelSize = sizeof(uint32_t);
     surface.premultiplied = true;
 
@@ -146,6 +149,20 @@ bool WebpLoader::read()
 }
 
 
+bool WebpLoader::hint(float w, float h)
+{
+    if (readied || w <= 0.0f || h <= 0.0f) return false;
+
+    //rescale to the desired size while decoding
+    auto s = std::min(w / this->w, h / this->h);
+    if (s >= 1.0f) return false;
+
+    scaledW = std::max(1u, static_cast<uint32_t>(ceilf(this->w * s)));
+    scaledH = std::max(1u, static_cast<uint32_t>(ceilf(this->h * s)));
+    return true;
+}
+
+
 bool WebpLoader::close()
 {
     if (!LoadModule::close()) return false;
@@ -154,6 +171,14 @@ bool WebpLoader::close()
 }
 
 
+char* WebpLoader::handover()
+{
+    if (!freeData) return nullptr;
+    freeData = false;
+    return (char*) data;
+}
+
+
 RenderSurface* WebpLoader::bitmap()
 {
     this->done();
@@ -28,6 +28,7 @@ class WebpLoader : public ImageLoader, public Task
 private:
     uint8_t* data = nullptr;
     uint32_t size = 0;
+    uint32_t scaledW = 0, scaledH = 0;  //the downscaled decoding size if any
     bool freeData = false;
 
     void clear();
@@ -41,6 +42,8 @@ public:
     bool open(const char* data, uint32_t size, const char* rpath, bool copy) override;
     bool read() override;
     bool close() override;
+    bool hint(float w, float h) override;
+    char* handover() override;
 
     RenderSurface* bitmap() override;
 };
@@ -57,6 +57,13 @@ WEBP_EXTERN(uint8_t*) WebPDecodeRGBA(const uint8_t* data, size_t data_size,
 WEBP_EXTERN(uint8_t*) WebPDecodeBGRA(const uint8_t* data, size_t data_size,
                                      int* width, int* height);
 
+// Same as WebPDecodeRGBA and WebPDecodeBGRA, but the samples are downscaled
+// to 'width' x 'height' by the rescaler while decoding.
+WEBP_EXTERN(uint8_t*) WebPDecodeScaledRGBA(const uint8_t* data, size_t data_size,
+                                           int width, int height);
+WEBP_EXTERN(uint8_t*) WebPDecodeScaledBGRA(const uint8_t* data, size_t data_size,
+                                           int width, int height);
+
 
 //------------------------------------------------------------------------------
 // Output colorspaces and buffer
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+
+#include "tvgLock.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define SW_GLYPH_BUCKETS 1024                     //must be power of 2
+#define SW_GLYPH_SUBPIXEL 4                       //subpixel positions per pixel
+#define SW_GLYPH_SCALE_STEPS 256                  //size buckets per octave, the glyph size deviates 0.14% at most
+#define SW_GLYPH_MAX_SIZE 48                      //larger glyphs than this (pixels) are drawn by the vector path
+#define SW_GLYPH_BUDGET (4 * 1024 * 1024)         //memory limit of the cache in bytes
+
+struct SwGlyph
+{
+    SwGlyph* next;          //hash chain
+    SwGlyph* prev;          //lru list, the most recently used first
+    SwGlyph* after;
+    uint64_t key;           //font | glyph id
+    int32_t level;          //size bucket
+    uint32_t size;          //memory usage in bytes
+    uint32_t ref;           //in use by the renderers, it can't be evicted.
+    uint8_t sx, sy;         //subpixel offset
+    FillRule rule;
+    SwPoint origin;         //coverage position from the pen in pixels
+    SwRle* rle;             //8-bit coverage spans relative to the origin, null if nothing to draw
+};
+
+
+struct SwGlyphPlace
+{
+    SwGlyph* glyph;
+    SwPoint pos;
+    const SwSpan* span;
+    const SwSpan* end;
+};
+
+
+static struct
+{
+    Key key;
+    SwGlyph* buckets[SW_GLYPH_BUCKETS] = {};
+    SwGlyph* head = nullptr;
+    SwGlyph* tail = nullptr;
+    uint32_t size = 0;
+} _cache;
+
+
+static void _free(SwGlyph* glyph)
+{
+    rleFree(glyph->rle);
+    tvg::free(glyph);
+}
+
+
+static bool _match(const SwGlyph* glyph, uint64_t key, int32_t level, uint8_t sx, uint8_t sy, FillRule rule)
+{
+    return glyph->key == key && glyph->level == level && glyph->sx == sx && glyph->sy == sy && glyph->rule == rule;
+}
+
+
+static uint32_t _hash(uint64_t key, int32_t level, uint8_t sx, uint8_t sy)
+{
+    auto hash = uint32_t(key ^ (key >> 32)) * 2654435761U;
+    hash ^= uint32_t(level) * 2246822519U;
+    hash ^= (uint32_t(sx) << 8) | sy;
+    return (hash ^ (hash >> 16)) & (SW_GLYPH_BUCKETS - 1);
+}
+
+
+static void _unlink(SwGlyph* glyph)
+{
+    if (glyph->prev) glyph->prev->after = glyph->after;
+    else _cache.head = glyph->after;
+    if (glyph->after) glyph->after->prev = glyph->prev;
+    else _cache.tail = glyph->prev;
+    glyph->prev = glyph->after = nullptr;
+}
+
+
+static void _touch(SwGlyph* glyph)
+{
+    if (_cache.head == glyph) return;
+    if (glyph->prev || glyph->after || _cache.tail == glyph) _unlink(glyph);
+    glyph->after = _cache.head;
+    if (_cache.head) _cache.head->prev = glyph;
+    _cache.head = glyph;
+    if (!_cache.tail) _cache.tail = glyph;
+}
+
+
+//evict the least recently used glyphs which are not in use to make a room of the size
+static bool _evict(uint32_t size)
+{
+    auto p = _cache.tail;
+    while (p && _cache.size + size > SW_GLYPH_BUDGET) {
+        auto prev = p->prev;
+        if (p->ref == 0) {
+            auto bucket = &_cache.buckets[_hash(p->key, p->level, p->sx, p->sy)];
+            while (*bucket != p) bucket = &(*bucket)->next;
+            *bucket = p->next;
+            _unlink(p);
+            _cache.size -= p->size;
+            _free(p);
+        }
+        p = prev;
+    }
+    return _cache.size + size <= SW_GLYPH_BUDGET;
+}
+
+
+static SwGlyph* _rasterize(const RenderPath& path, const RenderGlyph& info, uint32_t cmdIdx, uint32_t ptsIdx, int32_t level, uint8_t sx, uint8_t sy, FillRule rule, SwMpool* mpool, unsigned tid)
+{
+    //the representative scale of the size bucket
+    auto scale = exp2f(float(level) / SW_GLYPH_SCALE_STEPS);
+
+    //glyph outline at the pen position with the subpixel offset
+    Matrix m = {scale, 0.0f, float(sx) / SW_GLYPH_SUBPIXEL - scale * info.offset.x, 0.0f, scale, float(sy) / SW_GLYPH_SUBPIXEL - scale * info.offset.y, 0.0f, 0.0f, 1.0f};
+
+    auto outline = mpoolReqOutline(mpool, tid);
+    shapeGenOutline(outline, path.cmds.data + cmdIdx, info.cmds, path.pts.data + ptsIdx, m);
+    outline->fillRule = rule;
+
+    auto glyph = tvg::calloc<SwGlyph*>(1, sizeof(SwGlyph));
+    glyph->key = info.key;
+    glyph->level = level;
+    glyph->sx = sx;
+    glyph->sy = sy;
+    glyph->rule = rule;
+
+    RenderRegion bbox;
+    if (mathUpdateOutlineBBox(outline, {{-INT16_MAX, -INT16_MAX}, {INT16_MAX, INT16_MAX}}, bbox, false)) {
+        if (bbox.w() > SW_GLYPH_MAX_SIZE * 2 || bbox.h() > SW_GLYPH_MAX_SIZE) {
+            mpoolRetOutline(mpool, tid);
+            tvg::free(glyph);
+            return nullptr;
+        }
+        //move the coverage to the positive side, the shift is pixel aligned so it doesn't alter the coverage.
+        glyph->origin = {bbox.min.x, bbox.min.y};
+        SwPoint shift = {bbox.min.x * 64, bbox.min.y * 64};
+        ARRAY_FOREACH(p, outline->pts) *p -= shift;
+        glyph->rle = rleRender(nullptr, outline, {{0, 0}, {bbox.sw(), bbox.sh()}}, true);
+        if (glyph->rle && glyph->rle->invalid()) {
+            rleFree(glyph->rle);
+            glyph->rle = nullptr;
+        }
+    }
+
+    mpoolRetOutline(mpool, tid);
+    return glyph;
+}
+
+
+//the glyph is pinned in the cache until it's released, or it's a transient one if the cache is full of the pinned glyphs.
+static SwGlyph* _glyph(const RenderPath& path, const RenderGlyph& info, uint32_t cmdIdx, uint32_t ptsIdx, int32_t level, uint8_t sx, uint8_t sy, FillRule rule, SwMpool* mpool, unsigned tid, Array<SwGlyph*>& pinned, Array<SwGlyph*>& transients)
+{
+    auto idx = _hash(info.key, level, sx, sy);
+
+    {
+        ScopedLock lock(_cache.key);
+        for (auto p = _cache.buckets[idx]; p; p = p->next) {
+            if (_match(p, info.key, level, sx, sy, rule)) {
+                ++p->ref;
+                _touch(p);
+                pinned.push(p);
+                return p;
+            }
+        }
+    }
+
+    auto glyph = _rasterize(path, info, cmdIdx, ptsIdx, level, sx, sy, rule, mpool, tid);
+    if (!glyph) return nullptr;
+
+    ScopedLock lock(_cache.key);
+
+    //another worker might have made it in the meantime
+    for (auto p = _cache.buckets[idx]; p; p = p->next) {
+        if (_match(p, info.key, level, sx, sy, rule)) {
+            _free(glyph);
+            ++p->ref;
+            _touch(p);
+            pinned.push(p);
+            return p;
+        }
+    }
+
+    glyph->size = sizeof(SwGlyph) + (glyph->rle ? glyph->rle->spans.reserved * sizeof(SwSpan) : 0);
+
+    //no more room, use it only this time.
+    if (!_evict(glyph->size)) {
+        transients.push(glyph);
+        return glyph;
+    }
+
+    _cache.size += glyph->size;
+    glyph->next = _cache.buckets[idx];
+    glyph->ref = 1;
+    _cache.buckets[idx] = glyph;
+    _touch(glyph);
+    pinned.push(glyph);
+    return glyph;
+}
+
+
+//merge the glyph coverages in the scanline order
+static bool _compose(SwRle* rle, Array<SwGlyphPlace>& places, int32_t minY, int32_t maxY, const RenderRegion& clipBox, RenderRegion& renderBox)
+{
+    renderBox = {{INT32_MAX, INT32_MAX}, {INT32_MIN, INT32_MIN}};
+
+    auto begin = std::max(minY, clipBox.min.y);
+    auto end = std::min(maxY, clipBox.max.y - 1);
+
+    for (auto y = begin; y <= end; ++y) {
+        auto last = INT32_MIN;
+        ARRAY_FOREACH(p, places) {
+            while (p->span < p->end && p->span->y + p->pos.y < y) ++p->span;
+            while (p->span < p->end && p->span->y + p->pos.y == y) {
+                auto x1 = std::max(p->span->x + p->pos.x, clipBox.min.x);
+                auto x2 = std::min(p->span->x + p->pos.x + p->span->len, clipBox.max.x);
+                if (x1 < x2) {
+                    //overlapped glyphs need the coverage accumulation, leave it to the vector path.
+                    if (x1 < last) return false;
+                    rle->spans.push({uint16_t(x1), uint16_t(y), uint16_t(x2 - x1), p->span->coverage});
+                    last = x2;
+                    if (x1 < renderBox.min.x) renderBox.min.x = x1;
+                    if (x2 > renderBox.max.x) renderBox.max.x = x2;
+                    if (y < renderBox.min.y) renderBox.min.y = y;
+                    renderBox.max.y = y + 1;
+                }
+                ++p->span;
+            }
+        }
+    }
+    return rle->valid();
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool glyphGenRle(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid)
+{
+    auto& glyphs = rshape->glyphs;
+    if (glyphs.empty() || rshape->trimpath()) return false;
+
+    //only axis-aligned uniform scaling keeps the glyph coverages reusable. (no rotation, skew, italic)
+    if (!tvg::zero(transform.e12) || !tvg::zero(transform.e21) || transform.e11 <= 0.0f || !tvg::equal(transform.e11, transform.e22)) return false;
+
+    //the glyph layout must describe the whole path
+    uint32_t cmdCnt = 0, ptsCnt = 0;
+    ARRAY_FOREACH(p, glyphs) {
+        cmdCnt += p->cmds;
+        ptsCnt += p->pts;
+    }
+    if (cmdCnt != rshape->path.cmds.count || ptsCnt != rshape->path.pts.count) return false;
+
+    auto scale = transform.e11;
+    auto level = int32_t(nearbyintf(log2f(scale) * SW_GLYPH_SCALE_STEPS));
+    Array<SwGlyphPlace> places;
+    Array<SwGlyph*> pinned, transients;
+    places.reserve(glyphs.count);
+
+    auto minY = INT32_MAX;
+    auto maxY = INT32_MIN;
+    auto ret = true;
+    uint32_t cmdIdx = 0, ptsIdx = 0;
+
+    ARRAY_FOREACH(p, glyphs) {
+        //pen position in pixels, split into the integer and the subpixel parts.
+        auto x = scale * p->offset.x + transform.e13;
+        auto y = scale * p->offset.y + transform.e23;
+        auto ix = floorf(x);
+        auto iy = floorf(y);
+        auto sx = int32_t(nearbyintf((x - ix) * SW_GLYPH_SUBPIXEL));
+        auto sy = int32_t(nearbyintf((y - iy) * SW_GLYPH_SUBPIXEL));
+        if (sx == SW_GLYPH_SUBPIXEL) {
+            sx = 0;
+            ix += 1.0f;
+        }
+        if (sy == SW_GLYPH_SUBPIXEL) {
+            sy = 0;
+            iy += 1.0f;
+        }
+
+        auto glyph = _glyph(rshape->path, *p, cmdIdx, ptsIdx, level, uint8_t(sx), uint8_t(sy), rshape->rule, mpool, tid, pinned, transients);
+        cmdIdx += p->cmds;
+        ptsIdx += p->pts;
+
+        if (!glyph) {
+            ret = false;
+            break;
+        }
+        if (!glyph->rle) continue;
+
+        SwPoint pos = {int32_t(ix) + glyph->origin.x, int32_t(iy) + glyph->origin.y};
+        places.push({glyph, pos, glyph->rle->spans.begin(), glyph->rle->spans.end()});
+        minY = std::min(minY, pos.y + glyph->rle->spans.first().y);
+        maxY = std::max(maxY, pos.y + glyph->rle->spans.last().y);
+    }
+
+    if (ret && !places.empty()) {
+        if (!shape->rle) shape->rle = new SwRle;
+        ret = _compose(shape->rle, places, minY, maxY, clipBox, renderBox);
+        if (ret) {
+            shape->bbox = renderBox;
+            shape->fastTrack = false;
+        } else rleReset(shape->rle);
+    } else ret = false;
+
+    ARRAY_FOREACH(p, transients) _free(*p);
+
+    if (!pinned.empty()) {
+        ScopedLock lock(_cache.key);
+        ARRAY_FOREACH(p, pinned) --(*p)->ref;
+    }
+
+    return ret;
+}
+
+
+void glyphTerm()
+{
+    ScopedLock lock(_cache.key);
+
+    for (int i = 0; i < SW_GLYPH_BUCKETS; ++i) {
+        auto p = _cache.buckets[i];
+        while (p) {
+            auto next = p->next;
+            _free(p);
+            p = next;
+        }
+        _cache.buckets[i] = nullptr;
+    }
+    _cache.head = _cache.tail = nullptr;
+    _cache.size = 0;
+}
+
+#else
+
+bool glyphGenRle(TVG_UNUSED SwShape* shape, TVG_UNUSED const RenderShape* rshape, TVG_UNUSED const Matrix& transform, TVG_UNUSED const RenderRegion& clipBox, TVG_UNUSED RenderRegion& renderBox, TVG_UNUSED SwMpool* mpool, TVG_UNUSED unsigned tid)
+{
+    return false;
+}
+
+
+void glyphTerm()
+{
+}
+
+#endif //THORVG_SW_GLYPH_CACHE_SUPPORT
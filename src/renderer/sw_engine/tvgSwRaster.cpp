@@ -666,6 +666,71 @@ static bool _rasterRle(SwSurface* surface, SwRle* rle, const RenderRegion& bbox,
 }
 
 
+#ifdef THORVG_SW_MIPMAP_SUPPORT
+
+//2x2 Mean Kernel, the odd edges are clamped.
+static RenderSurface* _halve(const RenderSurface* surface)
+{
+    auto w = (surface->w + 1) / 2;
+    auto h = (surface->h + 1) / 2;
+
+    auto mipmap = new RenderSurface;
+    mipmap->buf32 = tvg::malloc<uint32_t*>(sizeof(uint32_t) * w * h);
+    if (!mipmap->buf32) {
+        delete(mipmap);
+        return nullptr;
+    }
+    mipmap->stride = mipmap->w = w;
+    mipmap->h = h;
+    mipmap->cs = surface->cs;
+    mipmap->channelSize = surface->channelSize;
+    mipmap->premultiplied = surface->premultiplied;
+
+    auto dst = mipmap->buf32;
+    for (uint32_t y = 0; y < h; ++y) {
+        auto src1 = surface->buf32 + (y * 2) * surface->stride;
+        auto src2 = (y * 2 + 1 < surface->h) ? (src1 + surface->stride) : src1;
+        for (uint32_t x = 0; x < w; ++x, ++dst) {
+            auto x1 = x * 2;
+            auto x2 = (x1 + 1 < surface->w) ? (x1 + 1) : x1;
+            //two channels per a lane, the sum of the four fits in 10 bits.
+            auto rb = (src1[x1] & 0x00ff00ff) + (src1[x2] & 0x00ff00ff) + (src2[x1] & 0x00ff00ff) + (src2[x2] & 0x00ff00ff) + 0x00020002;
+            auto ag = ((src1[x1] >> 8) & 0x00ff00ff) + ((src1[x2] >> 8) & 0x00ff00ff) + ((src2[x1] >> 8) & 0x00ff00ff) + ((src2[x2] >> 8) & 0x00ff00ff) + 0x00020002;
+            *dst = ((rb >> 2) & 0x00ff00ff) | (((ag >> 2) & 0x00ff00ff) << 8);
+        }
+    }
+    return mipmap;
+}
+
+#endif
+
+
+//Replace the image with its nearest mip level, the inverse transform is mapped to the level space.
+static const SwImage& _mipmap(const SwImage& image, Matrix& itransform, SwImage& level)
+{
+    if (!image.mipmap) return image;
+
+    auto factor = float(1 << image.level);
+    auto inv = 1.0f / factor;
+
+    itransform.e11 *= inv;
+    itransform.e12 *= inv;
+    itransform.e13 *= inv;
+    itransform.e21 *= inv;
+    itransform.e22 *= inv;
+    itransform.e23 *= inv;
+
+    level = image;
+    level.data = image.mipmap->data;
+    level.w = image.mipmap->w;
+    level.h = image.mipmap->h;
+    level.stride = image.mipmap->stride;
+    level.scale = image.scale * factor;
+
+    return level;
+}
+
+
 /************************************************************************/
 /* RLE Scaled Image                                                     */
 /************************************************************************/
@@ -1580,13 +1645,16 @@ bool rasterScaledImage(SwSurface* surface, const SwImage& image, const Matrix& t
 
     if (!inverse(&transform, &itransform)) return true;
 
+    SwImage level;
+    auto& src = _mipmap(image, itransform, level);
+
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterScaledMattedImage(surface, image, &itransform, bbox, opacity);
-        else return _rasterScaledMaskedImage(surface, image, &itransform, bbox, opacity);
+        if (_matting(surface)) return _rasterScaledMattedImage(surface, src, &itransform, bbox, opacity);
+        else return _rasterScaledMaskedImage(surface, src, &itransform, bbox, opacity);
     } else if (_blending(surface)) {
-        return _rasterScaledBlendingImage(surface, image, &itransform, bbox, opacity);
+        return _rasterScaledBlendingImage(surface, src, &itransform, bbox, opacity);
     } else {
-        return _rasterScaledImage(surface, image, &itransform, bbox, opacity);
+        return _rasterScaledImage(surface, src, &itransform, bbox, opacity);
     }
     return false;
 }
@@ -1623,13 +1691,16 @@ bool rasterScaledRleImage(SwSurface* surface, const SwImage& image, const Matrix
 
     if (!inverse(&transform, &itransform)) return true;
 
+    SwImage level;
+    auto& src = _mipmap(image, itransform, level);
+
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterScaledMattedRleImage(surface, image, &itransform, bbox, opacity);
-        else return _rasterScaledMaskedRleImage(surface, image, &itransform, bbox, opacity);
+        if (_matting(surface)) return _rasterScaledMattedRleImage(surface, src, &itransform, bbox, opacity);
+        else return _rasterScaledMaskedRleImage(surface, src, &itransform, bbox, opacity);
     } else if (_blending(surface)) {
-        return _rasterScaledBlendingRleImage(surface, image, &itransform, bbox, opacity);
+        return _rasterScaledBlendingRleImage(surface, src, &itransform, bbox, opacity);
     } else {
-        return _rasterScaledRleImage(surface, image, &itransform, bbox, opacity);
+        return _rasterScaledRleImage(surface, src, &itransform, bbox, opacity);
     }
     return false;
 }
@@ -1725,17 +1796,60 @@ bool rasterConvertCS(RenderSurface* surface, ColorSpace to)
     auto from = surface->cs;
 
     if (((from == ColorSpace::ABGR8888) || (from == ColorSpace::ABGR8888S)) && ((to == ColorSpace::ARGB8888) || (to == ColorSpace::ARGB8888S))) {
-        surface->cs = to;
-        return cRasterABGRtoARGB(surface);
+        for (auto s = surface; s; s = s->mipmap) {
+            s->cs = to;
+            cRasterABGRtoARGB(s);
+        }
+        return true;
     }
     if (((from == ColorSpace::ARGB8888) || (from == ColorSpace::ARGB8888S)) && ((to == ColorSpace::ABGR8888) || (to == ColorSpace::ABGR8888S))) {
-        surface->cs = to;
-        return cRasterARGBtoABGR(surface);
+        for (auto s = surface; s; s = s->mipmap) {
+            s->cs = to;
+            cRasterARGBtoABGR(s);
+        }
+        return true;
     }
     return false;
 }
 
 
+bool rasterMipmap(SwImage* image, RenderSurface* surface)
+{
+    image->mipmap = nullptr;
+    image->level = 0;
+
+#ifdef THORVG_SW_MIPMAP_SUPPORT
+    //the user pixels could be changed behind, the derived levels can't be trusted.
+    if (!image->scaled || image->scale >= DOWN_SCALE_TOLERANCE || surface->shared || surface->channelSize != sizeof(uint32_t)) return false;
+
+    ScopedLock lock(surface->key);
+
+    //the nearest level which is still not smaller than the drawing size
+    auto scale = image->scale;
+    auto level = surface;
+    uint8_t depth = 0;
+
+    while (scale < DOWN_SCALE_TOLERANCE && (level->w > 1 || level->h > 1)) {
+        if (!level->mipmap) {
+            TVGLOG("SW_ENGINE", "Mipmap [Level: %d, Size: %d x %d]", depth + 1, (level->w + 1) / 2, (level->h + 1) / 2);
+            if (!(level->mipmap = _halve(level))) break;
+        }
+        level = level->mipmap;
+        scale *= 2.0f;
+        ++depth;
+    }
+
+    if (depth == 0) return false;
+
+    image->mipmap = level;
+    image->level = depth;
+    return true;
+#else
+    return false;
+#endif
+}
+
+
 //TODO: SIMD OPTIMIZATION?
 void rasterXYFlip(uint32_t* src, uint32_t* dst, int32_t stride, int32_t w, int32_t h, const RenderRegion& bbox, bool flipped)
 {
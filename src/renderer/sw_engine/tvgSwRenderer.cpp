@@ -36,6 +36,23 @@ static atomic<int32_t> rendererCnt{-1};
 static SwMpool* globalMpool = nullptr;
 static uint32_t threadsCnt = 0;
 
+#ifdef THORVG_PROFILER_SUPPORT
+//the pixels of the rle spans within the region
+static uint64_t _pixels(const SwRle* rle, const RenderRegion& bbox)
+{
+    if (!rle || rle->invalid()) return 0;
+
+    uint64_t pixels = 0;
+    const SwSpan* end;
+    int32_t x, len;
+
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (span->fetch(bbox, x, len)) pixels += len;
+    }
+    return pixels;
+}
+#endif
+
 struct SwTask : Task
 {
     SwSurface* surface = nullptr;
@@ -110,6 +127,8 @@ struct SwShapeTask : SwTask
 
     void run(unsigned tid) override
     {
+        TVG_PROFILE("SwShapeTask::run");
+
         //invisible
         if (opacity == 0 && !clipper) {
             if (flags & RenderUpdateFlag::Color) invisible();
@@ -125,11 +144,14 @@ struct SwShapeTask : SwTask
         if (updateShape || updateFill) {
             if (updateShape) shapeReset(&shape);
             if (!shape.rle || shape.rle->invalid()) {
-                if (shapePrepare(&shape, rshape, transform, curBox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
-                    if (!shapeGenRle(&shape, rshape, antialiasing(strokeWidth))) goto err;
-                } else {
-                    updateFill = false;
-                    renderBox.reset();
+                //small texts could be composed of the cached glyph coverages.
+                if (!glyphGenRle(&shape, rshape, transform, curBox, renderBox, mpool, tid)) {
+                    if (shapePrepare(&shape, rshape, transform, curBox, renderBox, mpool, tid, clips.count > 0 ? true : false)) {
+                        if (!shapeGenRle(&shape, rshape, antialiasing(strokeWidth))) goto err;
+                    } else {
+                        updateFill = false;
+                        renderBox.reset();
+                    }
                 }
             }
         }
@@ -199,6 +221,8 @@ struct SwImageTask : SwTask
 
     void run(unsigned tid) override
     {
+        TVG_PROFILE("SwImageTask::run");
+
         //invisible
         if (opacity == 0) {
             if (flags & RenderUpdateFlag::Color) invisible();
@@ -225,6 +249,7 @@ struct SwImageTask : SwTask
             if (updateImage) imageReset(&image);
             if (!image.data || image.w == 0 || image.h == 0) goto err;
             if (!imagePrepare(&image, transform, clipBox, curBox, mpool, tid)) goto err;
+            if (updateImage) rasterMipmap(&image, source);
             valid = true;
             if (clips.count > 0) {
                 if (!imageGenRle(&image, curBox, false)) goto err;
@@ -419,6 +444,9 @@ bool SwRenderer::renderImage(RenderData data)
         auto raster = [&](SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity) {
             if (bbox.invalid() || bbox.x() >= surface->w || bbox.y() >= surface->h) return true;
 
+            TVG_PROFILE("rasterImage");
+            TVG_PROFILE_COUNT(Pixels, (image.rle && image.rle->valid()) ? _pixels(image.rle, bbox) : uint64_t(bbox.w()) * bbox.h());
+
             //RLE Image
             if (image.rle && image.rle->valid()) {
                 if (image.direct) return rasterDirectRleImage(surface, image, bbox, opacity);
@@ -470,6 +498,8 @@ bool SwRenderer::renderShape(RenderData data)
 
     if (task->valid) {
         auto fill = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& bbox) {
+            TVG_PROFILE("rasterShape");
+            TVG_PROFILE_COUNT(Pixels, task->shape.fastTrack ? uint64_t(bbox.w()) * bbox.h() : _pixels(task->shape.rle, bbox));
             if (auto fill = task->rshape->fill) {
                 rasterGradientShape(surface, &task->shape, bbox, fill, task->opacity);
             } else {
@@ -481,6 +511,8 @@ bool SwRenderer::renderShape(RenderData data)
         };
 
         auto stroke = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& bbox) {
+            TVG_PROFILE("rasterStroke");
+            TVG_PROFILE_COUNT(Pixels, _pixels(task->shape.strokeRle, bbox));
             if (auto strokeFill = task->rshape->strokeFill()) {
                 rasterGradientStroke(surface, &task->shape, bbox, strokeFill, task->opacity);
             } else {
@@ -653,6 +685,8 @@ SwSurface* SwRenderer::request(int channelSize, bool square)
         cmp->channelSize = cmp->compositor->image.channelSize = channelSize;
 
         compositors.push(cmp);
+
+        TVG_PROFILE_COUNT(Surfaces, 1);
     }
 
     //Sync. This may have been modified by post-processing.
@@ -664,6 +698,8 @@ SwSurface* SwRenderer::request(int channelSize, bool square)
 
 RenderCompositor* SwRenderer::target(const RenderRegion& region, ColorSpace cs, CompositionFlag flags)
 {
+    TVG_PROFILE("SwRenderer::target");
+
     auto bbox = RenderRegion::intersect(region, {{0, 0}, {int32_t(surface->w), int32_t(surface->h)}});
     if (bbox.invalid()) return nullptr;
 
@@ -688,6 +724,8 @@ bool SwRenderer::endComposite(RenderCompositor* cmp)
 {
     if (!cmp) return false;
 
+    TVG_PROFILE("SwRenderer::endComposite");
+
     auto p = static_cast<SwCompositor*>(cmp);
 
     //Recover Context
@@ -787,6 +825,8 @@ bool SwRenderer::region(RenderEffect* effect)
 
 bool SwRenderer::render(RenderCompositor* cmp, const RenderEffect* effect, bool direct)
 {
+    TVG_PROFILE("SwRenderer::effect");
+
     auto p = static_cast<SwCompositor*>(cmp);
 
     if (p->image.channelSize != sizeof(uint32_t)) {
@@ -913,6 +953,7 @@ bool SwRenderer::term()
 
     mpoolTerm(globalMpool);
     globalMpool = nullptr;
+    glyphTerm();
     rendererCnt = -1;
 
     return true;
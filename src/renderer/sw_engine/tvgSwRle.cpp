@@ -839,6 +839,8 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
     if (rw.bandShoot > 8 && rw.bandSize > 16) {
         rw.bandSize = (rw.bandSize >> 1);
     }
+    TVG_PROFILE_COUNT(Spans, rw.rle->spans.count);
+
     return rw.rle;
 }
 
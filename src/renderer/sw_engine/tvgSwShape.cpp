@@ -387,6 +387,24 @@ static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const M
     if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
 
     auto outline = mpoolReqOutline(mpool, tid);
+    shapeGenOutline(outline, cmds, cmdCnt, pts, transform);
+
+    outline->fillRule = rshape->rule;
+
+    tvg::free(trimmedCmds);
+    tvg::free(trimmedPts);
+
+    shape->fastTrack = (!hasComposite && _axisAlignedRect(outline));
+    return outline;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void shapeGenOutline(SwOutline* outline, const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, const Matrix& transform)
+{
     auto closed = false;
 
     //Generate Outlines
@@ -418,21 +436,9 @@ static SwOutline* _genOutline(SwShape* shape, const RenderShape* rshape, const M
     }
 
     if (!closed) _outlineEnd(*outline);
-
-    outline->fillRule = rshape->rule;
-
-    tvg::free(trimmedCmds);
-    tvg::free(trimmedPts);
-
-    shape->fastTrack = (!hasComposite && _axisAlignedRect(outline));
-    return outline;
 }
 
 
-/************************************************************************/
-/* External Class Implementation                                        */
-/************************************************************************/
-
 bool shapePrepare(SwShape* shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool hasComposite)
 {
     if (auto out = _genOutline(shape, rshape, transform, mpool, tid, hasComposite, rshape->trimpath())) shape->outline = out;
@@ -24,6 +24,8 @@
 #define _TVG_CANVAS_H_
 
 #include "tvgPaint.h"
+#include "tvgLoader.h"
+#include "tvgProfiler.h"
 
 enum Status : uint8_t {Synced = 0, Painting, Updating, Drawing, Damaged};
 
@@ -33,6 +35,7 @@ struct Canvas::Impl
     RenderMethod* renderer;
     RenderRegion vport = {{0, 0}, {INT32_MAX, INT32_MAX}};
     Status status = Status::Synced;
+    bool framing = false;       //a frame is in progress from the update to the sync
 
     Impl() : scene(Scene::gen())
     {
@@ -43,6 +46,7 @@ struct Canvas::Impl
     {
         //make it sure any deferred jobs
         renderer->sync();
+        if (framing) LoaderMgr::end();
         scene->unref();
         if (renderer->unref() == 0) delete(renderer);
     }
@@ -72,6 +76,8 @@ struct Canvas::Impl
     {
         if (status == Status::Updating) return Result::Success;
 
+        TVG_PROFILE("Canvas::update");
+
         if (status == Status::Drawing) {
             TVGLOG("RENDERER", "update() was called during drawing.");
             return Result::InsufficientCondition;
@@ -85,6 +91,12 @@ struct Canvas::Impl
 
         if (!renderer->preUpdate()) return Result::InsufficientCondition;
 
+        //the images in use must be kept until the sync
+        if (!framing) {
+            LoaderMgr::begin();
+            framing = true;
+        }
+
         auto m = tvg::identity();
         PAINT(scene)->update(renderer, m, clips, 255, flag);
 
@@ -96,6 +108,8 @@ struct Canvas::Impl
 
     Result draw(bool clear)
     {
+        TVG_PROFILE("Canvas::draw");
+
         if (status == Status::Drawing) {
             TVGLOG("RENDERER", "draw() was called multiple times.");
             return Result::InsufficientCondition;
@@ -116,6 +130,11 @@ struct Canvas::Impl
         if (status == Status::Synced) return Result::Success;
         if (renderer->sync()) {
             status = Status::Synced;
+            if (framing) {
+                LoaderMgr::end();
+                framing = false;
+            }
+            TVG_PROFILE_FRAME();
             return Result::Success;
         }
         return Result::Unknown;
@@ -23,6 +23,7 @@
 #include "tvgCommon.h"
 #include "tvgTaskScheduler.h"
 #include "tvgLoader.h"
+#include "tvgProfiler.h"
 
 #ifdef THORVG_SW_RASTER_SUPPORT
     #include "tvgSwRenderer.h"
@@ -90,6 +91,10 @@ Result Initializer::init(uint32_t threads) noexcept
 
     TaskScheduler::init(threads);
 
+    #ifdef THORVG_PROFILER_SUPPORT
+        Profiler::init();
+    #endif
+
     return Result::Success;
 }
 
@@ -112,6 +117,10 @@ Result Initializer::term() noexcept
         if (!WgRenderer::term()) return Result::InsufficientCondition;
     #endif
 
+    #ifdef THORVG_PROFILER_SUPPORT
+        Profiler::term();
+    #endif
+
     TaskScheduler::term();
 
     if (!LoaderMgr::term()) return Result::Unknown;
@@ -120,6 +129,13 @@ Result Initializer::term() noexcept
 }
 
 
+Result Initializer::cache(uint64_t bytes) noexcept
+{
+    LoaderMgr::budget(static_cast<size_t>(bytes));
+    return Result::Success;
+}
+
+
 const char* Initializer::version(uint32_t* major, uint32_t* minor, uint32_t* micro) noexcept
 {
     if ((!major && ! minor && !micro) || _buildVersionInfo(major, minor, micro)) return THORVG_VERSION_STRING;
@@ -88,10 +88,30 @@ struct ImageLoader : LoadModule
     float w = 0, h = 0;                             //default image size
     RenderSurface surface;
 
+    //image cache states, managed by the LoaderMgr
+    char* source = nullptr;                         //the encoded data retained for the re-decoding
+    uint32_t sourceSize = 0;
+    uint64_t checksum = 0;                          //content hash of the source, zero until it's compared
+    float hw = 0, hh = 0;                           //the decoding size hint if it's applied
+    uint32_t stamp = 0;                             //the latest frame which the pixels were used
+    size_t bytes = 0;                               //the source and the pixels with their mip levels counted in the cache budget
+    uint32_t pins = 0;                              //the users accessing the pixels directly, it's not evictable while pinned
+    uint32_t generation = 0;                        //increased whenever the pixels are evicted
+    bool tracked = false;                           //the pixels are counted in the cache budget
+    bool evicted = false;
+
     ImageLoader(FileType type) : LoadModule(type) {}
 
+    ~ImageLoader()
+    {
+        tvg::free(source);
+    }
+
     virtual bool animatable() { return false; }  //true if this loader supports animation.
     virtual Paint* paint() { return nullptr; }
+    virtual void cull(Paint* paint, const Matrix& transform, const RenderRegion& vport) {}  //skip the parts of the paint out of the viewport if possible.
+    virtual bool hint(float w, float h) { return false; }  //the desired size before read(). true if the image will be decoded in a reduced size.
+    virtual char* handover() { return nullptr; }  //takes over the encoded data copied by the loader, it's freed with the loader.
 
     virtual RenderSurface* bitmap()
     {
@@ -108,6 +128,25 @@ struct FontMetrics
 };
 
 
+//The shaped glyphs of a text, kept by the text for the incremental relayout.
+//Each entry records the layout state after its codepoint is processed.
+struct FontRun
+{
+    struct Glyph
+    {
+        uint32_t codepoint;
+        uint32_t lglyph;                  //the last glyph id for the kerning
+        Point pen;                        //the pen position
+        uint32_t cmds, pts;               //the accumulated path sizes
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        uint32_t layout;                  //the accumulated glyph layout size
+#endif
+    };
+
+    Array<Glyph> glyphs;
+};
+
+
 struct FontLoader : LoadModule
 {
     char* name = nullptr;
@@ -116,7 +155,7 @@ struct FontLoader : LoadModule
 
     using LoadModule::read;
 
-    virtual bool read(Shape* shape, char* text, FontMetrics& out) = 0;
+    virtual bool read(Shape* shape, char* text, FontMetrics& out, FontRun& run) = 0;
     virtual float transform(Paint* paint, FontMetrics& mertrics, float fontSize, bool italic) = 0;
 };
 
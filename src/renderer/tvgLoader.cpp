@@ -68,6 +68,13 @@ atomic<ColorSpace> ImageLoader::cs{ColorSpace::ARGB8888};
 static Key _key;
 static Inlist<LoadModule> _activeLoaders;
 
+//image cache: the decoded images within a memory budget, the least recently used ones are evicted.
+static atomic<size_t> _budget{0};        //bytes, zero if the image cache is disabled
+static size_t _usage = 0;                 //bytes of the tracked images
+static uint32_t _frames = 0;              //the number of canvases in the middle of a frame
+static atomic<uint32_t> _clock{1};        //the current frame stamp
+static Array<ImageLoader*> _images;       //the tracked images
+
 
 static LoadModule* _find(FileType type)
 {
@@ -234,6 +241,152 @@ static LoadModule* _findFromCache(const char* data, uint32_t size, const char* m
 }
 
 
+//the decoded pixels could be dropped and decoded again from the source
+static bool _evictable(FileType type)
+{
+    return (type == FileType::Png || type == FileType::Jpg || type == FileType::Webp);
+}
+
+
+static uint64_t _checksum(const char* data, uint32_t size)
+{
+    uint64_t hash = 5381;
+    for (uint32_t i = 0; i < size; ++i) {
+        hash = ((hash << 5) + hash) + (uint8_t)data[i];
+    }
+    return hash;
+}
+
+
+//the images of the same size are the candidates, they are hashed only to confirm a possible hit.
+static LoadModule* _findFromCache(const char* data, uint32_t size)
+{
+    ScopedLock lock(_key);
+
+    uint64_t checksum = 0;
+
+    INLIST_FOREACH(_activeLoaders, loader) {
+        if (!_evictable(loader->type)) continue;
+        auto image = static_cast<ImageLoader*>(loader);
+        if (!image->source || image->sourceSize != size) continue;
+        if (checksum == 0) checksum = _checksum(data, size);
+        if (image->checksum == 0) image->checksum = _checksum(image->source, size);
+        //the checksum is not collision free, the contents must be the same.
+        if (image->checksum == checksum && !memcmp(image->source, data, size)) {
+            ++loader->sharing;
+            return loader;
+        }
+    }
+    return nullptr;
+}
+
+
+//keep the encoded data for the re-decoding, and share the loader with the same contents
+static void _retain(LoadModule* loader, const char* data, uint32_t size, bool copy)
+{
+    if (_budget == 0 || !_evictable(loader->type)) return;
+
+    //the copy of the loader is taken over, the borrowed data could be gone after the loading.
+    auto image = static_cast<ImageLoader*>(loader);
+    if (copy) image->source = image->handover();
+    else {
+        image->source = tvg::malloc<char*>(size);
+        if (image->source) memcpy(image->source, data, size);
+    }
+    if (!image->source) return;
+    image->sourceSize = size;
+
+    if (!loader->cached) {
+        loader->cached = true;
+        ScopedLock lock(_key);
+        _activeLoaders.back(loader);
+    }
+}
+
+
+//the loaders release the pixels in their own ways
+static void _exchange(RenderSurface& a, RenderSurface& b)
+{
+    std::swap(a.data, b.data);
+    std::swap(a.stride, b.stride);
+    std::swap(a.w, b.w);
+    std::swap(a.h, b.h);
+    std::swap(a.cs, b.cs);
+    std::swap(a.channelSize, b.channelSize);
+    std::swap(a.premultiplied, b.premultiplied);
+    std::swap(a.mipmap, b.mipmap);
+}
+
+
+//the retained source and the pixels with the mip levels derived by the renderer
+static size_t _bytes(ImageLoader* loader)
+{
+    auto bytes = size_t(loader->sourceSize);
+    //the renderer builds the mip levels under the surface lock
+    ScopedLock lock(loader->surface.key);
+    for (auto s = &loader->surface; s; s = s->mipmap) bytes += size_t(s->stride) * s->h * s->channelSize;
+    return bytes;
+}
+
+
+static void _account(ImageLoader* loader)
+{
+    auto bytes = _bytes(loader);
+    _usage += bytes - loader->bytes;
+    loader->bytes = bytes;
+}
+
+
+static void _untrack(ImageLoader* loader, uint32_t idx)
+{
+    _usage -= loader->bytes;
+    loader->bytes = 0;
+    _images[idx] = _images.last();
+    _images.pop();
+    loader->tracked = false;
+}
+
+
+static bool _evict(ImageLoader* loader)
+{
+    auto tmp = static_cast<ImageLoader*>(_find(loader->type));
+    if (!tmp) return false;
+
+    TVGLOG("LOADER", "Evict the image (%p) [Size: %d x %d]", loader, loader->surface.w, loader->surface.h);
+
+    _exchange(loader->surface, tmp->surface);
+    delete(tmp);
+
+    loader->evicted = true;
+    ++loader->generation;
+    return true;
+}
+
+
+static bool _redecode(ImageLoader* loader)
+{
+    auto tmp = static_cast<ImageLoader*>(_find(loader->type));
+    if (!tmp) return false;
+
+    TVGLOG("LOADER", "Decode the evicted image (%p) again", loader);
+
+    auto ret = false;
+    if (loader->source) ret = tmp->open(loader->source, loader->sourceSize, nullptr, false);
+    else if (loader->hashpath) ret = tmp->open(loader->hashpath);
+
+    if (ret) {
+        if (loader->hw > 0.0f && loader->hh > 0.0f) tmp->hint(loader->hw, loader->hh);
+        ret = tmp->read() && tmp->bitmap();
+    }
+    if (ret) {
+        _exchange(loader->surface, tmp->surface);
+        loader->evicted = false;
+    }
+    delete(tmp);
+    return ret;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -254,6 +407,16 @@ bool LoaderMgr::term()
         _activeLoaders.remove(loader);
         if (ret) delete(loader);
     }
+
+    //the images could be still alive, they are out of the budget now.
+    ARRAY_FOREACH(p, _images) {
+        (*p)->tracked = false;
+        (*p)->bytes = 0;
+    }
+    _images.reset();
+    _usage = 0;
+    _frames = 0;
+
     return true;
 }
 
@@ -266,12 +429,116 @@ bool LoaderMgr::retrieve(LoadModule* loader)
         if (loader->cached) {
             _activeLoaders.remove(loader);
         }
+        if (_evictable(loader->type) && static_cast<ImageLoader*>(loader)->tracked) {
+            ScopedLock lock(_key);
+            for (uint32_t i = 0; i < _images.count; ++i) {
+                if (_images[i] == loader) {
+                    _untrack(_images[i], i);
+                    break;
+                }
+            }
+        }
         delete(loader);
     }
     return true;
 }
 
 
+//the image cache budget in bytes, it's disabled with zero.
+void LoaderMgr::budget(size_t bytes)
+{
+    _budget = bytes;
+}
+
+
+//stop sharing the loader with the following loads of the same resource
+void LoaderMgr::uncache(LoadModule* loader)
+{
+    ScopedLock lock(_key);
+    if (!loader->cached) return;
+    _activeLoaders.remove(loader);
+    loader->cached = false;
+}
+
+
+//the decoded image, it's decoded again if the image cache has evicted it.
+RenderSurface* LoaderMgr::bitmap(ImageLoader* loader)
+{
+    auto surface = loader->bitmap();
+
+    if (!_evictable(loader->type) || (!loader->source && !loader->hashpath)) return surface;
+
+    //the image could be evicted before the budget is changed
+    if (!surface && loader->evicted) {
+        ScopedLock lock(loader->surface.key);
+        if (loader->evicted && _redecode(loader)) surface = loader->bitmap();
+    }
+
+    if (surface && _budget > 0) {
+        ScopedLock lock(_key);
+        if (!loader->tracked) {
+            _images.push(loader);
+            loader->tracked = true;
+        }
+        _account(loader);
+        loader->stamp = _clock;
+    }
+    return surface;
+}
+
+
+//the image is used in the current frame
+void LoaderMgr::touch(ImageLoader* loader)
+{
+    ScopedLock lock(_key);
+    loader->stamp = _clock;
+}
+
+
+//the pixels are directly accessed by the user, they must not be evicted.
+void LoaderMgr::pin(ImageLoader* loader, bool on)
+{
+    ScopedLock lock(_key);
+    if (on) ++loader->pins;
+    else if (loader->pins > 0) --loader->pins;
+}
+
+
+//a canvas starts a frame, the images must not be evicted until it's synced.
+void LoaderMgr::begin()
+{
+    ScopedLock lock(_key);
+    ++_frames;
+}
+
+
+//a canvas finished a frame, evict the images not used in the latest frame if they are over the budget.
+void LoaderMgr::end()
+{
+    ScopedLock lock(_key);
+
+    if (_frames > 0) --_frames;
+    if (_frames > 0 || _budget == 0) return;
+
+    auto clock = _clock++;
+
+    //the mip levels could be built in the frame
+    ARRAY_FOREACH(p, _images) _account(*p);
+
+    //the evicted images stay tracked with their sources until they are retrieved
+    while (_usage > _budget) {
+        uint32_t lru = UINT32_MAX;
+        for (uint32_t i = 0; i < _images.count; ++i) {
+            auto image = _images[i];
+            if (image->stamp == clock || image->evicted || image->pins > 0) continue;
+            if (lru == UINT32_MAX || image->stamp < _images[lru]->stamp) lru = i;
+        }
+        if (lru == UINT32_MAX || !_evict(_images[lru])) break;
+        _account(_images[lru]);
+    }
+}
+
+
 LoadModule* LoaderMgr::loader(const char* filename, bool* invalid)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
@@ -343,6 +610,11 @@ LoadModule* LoaderMgr::loader(const char* data, uint32_t size, const char* mimeT
         if (auto loader = _findFromCache(data, size, mimeType)) return loader;
     }
 
+    //the image cache shares the images by their contents regardless of the data pointers.
+    if (_budget > 0) {
+        if (auto loader = _findFromCache(data, size)) return loader;
+    }
+
     //Try with the given MimeType
     if (mimeType) {
         if (auto loader = _findByType(mimeType)) {
@@ -352,6 +624,7 @@ LoadModule* LoaderMgr::loader(const char* data, uint32_t size, const char* mimeT
                     ScopedLock lock(_key);
                     _activeLoaders.back(loader);
                 }
+                _retain(loader, data, size, copy);
                 return loader;
             } else {
                 TVGLOG("LOADER", "Given mimetype \"%s\" seems incorrect or not supported.", mimeType);
@@ -369,6 +642,7 @@ LoadModule* LoaderMgr::loader(const char* data, uint32_t size, const char* mimeT
                     ScopedLock lock(_key);
                     _activeLoaders.back(loader);
                 }
+                _retain(loader, data, size, copy);
                 return loader;
             }
             delete(loader);
@@ -37,6 +37,13 @@ struct LoaderMgr
     static LoadModule* anyfont();
     static bool retrieve(const char* filename);
     static bool retrieve(LoadModule* loader);
+    static void budget(size_t bytes);
+    static void uncache(LoadModule* loader);
+    static RenderSurface* bitmap(ImageLoader* loader);
+    static void touch(ImageLoader* loader);
+    static void pin(ImageLoader* loader, bool on);
+    static void begin();
+    static void end();
 };
 
 #endif //_TVG_LOADER_H_
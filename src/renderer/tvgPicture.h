@@ -64,7 +64,9 @@ struct PictureImpl : Picture
     Paint* vector = nullptr;          //vector picture uses
     RenderSurface* bitmap = nullptr;  //bitmap picture uses
     float w = 0, h = 0;
+    uint32_t generation = 0;          //the loader's pixel generation which the render data is prepared with
     bool resizing = false;
+    bool pinned = false;              //the pixels are exposed by data(), the image cache must keep them
 
     PictureImpl() : impl(Paint::Impl(this))
     {
@@ -72,12 +74,15 @@ struct PictureImpl : Picture
 
     ~PictureImpl()
     {
+        if (pinned) LoaderMgr::pin(loader, false);
         LoaderMgr::retrieve(loader);
         delete(vector);
     }
 
     bool skip(RenderUpdateFlag flag)
     {
+        //the pixels were evicted by the image cache, they must be prepared again.
+        if (bitmap && generation != loader->generation) return false;
         if (flag == RenderUpdateFlag::None) return true;
         return false;
     }
@@ -87,9 +92,13 @@ struct PictureImpl : Picture
         load();
 
         if (bitmap) {
+            if (generation != loader->generation) {
+                generation = loader->generation;
+                flag |= RenderUpdateFlag::Image;
+            }
             //Overriding Transformation by the desired image size
-            auto sx = w / loader->w;
-            auto sy = h / loader->h;
+            auto sx = w / bitmap->w;
+            auto sy = h / bitmap->h;
             auto scale = sx < sy ? sx : sy;
             auto m = transform * Matrix{scale, 0, 0, 0, scale, 0, 0, 0, 1};
             impl.rd = renderer->prepare(bitmap, impl.rd, m, clips, opacity, flag);
@@ -98,6 +107,7 @@ struct PictureImpl : Picture
                 loader->resize(vector, w, h);
                 resizing = false;
             }
+            loader->cull(vector, transform, renderer->viewport());
             needComposition(opacity);
             vector->blend(pImpl->blendMethod); //propagate blend method to nested vector scene
             return vector->pImpl->update(renderer, transform, clips, opacity, flag, false);
@@ -210,15 +220,22 @@ struct PictureImpl : Picture
         //Try it, If not loaded yet.
         load();
 
-        if (loader) {
+        if (bitmap) {
+            if (w) *w = bitmap->w;
+            if (h) *h = bitmap->h;
+        } else if (loader) {
             if (w) *w = static_cast<uint32_t>(loader->w);
             if (h) *h = static_cast<uint32_t>(loader->h);
         } else {
             if (w) *w = 0;
             if (h) *h = 0;
         }
-        if (bitmap) return bitmap->buf32;
-        else return nullptr;
+        if (!bitmap) return nullptr;
+        if (!pinned) {
+            LoaderMgr::pin(loader, true);
+            pinned = true;
+        }
+        return bitmap->buf32;
     }
 
     void load()
@@ -236,8 +253,8 @@ struct PictureImpl : Picture
                     loader->resize(vector, w, h);
                     resizing = false;
                 }
-            } else if (!bitmap) {
-                bitmap = loader->bitmap();
+            } else if (!bitmap || !bitmap->data) {
+                bitmap = LoaderMgr::bitmap(loader);
             }
         }
     }
@@ -261,6 +278,8 @@ struct PictureImpl : Picture
         auto ret = true;
 
         if (bitmap) {
+            //the image cache keeps the visible images only
+            if (!renderer->region(impl.rd).invalid()) LoaderMgr::touch(loader);
             renderer->blend(impl.blendMethod);
             return renderer->renderImage(impl.rd);
         } else if (vector) {
@@ -288,15 +307,26 @@ struct PictureImpl : Picture
             this->loader->sharing--;  //make it sure the reference counting.
             return Result::Success;
         } else if (this->loader) {
+            if (pinned) LoaderMgr::pin(this->loader, false);
+            pinned = false;
             LoaderMgr::retrieve(this->loader);
         }
 
         this->loader = loader;
 
+        //the size is given in advance, the image could be decoded in the reduced size.
+        if (resizing && loader->sharing == 0 && loader->hint(w, h)) {
+            loader->hw = w;
+            loader->hh = h;
+            LoaderMgr::uncache(loader);
+        }
+
         if (!loader->read()) return Result::Unknown;
 
-        this->w = loader->w;
-        this->h = loader->h;
+        if (!resizing) {
+            this->w = loader->w;
+            this->h = loader->h;
+        }
 
         impl.mark(RenderUpdateFlag::All);
 
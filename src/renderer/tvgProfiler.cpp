@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgProfiler.h"
+
+#ifdef THORVG_PROFILER_SUPPORT
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include "tvgArray.h"
+#include "tvgLock.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+struct ProfileEvent
+{
+    const char* name;
+    uint64_t begin, end;    //nanoseconds
+    uint32_t tid;
+};
+
+static const char* counterNames[] = {"spans", "pixels", "surfaces", "tasks"};
+
+bool Profiler::tracing = false;
+
+static FILE* trace = nullptr;
+static Key key;
+static Array<ProfileEvent> events;
+static atomic<uint64_t> counters[int(ProfileCounter::Count)];
+static atomic<uint32_t> threadCnt{0};
+static uint64_t origin = 0;
+static uint64_t frameBegin = 0;             //the earliest event of the current frame
+static uint32_t frameCnt = 0;
+static bool separator = false;              //a comma is required before the next event
+
+
+//a small sequential number per thread for the trace viewers
+static uint32_t _tid()
+{
+    static thread_local uint32_t tid = threadCnt++;
+    return tid;
+}
+
+
+static void _write(const char* name, const char* phase, uint32_t tid, uint64_t begin, uint64_t end)
+{
+    fprintf(trace, "%s\n{\"name\":\"%s\",\"cat\":\"thorvg\",\"ph\":\"%s\",\"pid\":0,\"tid\":%u,\"ts\":%.3f", separator ? "," : "", name, phase, tid, double(begin - origin) * 0.001);
+    if (phase[0] == 'X') fprintf(trace, ",\"dur\":%.3f}", double(end - begin) * 0.001);
+    separator = true;
+}
+
+
+static void _close()
+{
+    if (!trace) return;
+    fprintf(trace, "\n]\n");
+    fclose(trace);
+    trace = nullptr;
+}
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void Profiler::init()
+{
+    //the following sessions continue the event array of the first one
+    if (!trace) {
+        auto path = getenv("THORVG_TRACE");
+        if (!path) return;
+
+        trace = fopen(path, "w");
+        if (!trace) {
+            TVGERR("RENDERER", "Failed to open the trace file(%s)", path);
+            return;
+        }
+        fprintf(trace, "[");
+        origin = now();
+        atexit(_close);
+    }
+
+    frameBegin = 0;
+    for (auto& counter : counters) counter = 0;
+    tracing = true;
+}
+
+
+void Profiler::term()
+{
+    if (!tracing) return;
+
+    frame();
+    tracing = false;
+    events.reset();
+}
+
+
+uint64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end)
+{
+    if (!tracing) return;
+
+    ScopedLock lock(key);
+    events.push({name, begin, end, _tid()});
+    if (frameBegin == 0 || begin < frameBegin) frameBegin = begin;
+}
+
+
+void Profiler::count(ProfileCounter counter, uint64_t value)
+{
+    if (!tracing) return;
+    counters[int(counter)] += value;
+}
+
+
+void Profiler::frame()
+{
+    if (!tracing) return;
+
+    ScopedLock lock(key);
+
+    if (events.empty()) return;
+
+    auto end = now();
+
+    //the whole frame span on the calling thread
+    char name[32];
+    snprintf(name, sizeof(name), "frame %u", frameCnt++);
+    _write(name, "X", _tid(), frameBegin, end);
+
+    ARRAY_FOREACH(p, events) _write(p->name, "X", p->tid, p->begin, p->end);
+
+    //the counters of the frame
+    _write("counters", "C", 0, end, end);
+    fprintf(trace, ",\"args\":{");
+    for (int i = 0; i < int(ProfileCounter::Count); ++i) {
+        fprintf(trace, "%s\"%s\":%llu", i > 0 ? "," : "", counterNames[i], (unsigned long long) counters[i].exchange(0));
+    }
+    fprintf(trace, "}}");
+    fflush(trace);
+
+    events.clear();
+    frameBegin = 0;
+}
+
+#endif //THORVG_PROFILER_SUPPORT
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_PROFILER_H_
+#define _TVG_PROFILER_H_
+
+#include "tvgCommon.h"
+
+/*
+ * Per frame timings of the named scopes and the rendering counters.
+ * It's compiled only with the profiler build option and it's active only if the THORVG_TRACE environment variable
+ * points to a writable file. The frames are appended into the file in the Chrome trace event array format (chrome://tracing, ui.perfetto.dev)
+ * which stays loadable even if the engine is not terminated. A frame is closed by Canvas::sync().
+ * The file is opened at the first initialization and closed at the process exit, so the sessions of a process share one event array.
+ */
+
+#ifdef THORVG_PROFILER_SUPPORT
+
+namespace tvg {
+
+enum class ProfileCounter : uint8_t {Spans = 0, Pixels, Surfaces, Tasks, Count};
+
+struct Profiler
+{
+    static bool tracing;    //between the initialization and the termination with the trace file
+
+    static void init();
+    static void term();
+    static uint64_t now();
+    static void record(const char* name, uint64_t begin, uint64_t end);
+    static void count(ProfileCounter counter, uint64_t value);
+    static void frame();
+};
+
+struct ProfileScope
+{
+    const char* name;
+    uint64_t begin;
+
+    ProfileScope(const char* name) : name(name), begin(Profiler::tracing ? Profiler::now() : 0) {}
+    ~ProfileScope() { if (begin > 0) Profiler::record(name, begin, Profiler::now()); }
+};
+
+}
+
+#define TVG_PROFILE(name) tvg::ProfileScope _profileScope(name)
+#define TVG_PROFILE_COUNT(counter, value) do { if (tvg::Profiler::tracing) tvg::Profiler::count(tvg::ProfileCounter::counter, value); } while(0)
+#define TVG_PROFILE_FRAME() tvg::Profiler::frame()
+
+#else
+
+#define TVG_PROFILE(name) do {} while(0)
+#define TVG_PROFILE_COUNT(counter, value) do {} while(0)
+#define TVG_PROFILE_FRAME() do {} while(0)
+
+#endif //THORVG_PROFILER_SUPPORT
+
+#endif //_TVG_PROFILER_H_
@@ -66,11 +66,21 @@ struct RenderSurface
     ColorSpace cs = ColorSpace::Unknown;
     uint8_t channelSize = 0;
     bool premultiplied = false;         //Alpha-premultiplied
+    bool shared = false;                //The pixels are owned by the user and could be changed at any time.
+    RenderSurface* mipmap = nullptr;    //Lazily built half-sized level of this image for the minification
 
     RenderSurface()
     {
     }
 
+    ~RenderSurface()
+    {
+        if (mipmap) {
+            tvg::free(mipmap->data);
+            delete(mipmap);
+        }
+    }
+
     RenderSurface(const RenderSurface* rhs)
     {
         data = rhs->data;
@@ -330,9 +340,23 @@ struct RenderStroke
     }
 };
 
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+//a glyph placed in the text path, its commands and points are consecutive in the path.
+struct RenderGlyph
+{
+    uint64_t key;       //unique glyph identity (font | glyph id)
+    Point offset;       //pen position in the path space
+    uint32_t cmds;      //number of the path commands
+    uint32_t pts;       //number of the path points
+};
+#endif
+
 struct RenderShape
 {
     RenderPath path;
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+    Array<RenderGlyph> glyphs;   //glyph layout if the path is a text
+#endif
     Fill *fill = nullptr;
     RenderColor color{};
     RenderStroke *stroke = nullptr;
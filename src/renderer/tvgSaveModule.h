@@ -28,6 +28,9 @@
 namespace tvg
 {
 
+//receives the encoded data in order
+using SaveFunc = std::function<bool(const uint8_t* chunk, uint32_t size, void* data)>;
+
 class SaveModule
 {
 public:
@@ -35,6 +38,7 @@ public:
 
     virtual bool save(Paint* paint, Paint* bg, const char* filename, uint32_t quality) = 0;
     virtual bool save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps) = 0;
+    virtual bool save(Animation* animation, Paint* bg, SaveFunc func, void* data, uint32_t quality, uint32_t fps) = 0;
     virtual bool close() = 0;
 };
 
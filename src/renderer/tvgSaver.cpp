@@ -28,6 +28,12 @@
 #ifdef THORVG_GIF_SAVER_SUPPORT
     #include "tvgGifSaver.h"
 #endif
+#ifdef THORVG_PNG_SAVER_SUPPORT
+    #include "tvgPngSaver.h"
+#endif
+#ifdef THORVG_Y4M_SAVER_SUPPORT
+    #include "tvgY4mSaver.h"
+#endif
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -52,6 +58,18 @@ static SaveModule* _find(FileType type)
         case FileType::Gif: {
 #ifdef THORVG_GIF_SAVER_SUPPORT
             return new GifSaver;
+#endif
+            break;
+        }
+        case FileType::Png: {
+#ifdef THORVG_PNG_SAVER_SUPPORT
+            return new PngSaver;
+#endif
+            break;
+        }
+        case FileType::Y4m: {
+#ifdef THORVG_Y4M_SAVER_SUPPORT
+            return new Y4mSaver;
 #endif
             break;
         }
@@ -67,6 +85,14 @@ static SaveModule* _find(FileType type)
             format = "GIF";
             break;
         }
+        case FileType::Png: {
+            format = "PNG";
+            break;
+        }
+        case FileType::Y4m: {
+            format = "Y4M";
+            break;
+        }
         default: {
             format = "???";
             break;
@@ -82,6 +108,17 @@ static SaveModule* _find(const char* filename)
 {
     auto ext = fileext(filename);
     if (ext && !strcmp(ext, "gif")) return _find(FileType::Gif);
+    if (ext && !strcmp(ext, "png")) return _find(FileType::Png);
+    if (ext && !strcmp(ext, "y4m")) return _find(FileType::Y4m);
+    return nullptr;
+}
+
+
+static SaveModule* _findByType(const char* mimeType)
+{
+    if (mimeType && !strcmp(mimeType, "gif")) return _find(FileType::Gif);
+    if (mimeType && !strcmp(mimeType, "y4m")) return _find(FileType::Y4m);
+    TVGLOG("RENDERER", "Given mimetype is unknown = \"%s\".", mimeType ? mimeType : "");
     return nullptr;
 }
 
@@ -171,14 +208,52 @@ Result Saver::save(Animation* animation, const char* filename, uint32_t quality,
 }
 
 
+Result Saver::save(Animation* animation, const char* mimeType, std::function<bool(const uint8_t* chunk, uint32_t size, void* data)> func, void* data, uint32_t quality, uint32_t fps) noexcept
+{
+    if (!animation) return Result::InvalidArguments;
+
+    //animation holds the picture, it must be 1 at the bottom.
+    auto remove = animation->picture()->refCnt() <= 1 ? true : false;
+
+    if (!func) {
+        if (remove) delete(animation);
+        return Result::InvalidArguments;
+    }
+
+    if (tvg::zero(animation->totalFrame())) {
+        if (remove) delete(animation);
+        return Result::InsufficientCondition;
+    }
+
+    //Already on saving another resource.
+    if (pImpl->saveModule) {
+        if (remove) delete(animation);
+        return Result::InsufficientCondition;
+    }
+
+    if (auto saveModule = _findByType(mimeType)) {
+        if (saveModule->save(animation, pImpl->bg, func, data, quality, fps)) {
+            pImpl->saveModule = saveModule;
+            return Result::Success;
+        } else {
+            if (remove) delete(animation);
+            delete(saveModule);
+            return Result::Unknown;
+        }
+    }
+    if (remove) delete(animation);
+    return Result::NonSupport;
+}
+
+
 Result Saver::sync() noexcept
 {
     if (!pImpl->saveModule) return Result::InsufficientCondition;
-    pImpl->saveModule->close();
+    auto success = pImpl->saveModule->close();
     delete(pImpl->saveModule);
     pImpl->saveModule = nullptr;
 
-    return Result::Success;
+    return success ? Result::Success : Result::Unknown;
 }
 
 
@@ -335,6 +335,9 @@ struct ShapeImpl : Shape
     {
         rs.path.cmds.clear();
         rs.path.pts.clear();
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        rs.glyphs.clear();
+#endif
         impl.mark(RenderUpdateFlag::Path);
     }
 
@@ -497,6 +500,9 @@ struct ShapeImpl : Shape
         PAINT(this)->reset();
         rs.path.cmds.clear();
         rs.path.pts.clear();
+#ifdef THORVG_SW_GLYPH_CACHE_SUPPORT
+        rs.glyphs.clear();
+#endif
 
         rs.color.a = 0;
         rs.rule = FillRule::NonZero;
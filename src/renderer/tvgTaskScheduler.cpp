@@ -24,6 +24,7 @@
 #include "tvgArray.h"
 #include "tvgInlist.h"
 #include "tvgTaskScheduler.h"
+#include "tvgProfiler.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -33,6 +34,8 @@ namespace tvg {
 
 #ifdef THORVG_THREAD_SUPPORT
 
+static thread_local bool _async = true;  //false: run the requested tasks on the calling thread
+
 struct TaskQueue {
     Inlist<Task>             taskDeque;
     mutex                    mtx;
@@ -148,7 +151,7 @@ struct TaskSchedulerImpl
     void request(Task* task)
     {
         //Async
-        if (threads.count > 0) {
+        if (threads.count > 0 && _async) {
             task->prepare();
             auto i = idx++;
             for (uint32_t n = 0; n < threads.count; ++n) {
@@ -165,6 +168,11 @@ struct TaskSchedulerImpl
     {
         return threads.count;
     }
+
+    void async(bool on)
+    {
+        _async = on;
+    }
 };
 
 #else //THORVG_THREAD_SUPPORT
@@ -174,6 +182,7 @@ struct TaskSchedulerImpl
     TaskSchedulerImpl(TVG_UNUSED uint32_t threadCnt) {}
     void request(Task* task) { task->run(0); }
     uint32_t threadCnt() { return 0; }
+    void async(TVG_UNUSED bool on) {}
 };
 
 #endif //THORVG_THREAD_SUPPORT
@@ -205,10 +214,17 @@ void TaskScheduler::term()
 
 void TaskScheduler::request(Task* task)
 {
+    TVG_PROFILE_COUNT(Tasks, 1);
     if (_inst) _inst->request(task);
 }
 
 
+void TaskScheduler::async(bool on)
+{
+    if (_inst) _inst->async(on);
+}
+
+
 uint32_t TaskScheduler::threads()
 {
     return _inst ? _inst->threadCnt() : 0;
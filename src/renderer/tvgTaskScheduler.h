@@ -112,6 +112,7 @@ struct TaskScheduler
     static void init(uint32_t threads);
     static void term();
     static void request(Task* task);
+    static void async(bool on);  //on: dispatch to the workers, off: run on the calling thread
     static bool onthread();  //figure out whether on worker thread or not
     static ThreadID tid();
 };
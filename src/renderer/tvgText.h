@@ -38,6 +38,7 @@ struct TextImpl : Text
     Shape* shape;   //text shape
     FontLoader* loader = nullptr;
     FontMetrics metrics;
+    FontRun run;    //shaped glyphs for the relayout
     char* utf8 = nullptr;
     float fontSize;
     bool italic = false;
@@ -83,6 +84,7 @@ struct TextImpl : Text
             LoaderMgr::retrieve(this->loader);
         }
         this->loader = static_cast<FontLoader*>(loader);
+        run.glyphs.clear();
 
         impl.mark(RenderUpdateFlag::Path);
 
@@ -105,8 +107,8 @@ struct TextImpl : Text
     {
         if (!loader) return 0.0f;
 
-        //reload
-        if (impl.marked(RenderUpdateFlag::Path)) loader->read(shape, utf8, metrics);
+        //relayout the changed glyphs only, the font size is applied by the transform.
+        if (impl.marked(RenderUpdateFlag::Path)) loader->read(shape, utf8, metrics, run);
 
         return loader->transform(shape, metrics, fontSize, italic);
     }
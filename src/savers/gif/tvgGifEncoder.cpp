@@ -54,26 +54,23 @@
 #define BIT_DEPTH 8
 
 
-// Simple structure to write out the LZW-compressed portion of the image
-// one bit at a time
+#define BUFFER_SIZE (64 * 1024)   // buffered output before reaching the file
+#define DICT_BITS 13               // hashed LZW dictionary of 8192 slots for the 4096 codes
+#define DICT_SIZE (1 << DICT_BITS)
+
+
+// Simple structure to write out the LZW-compressed portion of the image.
+// The codes are packed into a 64-bit accumulator, least significant bit first.
 typedef struct
 {
-    uint8_t bitIndex;  // how many bits in the partial byte written so far
-    uint8_t byte;      // current partial byte
+    uint64_t bits;        // pending bits
+    uint32_t bitCount;    // how many bits are pending
 
     uint32_t chunkIndex;
-    uint8_t chunk[256];   // bytes are written in here until we have 256 of them, then written to the file
+    uint8_t chunk[256];   // bytes are written in here until we have 255 of them, then written out as a sub-block
 } GifBitStatus;
 
 
-// The LZW dictionary is a 256-ary tree constructed as the file is encoded,
-// this is one node
-typedef struct
-{
-    uint16_t m_next[256];
-} GifLzwNode;
-
-
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -259,27 +256,30 @@ static void _splitPalette(uint8_t* image, int numPixels, int firstElt, int lastE
 }
 
 
-// Finds all pixels that have changed from the previous image and
-// moves them to the from of the buffer.
+// Finds all pixels of the frame area that have changed from the previous image and
+// gathers them to the front of the buffer.
 // This allows us to build a palette optimized for the colors of the
 // changed pixels only.
-static int _pickChangedPixels(const uint8_t* lastFrame, uint8_t* frame, int numPixels, bool transparent)
+static int _pickChangedPixels(const GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, uint8_t* writeIter, bool transparent)
 {
     int numChanged = 0;
-    uint8_t* writeIter = frame;
-
-    for (int ii=0; ii < numPixels; ++ii) {
-        if (frame[3] >= TRANSPARENT_THRESHOLD) {
-            if (transparent || (lastFrame[0] != frame[0] || lastFrame[1] != frame[1] || lastFrame[2] != frame[2])) {
-                writeIter[0] = frame[0];
-                writeIter[1] = frame[1];
-                writeIter[2] = frame[2];
-                ++numChanged;
-                writeIter += 4;
+
+    for (uint32_t yy = 0; yy < frame->h; ++yy) {
+        auto offset = ((frame->y + yy) * width + frame->x) * 4;
+        auto next = image + offset;
+        auto last = lastImage ? lastImage + offset : nullptr;
+        for (uint32_t xx = 0; xx < frame->w; ++xx, next += 4) {
+            if (last) {
+                auto changed = next[3] >= TRANSPARENT_THRESHOLD && (transparent || (last[0] != next[0] || last[1] != next[1] || last[2] != next[2]));
+                last += 4;
+                if (!changed) continue;
             }
+            writeIter[0] = next[0];
+            writeIter[1] = next[1];
+            writeIter[2] = next[2];
+            ++numChanged;
+            writeIter += 4;
         }
-        lastFrame += 4;
-        frame += 4;
     }
 
     return numChanged;
@@ -288,21 +288,18 @@ static int _pickChangedPixels(const uint8_t* lastFrame, uint8_t* frame, int numP
 
 // Creates a palette by placing all the image pixels in a k-d tree and then averaging the blocks at the bottom.
 // This is known as the "modified median split" technique
-static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, uint32_t height, int bitDepth, bool transparent)
+static void _makePalette(GifFrame* frame, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, int bitDepth, bool transparent)
 {
-    auto& pal = writer->pal;
-
-    size_t imageSize = (size_t)(width * height * 4 * sizeof(uint8_t));
-    memcpy(writer->tmpImage, nextFrame, imageSize);
+    auto& pal = frame->pal;
 
-    int numPixels = (int)(width * height);
-    if (lastFrame) numPixels = _pickChangedPixels(lastFrame, writer->tmpImage, numPixels, transparent);
+    // all the pixels of the first frame, the changed ones of the others
+    int numPixels = _pickChangedPixels(frame, lastFrame, nextFrame, width, frame->tmpImage, transparent);
 
     const int lastElt = 1 << bitDepth;
     const int splitElt = lastElt/2;
     const int splitDist = splitElt/2;
 
-    _splitPalette(writer->tmpImage, numPixels, 1, lastElt, splitElt, splitDist, 1, &pal);
+    _splitPalette(frame->tmpImage, numPixels, 1, lastElt, splitElt, splitDist, 1, &pal);
 
     // add the bottom node for the transparency index
     pal.treeSplit[1 << (bitDepth-1)] = 0;
@@ -311,226 +308,550 @@ static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint
 }
 
 
-void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pPal)
+static uint8_t _palettizePixel(const uint8_t* nextFrame, GifPalette* pPal)
 {
     int32_t bestDiff = 1000000;
     int32_t bestInd = 1;
     _getClosestPaletteColor(pPal, nextFrame[0], nextFrame[1], nextFrame[2], &bestInd, &bestDiff, 1);
-
-    // Write the resulting color to the output buffer
-    outFrame[0] = pPal->r[bestInd];
-    outFrame[1] = pPal->g[bestInd];
-    outFrame[2] = pPal->b[bestInd];
-    outFrame[3] = (uint8_t)bestInd;
+    return (uint8_t)bestInd;
 }
 
 
 // Picks palette colors for the image using simple threshholding, no dithering
-static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame,  uint32_t width, uint32_t height, bool transparent)
-{
-    auto outFrame = writer->oldImage;
-    uint32_t numPixels = width*height;
-
-    if (transparent) {
-        for (uint32_t ii = 0; ii < numPixels; ++ii) {
-            if (nextFrame[3] < TRANSPARENT_THRESHOLD) {
-                outFrame[0] = 0;
-                outFrame[1] = 0;
-                outFrame[2] = 0;
-                outFrame[3] = TRANSPARENT_IDX;
-            } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+static void _thresholdImage(GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, bool transparent)
+{
+    auto outFrame = frame->index;
+
+    for (uint32_t yy = 0; yy < frame->h; ++yy) {
+        auto offset = ((frame->y + yy) * width + frame->x) * 4;
+        auto nextFrame = image + offset;
+        auto lastFrame = lastImage ? lastImage + offset : nullptr;
+        for (uint32_t xx = 0; xx < frame->w; ++xx, ++outFrame, nextFrame += 4) {
+            if (transparent) {
+                if (nextFrame[3] < TRANSPARENT_THRESHOLD) {
+                    *outFrame = TRANSPARENT_IDX;
+                    continue;
+                }
+            } else if (lastFrame) {
+                // if a previous color is available, and it matches the current color,
+                // set the pixel to transparent. the previous frame shows the same source color there already.
+                auto same = (lastFrame[0] == nextFrame[0] && lastFrame[1] == nextFrame[1] && lastFrame[2] == nextFrame[2]);
+                lastFrame += 4;
+                if (same) {
+                    *outFrame = TRANSPARENT_IDX;
+                    continue;
+                }
             }
+            *outFrame = _palettizePixel(nextFrame, &frame->pal);
+        }
+    }
+}
+
+
+static inline bool _visible(const uint8_t* pixel)
+{
+    return pixel[3] >= TRANSPARENT_THRESHOLD;
+}
+
+
+static inline bool _changed(const uint8_t* last, const uint8_t* next)
+{
+    return last[0] != next[0] || last[1] != next[1] || last[2] != next[2];
+}
+
+
+// The area of the frame to encode. The pixels out of it are kept from the previous frame:
+// the opaque frames keep the previous ones, so it's the bounding box of the changed pixels.
+// the transparent frames clear their own area when the next frame comes, so it's the bounding box of the visible pixels.
+static void _changedRect(GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, uint32_t height, bool transparent)
+{
+    if (!transparent && !lastImage) {
+        frame->x = frame->y = 0;
+        frame->w = width;
+        frame->h = height;
+        return;
+    }
+
+    uint32_t x0 = width, y0 = height, x1 = 0, y1 = 0;
+
+    for (uint32_t yy = 0; yy < height; ++yy) {
+        auto next = image + yy * width * 4;
+        auto last = transparent ? nullptr : lastImage + yy * width * 4;
+        uint32_t left = 0, right = width;
+        if (transparent) {
+            while (left < width && !_visible(next + left * 4)) ++left;
+            if (left == width) continue;
+            while (!_visible(next + (right - 1) * 4)) --right;
+        } else {
+            while (left < width && !_changed(last + left * 4, next + left * 4)) ++left;
+            if (left == width) continue;
+            while (!_changed(last + (right - 1) * 4, next + (right - 1) * 4)) --right;
+        }
+        if (left < x0) x0 = left;
+        if (right > x1) x1 = right;
+        if (yy < y0) y0 = yy;
+        y1 = yy + 1;
+    }
+
+    // nothing to update, a frame is still necessary for the delay
+    if (x1 <= x0) {
+        frame->x = frame->y = 0;
+        frame->w = frame->h = 1;
+        return;
+    }
+
+    frame->x = x0;
+    frame->y = y0;
+    frame->w = x1 - x0;
+    frame->h = y1 - y0;
+}
+
+
+// The histogram quantizer works on 5 bits per channel, 32k bins in total.
+#define HIST_BITS 5
+#define HIST_SIZE GIF_LUT_SIZE  // (1 << (HIST_BITS * 3))
+
+static inline uint32_t _bin(const uint8_t* pixel)
+{
+    return ((pixel[0] >> (8 - HIST_BITS)) << (HIST_BITS * 2)) | ((pixel[1] >> (8 - HIST_BITS)) << HIST_BITS) | (pixel[2] >> (8 - HIST_BITS));
+}
+
+
+static inline uint32_t _binAxis(uint32_t bin, int axis)
+{
+    return (bin >> (HIST_BITS * (2 - axis))) & ((1 << HIST_BITS) - 1);
+}
+
+
+// a color box of the median cut, it spans the bins[begin, end)
+struct GifHistBox
+{
+    uint32_t begin, end;
+    uint32_t count;      // pixels in the box
+    uint8_t axis;        // the longest axis
+    uint8_t range;       // the extent on the longest axis
+};
+
+
+static void _measureBox(GifHistBox* box, const uint16_t* bins, const uint32_t* counts)
+{
+    uint32_t lo[3] = {255, 255, 255}, hi[3] = {0, 0, 0};
+    box->count = 0;
+    for (auto i = box->begin; i < box->end; ++i) {
+        for (int a = 0; a < 3; ++a) {
+            auto v = _binAxis(bins[i], a);
+            if (v < lo[a]) lo[a] = v;
+            if (v > hi[a]) hi[a] = v;
+        }
+        box->count += counts[bins[i]];
+    }
+    box->axis = 0;
+    for (int a = 1; a < 3; ++a) {
+        if (hi[a] - lo[a] > hi[box->axis] - lo[box->axis]) box->axis = a;
+    }
+    box->range = (uint8_t)(hi[box->axis] - lo[box->axis]);
+}
+
+
+// orders the bins of the box along its longest axis with a counting sort and splits it where the half of the pixels are reached
+static bool _splitBox(GifHistBox* box, GifHistBox* other, uint16_t* bins, uint16_t* tmp, const uint32_t* counts)
+{
+    if (box->range == 0 || box->end - box->begin < 2) return false;
+
+    uint32_t offsets[(1 << HIST_BITS) + 1] = {0};
+    for (auto i = box->begin; i < box->end; ++i) ++offsets[_binAxis(bins[i], box->axis) + 1];
+    for (int i = 1; i <= (1 << HIST_BITS); ++i) offsets[i] += offsets[i - 1];
+    for (auto i = box->begin; i < box->end; ++i) tmp[offsets[_binAxis(bins[i], box->axis)]++] = bins[i];
+    memcpy(bins + box->begin, tmp, (box->end - box->begin) * sizeof(uint16_t));
+
+    auto half = box->count / 2;
+    auto sum = 0U;
+    auto mid = box->begin;
+    while (mid < box->end - 1) {
+        sum += counts[bins[mid++]];
+        if (sum >= half) break;
+    }
+
+    other->begin = mid;
+    other->end = box->end;
+    box->end = mid;
+    _measureBox(box, bins, counts);
+    _measureBox(other, bins, counts);
+    return true;
+}
+
+
+// Builds the palette with a median cut over the color histogram of the changed pixels,
+// then maps each occupied bin to its nearest palette entry.
+static void _makeHistogramPalette(GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, bool transparent)
+{
+    auto counts = frame->histogram;
+    auto sums = reinterpret_cast<uint64_t*>(counts + HIST_SIZE);  // r, g, b sums, a bin could have more than 16M pixels
+    auto bins = reinterpret_cast<uint16_t*>(sums + HIST_SIZE * 3);
+    auto tmp = bins + HIST_SIZE;
+
+    // the same pixels _thresholdHistogramImage() looks up
+    uint32_t binCnt = 0;
+    for (uint32_t yy = 0; yy < frame->h; ++yy) {
+        auto offset = ((frame->y + yy) * width + frame->x) * 4;
+        auto nextFrame = image + offset;
+        auto lastFrame = lastImage ? lastImage + offset : nullptr;
+        for (uint32_t xx = 0; xx < frame->w; ++xx, nextFrame += 4) {
+            auto last = lastFrame;
             if (lastFrame) lastFrame += 4;
-            outFrame += 4;
-            nextFrame += 4;
+            if (transparent) {
+                if (nextFrame[3] < TRANSPARENT_THRESHOLD) continue;
+            } else if (last && last[0] == nextFrame[0] && last[1] == nextFrame[1] && last[2] == nextFrame[2]) continue;
+            auto bin = _bin(nextFrame);
+            if (counts[bin]++ == 0) bins[binCnt++] = (uint16_t)bin;
+            sums[bin * 3] += nextFrame[0];
+            sums[bin * 3 + 1] += nextFrame[1];
+            sums[bin * 3 + 2] += nextFrame[2];
         }
-    } else {
-        for (uint32_t ii = 0; ii < numPixels; ++ii) {
-            // if a previous color is available, and it matches the current color,
-            // set the pixel to transparent
-            if(lastFrame && lastFrame[0] == nextFrame[0] && lastFrame[1] == nextFrame[1] && lastFrame[2] == nextFrame[2]) {
-                outFrame[0] = lastFrame[0];
-                outFrame[1] = lastFrame[1];
-                outFrame[2] = lastFrame[2];
-                outFrame[3] = TRANSPARENT_IDX;
-            } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+    }
+    if (binCnt == 0) return;
+
+    // split the box weighing the most (pixels x extent) along its longest axis until the palette is full
+    const int maxBoxes = (1 << BIT_DEPTH) - 1;  // except for the transparent index
+    GifHistBox boxes[maxBoxes];
+    int boxCnt = 1;
+    boxes[0].begin = 0;
+    boxes[0].end = binCnt;
+    _measureBox(&boxes[0], bins, counts);
+
+    while (boxCnt < maxBoxes) {
+        int pick = -1;
+        uint64_t best = 0;
+        for (int i = 0; i < boxCnt; ++i) {
+            auto priority = (uint64_t)boxes[i].count * boxes[i].range;
+            if (priority > best) {
+                best = priority;
+                pick = i;
+            }
+        }
+        if (pick < 0 || !_splitBox(&boxes[pick], &boxes[boxCnt], bins, tmp, counts)) break;
+        ++boxCnt;
+    }
+
+    auto& pal = frame->pal;
+    for (int i = 0; i < boxCnt; ++i) {
+        uint64_t r = 0, g = 0, b = 0, cnt = boxes[i].count;
+        for (auto j = boxes[i].begin; j < boxes[i].end; ++j) {
+            r += sums[bins[j] * 3];
+            g += sums[bins[j] * 3 + 1];
+            b += sums[bins[j] * 3 + 2];
+        }
+        pal.r[i + 1] = (uint8_t)((r + cnt / 2) / cnt);
+        pal.g[i + 1] = (uint8_t)((g + cnt / 2) / cnt);
+        pal.b[i + 1] = (uint8_t)((b + cnt / 2) / cnt);
+    }
+
+    // the lookup table of this palette, only the occupied bins are ever looked up
+    for (uint32_t i = 0; i < binCnt; ++i) {
+        auto bin = bins[i];
+        int r = (int)((sums[bin * 3] + counts[bin] / 2) / counts[bin]);
+        int g = (int)((sums[bin * 3 + 1] + counts[bin] / 2) / counts[bin]);
+        int b = (int)((sums[bin * 3 + 2] + counts[bin] / 2) / counts[bin]);
+        int bestInd = 1, bestDiff = INT32_MAX;
+        for (int j = 1; j <= boxCnt; ++j) {
+            auto diff = abs(r - pal.r[j]) + abs(g - pal.g[j]) + abs(b - pal.b[j]);
+            if (diff < bestDiff) {
+                bestDiff = diff;
+                bestInd = j;
             }
-            if (lastFrame) lastFrame += 4;
-            outFrame += 4;
-            nextFrame += 4;
         }
+        frame->lut[bin] = (uint8_t)bestInd;
+    }
+
+    // only the occupied bins are dirty, keep the histogram zeroed for the next use
+    for (uint32_t i = 0; i < binCnt; ++i) {
+        auto bin = bins[i];
+        counts[bin] = 0;
+        sums[bin * 3] = sums[bin * 3 + 1] = sums[bin * 3 + 2] = 0;
     }
 }
 
 
-// insert a single bit
-static void _writeBit(GifBitStatus* stat, uint32_t bit)
+// Same as _thresholdImage(), but picks the palette colors from the lookup table
+static void _thresholdHistogramImage(GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, bool transparent)
 {
-    bit = bit & 1;
-    bit = bit << stat->bitIndex;
-    stat->byte |= bit;
+    auto outFrame = frame->index;
+
+    for (uint32_t yy = 0; yy < frame->h; ++yy) {
+        auto offset = ((frame->y + yy) * width + frame->x) * 4;
+        auto nextFrame = image + offset;
+        auto lastFrame = lastImage ? lastImage + offset : nullptr;
+        for (uint32_t xx = 0; xx < frame->w; ++xx, ++outFrame, nextFrame += 4) {
+            if (transparent) {
+                if (nextFrame[3] < TRANSPARENT_THRESHOLD) {
+                    *outFrame = TRANSPARENT_IDX;
+                    continue;
+                }
+            } else if (lastFrame) {
+                auto same = (lastFrame[0] == nextFrame[0] && lastFrame[1] == nextFrame[1] && lastFrame[2] == nextFrame[2]);
+                lastFrame += 4;
+                if (same) {
+                    *outFrame = TRANSPARENT_IDX;
+                    continue;
+                }
+            }
+            *outFrame = frame->lut[_bin(nextFrame)];
+        }
+    }
+}
 
-    ++stat->bitIndex;
-    if (stat->bitIndex > 7) {
-        // move the newly-finished byte to the chunk buffer
-        stat->chunk[stat->chunkIndex++] = stat->byte;
-        // and start a new byte
-        stat->bitIndex = 0;
-        stat->byte = 0;
+
+static void _flush(GifWriter* writer)
+{
+    if (writer->count == 0) return;
+    if (!writer->failed) {
+        if (writer->f) writer->failed = (fwrite(writer->buffer, 1, writer->count, writer->f) != writer->count);
+        else writer->failed = !writer->func(writer->buffer, writer->count, writer->data);
     }
+    writer->count = 0;
 }
 
 
-// write all bytes so far to the file
-static void _writeChunk(FILE* f, GifBitStatus* stat)
+static inline void _put(GifWriter* writer, uint8_t byte)
 {
-    fputc((int)stat->chunkIndex, f);
-    fwrite(stat->chunk, 1, stat->chunkIndex, f);
+    if (writer->count == BUFFER_SIZE) _flush(writer);
+    writer->buffer[writer->count++] = byte;
+}
+
+
+static void _put(GifWriter* writer, const uint8_t* data, uint32_t size)
+{
+    if (writer->count + size > BUFFER_SIZE) _flush(writer);
+    //larger data than the buffer goes out in pieces
+    while (size > BUFFER_SIZE) {
+        memcpy(writer->buffer, data, BUFFER_SIZE);
+        writer->count = BUFFER_SIZE;
+        _flush(writer);
+        data += BUFFER_SIZE;
+        size -= BUFFER_SIZE;
+    }
+    memcpy(writer->buffer + writer->count, data, size);
+    writer->count += size;
+}
+
 
-    stat->bitIndex = 0;
-    stat->byte = 0;
+// write all bytes so far as a sub-block
+static void _writeChunk(GifWriter* writer, GifBitStatus* stat)
+{
+    _put(writer, (uint8_t)stat->chunkIndex);
+    _put(writer, stat->chunk, stat->chunkIndex);
     stat->chunkIndex = 0;
 }
 
 
-static void _writeCode(FILE* f, GifBitStatus* stat, uint32_t code, uint32_t length)
+// move the complete bytes of the accumulator into the chunk
+static inline void _drainBits(GifWriter* writer, GifBitStatus* stat)
 {
-    for (uint32_t ii = 0; ii < length; ++ii) {
-        _writeBit(stat, code);
-        code = code >> 1;
-        if (stat->chunkIndex == 255) _writeChunk(f, stat);
+    while (stat->bitCount >= 8) {
+        stat->chunk[stat->chunkIndex++] = (uint8_t)stat->bits;
+        stat->bits >>= 8;
+        stat->bitCount -= 8;
+        if (stat->chunkIndex == 255) _writeChunk(writer, stat);
     }
 }
 
 
+static inline void _writeCode(GifWriter* writer, GifBitStatus* stat, uint32_t code, uint32_t length)
+{
+    stat->bits |= (uint64_t)code << stat->bitCount;
+    stat->bitCount += length;
+    // the codes are 12 bits at most, drain only when the accumulator runs short
+    if (stat->bitCount > 64 - 12) _drainBits(writer, stat);
+}
+
+
+// The dictionary entry packs (prefix code << 8 | next index) and the code of that run, 0 for an empty slot.
+// The run codes always exceed the clear code so they are never 0.
+static inline uint32_t _dictFind(const uint32_t* dict, uint32_t key, uint32_t* slot)
+{
+    auto idx = (key * 2654435761u) >> (32 - DICT_BITS);
+    while (dict[idx]) {
+        if ((dict[idx] >> 12) == key) {
+            *slot = idx;
+            return dict[idx] & 0xfff;
+        }
+        idx = (idx + 1) & (DICT_SIZE - 1);
+    }
+    *slot = idx;
+    return 0;
+}
+
+
 // write a 256-color (8-bit) image palette to the file
-static void _writePalette(const GifPalette* pPal, FILE* f)
+static void _writePalette(GifWriter* writer, const GifPalette* pPal)
 {
-    fputc(0, f);  // first color: transparency
-    fputc(0, f);
-    fputc(0, f);
+    _put(writer, 0);  // first color: transparency
+    _put(writer, 0);
+    _put(writer, 0);
 
     for (int ii = 1; ii < (1 << BIT_DEPTH); ++ii) {
-        uint32_t r = pPal->r[ii];
-        uint32_t g = pPal->g[ii];
-        uint32_t b = pPal->b[ii];
-
-        fputc((int)r, f);
-        fputc((int)g, f);
-        fputc((int)b, f);
+        _put(writer, pPal->r[ii]);
+        _put(writer, pPal->g[ii]);
+        _put(writer, pPal->b[ii]);
     }
 }
 
 
 // write the image header, LZW-compress and write out the image
-static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+static void _writeLzwImage(GifWriter* writer, const GifFrame* frame, uint32_t delay, bool transparent)
 {
-    auto f = writer->f;
-    auto image = writer->oldImage;
+    auto image = frame->index;
 
     // graphics control extension
-    fputc(0x21, f);
-    fputc(0xf9, f);
-    fputc(0x04, f);
-    fputc((transparent ? 0x09 : 0x05), f);  //clear prev frame or not.
-    fputc(delay & 0xff, f);
-    fputc((delay >> 8) & 0xff, f);
-    fputc(TRANSPARENT_IDX, f); // transparent color index
-    fputc(0, f);
+    _put(writer, 0x21);
+    _put(writer, 0xf9);
+    _put(writer, 0x04);
+    _put(writer, (transparent ? 0x09 : 0x05));  //clear prev frame or not.
+    _put(writer, delay & 0xff);
+    _put(writer, (delay >> 8) & 0xff);
+    _put(writer, TRANSPARENT_IDX); // transparent color index
+    _put(writer, 0);
 
-    fputc(0x2c, f); // image descriptor block
+    _put(writer, 0x2c); // image descriptor block
 
     // corner of image (left, top) in canvas space
-    fputc(0, f);
-    fputc(0, f);
-    fputc(0, f);
-    fputc(0, f);
-
-    fputc(width & 0xff, f);          // width and height of image
-    fputc((width >> 8) & 0xff, f);
-    fputc(height & 0xff, f);
-    fputc((height >> 8) & 0xff, f);
+    _put(writer, frame->x & 0xff);
+    _put(writer, (frame->x >> 8) & 0xff);
+    _put(writer, frame->y & 0xff);
+    _put(writer, (frame->y >> 8) & 0xff);
 
-    //fputc(0, f); // no local color table, no transparency
-    //fputc(0x80, f); // no local color table, but transparency
+    _put(writer, frame->w & 0xff);          // width and height of image
+    _put(writer, (frame->w >> 8) & 0xff);
+    _put(writer, frame->h & 0xff);
+    _put(writer, (frame->h >> 8) & 0xff);
 
-    fputc(0x80 + BIT_DEPTH - 1, f); // local color table present, 2 ^ bitDepth entries
-    _writePalette(&writer->pal, f);
+    _put(writer, 0x80 + BIT_DEPTH - 1); // local color table present, 2 ^ bitDepth entries
+    _writePalette(writer, &frame->pal);
 
     const int minCodeSize = BIT_DEPTH;
     const uint32_t clearCode = 1 << BIT_DEPTH;
 
-    fputc(minCodeSize, f); // min code size 8 bits
+    _put(writer, minCodeSize); // min code size 8 bits
 
-    GifLzwNode* codetree = tvg::malloc<GifLzwNode*>(sizeof(GifLzwNode)*4096);
+    auto dict = writer->dict;
+    memset(dict, 0, sizeof(uint32_t) * DICT_SIZE);
 
-    memset(codetree, 0, sizeof(GifLzwNode)*4096);
-    int32_t curCode = -1;
+    uint32_t curCode = image[0];   // first value in a run
     uint32_t codeSize = (uint32_t)minCodeSize + 1;
     uint32_t maxCode = clearCode+1;
 
     GifBitStatus stat;
-    stat.byte = 0;
-    stat.bitIndex = 0;
+    stat.bits = 0;
+    stat.bitCount = 0;
     stat.chunkIndex = 0;
 
-    _writeCode(f, &stat, clearCode, codeSize);  // start with a fresh LZW dictionary
-
-    for (uint32_t yy = 0; yy < height; ++yy) {
-        for (uint32_t xx=0; xx<width; ++xx) {
-            // top-left origin
-            uint8_t nextValue = image[(yy*width+xx)*4+3];
-
-            // "loser mode" - no compression, every single code is followed immediately by a clear
-            //WriteCode( f, stat, nextValue, codeSize );
-            //WriteCode( f, stat, 256, codeSize );
-
-            if (curCode < 0) {
-                // first value in a new run
-                curCode = nextValue;
-            } else if (codetree[curCode].m_next[nextValue]) {
-                // current run already in the dictionary
-                curCode = codetree[curCode].m_next[nextValue];
-            } else {
-                // finish the current run, write a code
-                _writeCode(f, &stat, (uint32_t)curCode, codeSize);
-
-                // insert the new run into the dictionary
-                codetree[curCode].m_next[nextValue] = (uint16_t)++maxCode;
-
-                if (maxCode >= (1ul << codeSize)) {
-                    // dictionary entry count has broken a size barrier,
-                    // we need more bits for codes
-                    codeSize++;
-                }
-                if (maxCode == 4095) {
-                    // the dictionary is full, clear it out and begin anew
-                    _writeCode(f, &stat, clearCode, codeSize); // clear tree
-
-                    memset(codetree, 0, sizeof(GifLzwNode)*4096);
-                    codeSize = (uint32_t)(minCodeSize + 1);
-                    maxCode = clearCode+1;
-                }
+    _writeCode(writer, &stat, clearCode, codeSize);  // start with a fresh LZW dictionary
+
+    auto numPixels = frame->w * frame->h;
+    for (uint32_t ii = 1; ii < numPixels; ++ii) {
+        // top-left origin
+        uint8_t nextValue = image[ii];
+
+        auto key = (curCode << 8) | nextValue;
+        uint32_t slot;
+        if (auto code = _dictFind(dict, key, &slot)) {
+            // current run already in the dictionary
+            curCode = code;
+        } else {
+            // finish the current run, write a code
+            _writeCode(writer, &stat, curCode, codeSize);
+
+            // insert the new run into the dictionary
+            dict[slot] = (key << 12) | ++maxCode;
+
+            if (maxCode >= (1ul << codeSize)) {
+                // dictionary entry count has broken a size barrier,
+                // we need more bits for codes
+                codeSize++;
+            }
+            if (maxCode == 4095) {
+                // the dictionary is full, clear it out and begin anew
+                _writeCode(writer, &stat, clearCode, codeSize); // clear tree
 
-                curCode = nextValue;
+                memset(dict, 0, sizeof(uint32_t) * DICT_SIZE);
+                codeSize = (uint32_t)(minCodeSize + 1);
+                maxCode = clearCode+1;
             }
+
+            curCode = nextValue;
         }
     }
 
     // compression footer
-    _writeCode(f, &stat, (uint32_t)curCode, codeSize);
-    _writeCode(f, &stat, clearCode, codeSize);
-    _writeCode(f, &stat, clearCode + 1, (uint32_t)minCodeSize + 1);
+    _writeCode(writer, &stat, curCode, codeSize);
+    _writeCode(writer, &stat, clearCode, codeSize);
+    _writeCode(writer, &stat, clearCode + 1, (uint32_t)minCodeSize + 1);
+
+    // write out the last partial byte and chunk
+    _drainBits(writer, &stat);
+    if (stat.bitCount > 0) {
+        stat.chunk[stat.chunkIndex++] = (uint8_t)stat.bits;
+        if (stat.chunkIndex == 255) _writeChunk(writer, &stat);
+    }
+    if (stat.chunkIndex) _writeChunk(writer, &stat);
 
-    // write out the last partial chunk
-    while (stat.bitIndex) _writeBit(&stat, 0);
-    if (stat.chunkIndex) _writeChunk(f, &stat);
+    _put(writer, 0); // image block terminator
+}
 
-    fputc(0, f); // image block terminator
 
-    tvg::free(codetree);
+// allocate the encoder memory and write out the gif header
+static bool _begin(GifWriter* writer, uint32_t width, uint32_t height, uint32_t delay)
+{
+    writer->failed = false;
+    writer->buffer = tvg::malloc<uint8_t*>(BUFFER_SIZE);
+    writer->count = 0;
+    writer->dict = tvg::malloc<uint32_t*>(sizeof(uint32_t) * DICT_SIZE);
+
+    if (!writer->buffer || !writer->dict) {
+        tvg::free(writer->buffer);
+        tvg::free(writer->dict);
+        writer->buffer = nullptr;
+        writer->dict = nullptr;
+        return false;
+    }
+
+    _put(writer, (const uint8_t*)"GIF89a", 6);
+
+    // screen descriptor
+    _put(writer, width & 0xff);
+    _put(writer, (width >> 8) & 0xff);
+    _put(writer, height & 0xff);
+    _put(writer, (height >> 8) & 0xff);
+
+    _put(writer, 0xf0);  // there is an unsorted global color table of 2 entries
+    _put(writer, 0);     // background color
+    _put(writer, 0);     // pixels are square (we need to specify this because it's 1989)
+
+    // now the "global" palette (really just a dummy palette)
+    // color 0: black
+    _put(writer, 0);
+    _put(writer, 0);
+    _put(writer, 0);
+    // color 1: also black
+    _put(writer, 0);
+    _put(writer, 0);
+    _put(writer, 0);
+
+    if(delay != 0) {
+        // animation header
+        _put(writer, 0x21); // extension
+        _put(writer, 0xff); // application specific
+        _put(writer, 11); // length 11
+        _put(writer, (const uint8_t*)"NETSCAPE2.0", 11); // yes, really
+        _put(writer, 3); // 3 bytes of NETSCAPE2.0 data
+
+        _put(writer, 1); // JUST BECAUSE
+        _put(writer, 0); // loop infinitely (byte 0)
+        _put(writer, 0); // loop infinitely (byte 1)
+
+        _put(writer, 0); // block terminator
+    }
+    return true;
 }
 
 
@@ -549,79 +870,73 @@ bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t
 #endif
     if (!writer->f) return false;
 
-    writer->firstFrame = true;
+    writer->func = nullptr;
+
+    if (!_begin(writer, width, height, delay)) {
+        fclose(writer->f);
+        writer->f = NULL;
+        return false;
+    }
+    return true;
+}
 
-    // allocate
-    writer->oldImage = tvg::malloc<uint8_t*>(width*height*4);
-    writer->tmpImage = tvg::malloc<uint8_t*>(width*height*4);
 
-    fputs("GIF89a", writer->f);
+bool gifBegin(GifWriter* writer, tvg::SaveFunc func, void* data, uint32_t width, uint32_t height, uint32_t delay)
+{
+    if (!func) return false;
 
-    // screen descriptor
-    fputc(width & 0xff, writer->f);
-    fputc((width >> 8) & 0xff, writer->f);
-    fputc(height & 0xff, writer->f);
-    fputc((height >> 8) & 0xff, writer->f);
+    writer->f = NULL;
+    writer->func = func;
+    writer->data = data;
 
-    fputc(0xf0, writer->f);  // there is an unsorted global color table of 2 entries
-    fputc(0, writer->f);     // background color
-    fputc(0, writer->f);     // pixels are square (we need to specify this because it's 1989)
+    return _begin(writer, width, height, delay);
+}
 
-    // now the "global" palette (really just a dummy palette)
-    // color 0: black
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    // color 1: also black
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    fputc(0, writer->f);
 
-    if(delay != 0) {
-        // animation header
-        fputc(0x21, writer->f); // extension
-        fputc(0xff, writer->f); // application specific
-        fputc(11, writer->f); // length 11
-        fputs("NETSCAPE2.0", writer->f); // yes, really
-        fputc(3, writer->f); // 3 bytes of NETSCAPE2.0 data
+void gifQuantize(GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, uint32_t height, bool transparent)
+{
+    //unused entries must not depend on the former use of the frame
+    memset(&frame->pal, 0, sizeof(GifPalette));
 
-        fputc(1, writer->f); // JUST BECAUSE
-        fputc(0, writer->f); // loop infinitely (byte 0)
-        fputc(0, writer->f); // loop infinitely (byte 1)
+    _changedRect(frame, lastImage, image, width, height, transparent);
 
-        fputc(0, writer->f); // block terminator
+    if (frame->histogram) {
+        _makeHistogramPalette(frame, lastImage, image, width, transparent);
+        _thresholdHistogramImage(frame, lastImage, image, width, transparent);
+    } else {
+        _makePalette(frame, lastImage, image, width, BIT_DEPTH, transparent);
+        _thresholdImage(frame, lastImage, image, width, transparent);
     }
-
-    return true;
 }
 
 
-bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+bool gifWriteFrame(GifWriter* writer, const GifFrame* frame, uint32_t delay, bool transparent)
 {
-    if (!writer->f) return false;
+    if (!writer->buffer || writer->failed) return false;
 
-    const uint8_t* oldImage = writer->firstFrame? NULL : writer->oldImage;
-    writer->firstFrame = false;
+    _writeLzwImage(writer, frame, delay, transparent);
 
-    _makePalette(writer, oldImage, image, width, height, 8, transparent);
-    _thresholdImage(writer, oldImage, image, width, height, transparent);
-    _writeLzwImage(writer, width, height, delay, transparent);
+    // stream out the frame
+    if (!writer->f) _flush(writer);
 
-    return true;
+    return !writer->failed;
 }
 
 
 bool gifEnd(GifWriter* writer)
 {
-    if (!writer->f) return false;
+    if (!writer->buffer) return false;
 
-    fputc(0x3b, writer->f); // end of file
-    fclose(writer->f);
-    tvg::free(writer->oldImage);
-    tvg::free(writer->tmpImage);
+    _put(writer, 0x3b); // end of file
+    _flush(writer);
+    if (writer->f) fclose(writer->f);
+    tvg::free(writer->buffer);
+    tvg::free(writer->dict);
 
     writer->f = NULL;
-    writer->oldImage = NULL;
+    writer->func = nullptr;
+    writer->buffer = NULL;
+    writer->dict = NULL;
 
-    return true;
+    return !writer->failed;
 }
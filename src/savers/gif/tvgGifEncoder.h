@@ -25,6 +25,7 @@
 #define TVG_GIF_ENCODER_H
 
 #include "tvgCommon.h"
+#include "tvgSaveModule.h"
 
 typedef struct
 {
@@ -42,11 +43,28 @@ typedef struct
 
 typedef struct
 {
-    FILE* f;
-    uint8_t* oldImage;
-    uint8_t* tmpImage;
     GifPalette pal;
-    bool firstFrame;
+    uint8_t* index;     // palette index per pixel of the frame area (width * height at most)
+    uint8_t* tmpImage;  // scratch for the median split palette generation (width * height * 4)
+    uint32_t* histogram;  // zero-filled scratch for the histogram quantizer (GIF_HISTOGRAM_SIZE), null: use the median split
+    uint8_t* lut;       // rgb to palette index per histogram bin (GIF_LUT_SIZE)
+    uint32_t x, y, w, h;  // the area of the frame to encode in the canvas
+} GifFrame;
+
+// the buffer sizes of the histogram quantizer in bytes, 5 bits per channel
+#define GIF_LUT_SIZE (1 << 15)
+#define GIF_HISTOGRAM_SIZE (GIF_LUT_SIZE * (sizeof(uint32_t) + 3 * sizeof(uint64_t)) + GIF_LUT_SIZE * 2 * sizeof(uint16_t))
+
+
+typedef struct
+{
+    FILE* f;            // output file, or
+    tvg::SaveFunc func; // output function with its data
+    void* data;
+    uint8_t* buffer;    // output is gathered here before reaching the file or the function
+    uint32_t count;     // bytes in the buffer
+    uint32_t* dict;     // hashed LZW dictionary, reused by the frames
+    bool failed;        // the output couldn't be written
 } GifWriter;
 
 
@@ -55,14 +73,24 @@ typedef struct
 // The delay value is the time between frames in hundredths of a second - note that not all viewers pay much attention to this value.
 bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t delay);
 
-// Writes out a new frame to a GIF in progress.
-// The GIFWriter should have been created by GIFBegin.
-// AFAIK, it is legal to use different bit depths for different frames of an image -
-// this may be handy to save bits in animations that don't change much.
-bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay, bool transparent);
+// Same as above, but the data is passed to the given function. It's flushed every frame for streaming.
+bool gifBegin(GifWriter* writer, tvg::SaveFunc func, void* data, uint32_t width, uint32_t height, uint32_t delay);
+
+// Builds the palette and the palette indices of a frame.
+// With the histogram, a median cut runs over the 5-bit color histogram and the pixels are mapped by a lookup table,
+// otherwise the median split runs over the pixels and each pixel searches its nearest color. The former is much faster, the latter is more accurate.
+// The delta is computed against the previous source image (lastImage, null for the first frame),
+// so the frames are independent of each other's encoding and can be quantized concurrently.
+// Only the area that differs from the previous frame is encoded, it's given by the x, y, w, h of the frame.
+void gifQuantize(GifFrame* frame, const uint8_t* lastImage, const uint8_t* image, uint32_t width, uint32_t height, bool transparent);
+
+// Writes out a quantized frame to a GIF in progress.
+// The GIFWriter should have been created by GIFBegin and the frames must be written in order.
+bool gifWriteFrame(GifWriter* writer, const GifFrame* frame, uint32_t delay, bool transparent);
 
 
-// Writes the EOF code, closes the file handle, and frees temp memory used by a GIF.
+// Writes the EOF code, flushes the output, closes the file handle and frees the memory used by the GifWriter.
+// Returns false if any of the output couldn't be written.
 // Many if not most viewers will still display a GIF properly if the EOF code is missing,
 // but it's still a good idea to write it out.
 bool gifEnd(GifWriter* writer);
@@ -20,136 +20,93 @@
  * SOFTWARE.
  */
 
-#include <cstring>
-#include <memory>
-#include "tvgStr.h"
-#include "tvgGifEncoder.h"
 #include "tvgGifSaver.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
-void GifSaver::run(unsigned tid)
-{
-    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
-    if (!canvas) return;
-
-    auto w = static_cast<uint32_t>(vsize[0]);
-    auto h = static_cast<uint32_t>(vsize[1]);
-
-    buffer = tvg::realloc<uint32_t*>(buffer, sizeof(uint32_t) * w * h);
-    canvas->target(buffer, w, w, h, ColorSpace::ABGR8888S);
-    canvas->push(bg);
-    canvas->push(animation->picture());
-
-    //use the default fps
-    if (fps > 60.0f) fps = 60.0f;   // just in case
-    else if (tvg::zero(fps) || fps < 0.0f) {
-        fps = (animation->totalFrame() / animation->duration());
-    }
+//below this quality, the frames are quantized by the histogram for the speed
+#define GIF_FAST_QUALITY 90
 
-    auto delay = (1.0f / fps);
-    auto transparent = bg ? false : true;
+//the frame delay of gif is in hundredths of a second
+#define GIF_MAX_FPS 60
 
-    GifWriter writer;
-    if (!gifBegin(&writer, path, w, h, uint32_t(delay * 100.f))) {
-        TVGERR("GIF_SAVER", "Failed gif encoding");
-        return;
-    }
-
-    auto duration = animation->duration();
 
-    for (auto p = 0.0f; p < duration; p += delay) {
-        auto frameNo = animation->totalFrame() * (p / duration);
-        animation->frame(frameNo);
-        canvas->update();
-        if (canvas->draw(true) == tvg::Result::Success) {
-            canvas->sync();
-        }
-        if (!gifWriteFrame(&writer, reinterpret_cast<uint8_t*>(buffer), w, h, uint32_t(delay * 100.0f), transparent)) {
-            TVGERR("GIF_SAVER", "Failed gif encoding");
-            break;
+bool GifSaver::begin()
+{
+    fast = quality < GIF_FAST_QUALITY;
+
+    frames = tvg::calloc<GifFrame*>(slotCnt, sizeof(GifFrame));
+    if (!frames) return false;
+
+    for (uint32_t i = 0; i < slotCnt; ++i) {
+        frames[i].index = tvg::malloc<uint8_t*>(w * h);
+        if (!frames[i].index) return false;
+        if (fast) {
+            frames[i].histogram = tvg::calloc<uint32_t*>(1, GIF_HISTOGRAM_SIZE);
+            frames[i].lut = tvg::malloc<uint8_t*>(GIF_LUT_SIZE);
+            if (!frames[i].histogram || !frames[i].lut) return false;
+        } else {
+            frames[i].tmpImage = tvg::malloc<uint8_t*>(w * h * 4);
+            if (!frames[i].tmpImage) return false;
         }
     }
 
-    if (!gifEnd(&writer)) TVGERR("GIF_SAVER", "Failed gif encoding");
-
-    if (bg) {
-        bg->unref();
-        bg = nullptr;
-    }
+    auto delay = uint32_t(this->delay * 100.0f);
+    return path ? gifBegin(&writer, path, w, h, delay) : gifBegin(&writer, func, data, w, h, delay);
 }
 
 
-/************************************************************************/
-/* External Class Implementation                                        */
-/************************************************************************/
-
-GifSaver::~GifSaver()
+void GifSaver::encode(uint32_t slot, const uint32_t* image, const uint32_t* prev)
 {
-    close();
+    gifQuantize(&frames[slot], reinterpret_cast<const uint8_t*>(prev), reinterpret_cast<const uint8_t*>(image), w, h, !bg);
 }
 
 
-bool GifSaver::close()
+bool GifSaver::write(uint32_t slot)
 {
-    this->done();
-
-    if (bg) bg->unref();
-    bg = nullptr;
-
-    //animation holds the picture, it must be 1 at the bottom.
-    if (animation && animation->picture()->refCnt() <= 1) delete(animation);
-    animation = nullptr;
-
-    tvg::free(path);
-    path = nullptr;
-
-    tvg::free(buffer);
-    buffer = nullptr;
-
-    return true;
+    return gifWriteFrame(&writer, &frames[slot], uint32_t(delay * 100.0f), !bg);
 }
 
 
-bool GifSaver::save(TVG_UNUSED Paint* paint, TVG_UNUSED Paint* bg, TVG_UNUSED const char* filename, TVG_UNUSED uint32_t quality)
+bool GifSaver::end()
 {
-    TVGLOG("GIF_SAVER", "Paint is not supported.");
-    return false;
+    return gifEnd(&writer);
 }
 
 
-bool GifSaver::save(Animation* animation, Paint* bg, const char* filename, TVG_UNUSED uint32_t quality, uint32_t fps)
+void GifSaver::clear()
 {
-    close();
-
-    auto picture = animation->picture();
-    float x, y;
-    x = y = 0;
-    picture->bounds(&x, &y, &vsize[0], &vsize[1]);
+    if (!frames) return;
 
-    //cut off the negative space
-    if (x < 0) vsize[0] += x;
-    if (y < 0) vsize[1] += y;
-
-    if (vsize[0] < FLOAT_EPSILON || vsize[1] < FLOAT_EPSILON) {
-        TVGLOG("GIF_SAVER", "Saving animation(%p) has zero view size.", animation);
-        return false;
+    for (uint32_t i = 0; i < slotCnt; ++i) {
+        tvg::free(frames[i].index);
+        tvg::free(frames[i].tmpImage);
+        tvg::free(frames[i].histogram);
+        tvg::free(frames[i].lut);
     }
+    tvg::free(frames);
+    frames = nullptr;
+}
 
-    if (!filename) return false;
-    this->path = duplicate(filename);
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
 
-    this->animation = animation;
+GifSaver::~GifSaver()
+{
+    close();
+}
 
-    if (bg) {
-        bg->ref();
-        this->bg = bg;
-    }
-    this->fps = static_cast<float>(fps);
 
-    TaskScheduler::request(this);
+bool GifSaver::save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps)
+{
+    return FrameSaver::save(animation, bg, filename, quality, fps > GIF_MAX_FPS ? GIF_MAX_FPS : fps);
+}
 
-    return true;
+
+bool GifSaver::save(Animation* animation, Paint* bg, SaveFunc func, void* data, uint32_t quality, uint32_t fps)
+{
+    return FrameSaver::save(animation, bg, func, data, quality, fps > GIF_MAX_FPS ? GIF_MAX_FPS : fps);
 }
@@ -23,30 +23,32 @@
 #ifndef _TVG_GIFSAVER_H_
 #define _TVG_GIFSAVER_H_
 
-#include "tvgSaveModule.h"
-#include "tvgTaskScheduler.h"
+#include "tvgFrameSaver.h"
+#include "tvgGifEncoder.h"
 
 namespace tvg
 {
 
-class GifSaver : public SaveModule, public Task
+class GifSaver : public FrameSaver
 {
 private:
-    uint32_t* buffer = nullptr;
-    Animation* animation = nullptr;
-    Paint* bg = nullptr;
-    char *path = nullptr;
-    float vsize[2] = {0.0f, 0.0f};
-    float fps = 0.0f;
+    GifWriter writer{};
+    GifFrame* frames = nullptr;  //quantized frame per slot
+    bool fast = false;           //quantize with the histogram
 
-    void run(unsigned tid) override;
+    bool begin() override;
+    void encode(uint32_t slot, const uint32_t* image, const uint32_t* prev) override;
+    bool write(uint32_t slot) override;
+    bool end() override;
+    void clear() override;
 
 public:
+    GifSaver() : FrameSaver("GIF_SAVER", ColorSpace::ABGR8888S) {}
     ~GifSaver();
 
-    bool save(Paint* paint, Paint* bg, const char* filename, uint32_t quality) override;
+    using FrameSaver::save;
     bool save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps) override;
-    bool close() override;
+    bool save(Animation* animation, Paint* bg, SaveFunc func, void* data, uint32_t quality, uint32_t fps) override;
 };
 
 }
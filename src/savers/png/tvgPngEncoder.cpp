@@ -0,0 +1,874 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+#include "tvgPngEncoder.h"
+
+
+#define BUFFER_SIZE (64 * 1024)      // the max size of an IDAT chunk
+
+#define HASH_BITS 15                 // hash chains of the 3 bytes sequences
+#define HASH_SIZE (1 << HASH_BITS)
+#define WINDOW_MASK (PNG_WINDOW_SIZE - 1)
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define TOO_FAR 4096                 // a 3 bytes match farther than this costs more than the literals
+#define BLOCK_SYMBOLS (16 * 1024)    // symbols per deflate block
+#define STORED_MAX 65535             // the max size of a stored block
+
+#define LITERALS 286
+#define DISTANCES 30
+#define CODE_LENGTHS 19
+
+
+// the lz77 parameters per level, same as zlib
+static const struct
+{
+    uint16_t good;    // reduce the search when the previous match is this long
+    uint16_t lazy;    // don't look for a better match when the previous match is this long, 0: greedy
+    uint16_t nice;    // stop the search when a match is this long
+    uint16_t chain;   // the max hash chain to search
+} LEVELS[10] = {
+    {0, 0, 0, 0}, {4, 0, 8, 4}, {4, 0, 16, 8}, {4, 0, 32, 32}, {4, 4, 16, 16},
+    {8, 16, 32, 32}, {8, 16, 128, 128}, {8, 32, 128, 256}, {32, 128, 258, 1024}, {32, 258, 258, 4096}
+};
+
+
+// the order of the code length codes in the dynamic block header
+static const uint8_t CODE_LENGTH_ORDER[CODE_LENGTHS] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+
+typedef struct
+{
+    PngStream* stream;
+    int32_t* head;       // the last position of each hash, -1 if none
+    int32_t* prev;       // the previous position of the same hash, per window position
+    uint32_t* syms;      // the symbols of the block: (distance << 16) | length, or a literal with zero distance
+    uint32_t count;      // symbols in the block
+    uint32_t blockStart; // the data of the block
+    uint32_t blockSize;
+    uint32_t litFreq[LITERALS];
+    uint32_t distFreq[DISTANCES];
+} PngDeflater;
+
+
+typedef struct
+{
+    uint32_t freq;
+    uint16_t sym;
+} PngSymFreq;
+
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+//branchless for the vectorization
+static inline uint8_t _paeth(int a, int b, int c)
+{
+    auto pa = abs(b - c);
+    auto pb = abs(a - c);
+    auto pc = abs(a + b - 2 * c);
+    auto ab = pb < pa ? b : a;
+    auto pab = pb < pa ? pb : pa;
+    return pc < pab ? c : ab;
+}
+
+
+static inline uint32_t _cost(uint8_t v)
+{
+    return abs(int8_t(v));
+}
+
+
+//pick the filter of a row by the minimum sum of absolute differences, the usual heuristic of the png encoders
+static uint8_t _pickFilter(const uint8_t* cur, const uint8_t* up, uint32_t size)
+{
+    uint32_t sum[5] = {0, 0, 0, 0, 0};
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        sum[0] += _cost(cur[i]);
+        sum[1] += _cost(cur[i]);
+        sum[2] += _cost(cur[i] - up[i]);
+        sum[3] += _cost(cur[i] - (up[i] >> 1));
+        sum[4] += _cost(cur[i] - up[i]);
+    }
+    for (uint32_t i = 4; i < size; ++i) {
+        auto a = cur[i - 4];
+        auto b = up[i];
+        auto c = up[i - 4];
+        sum[0] += _cost(cur[i]);
+        sum[1] += _cost(cur[i] - a);
+        sum[2] += _cost(cur[i] - b);
+        sum[3] += _cost(cur[i] - ((a + b) >> 1));
+        sum[4] += _cost(cur[i] - _paeth(a, b, c));
+    }
+
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < 5; ++i) {
+        if (sum[i] < sum[best]) best = i;
+    }
+    return best;
+}
+
+
+static void _filterRow(const uint8_t* cur, const uint8_t* up, uint32_t size, uint8_t filter, uint8_t* out)
+{
+    *out++ = filter;
+
+    switch (filter) {
+        case 0: {
+            memcpy(out, cur, size);
+            break;
+        }
+        case 1: {
+            for (uint32_t i = 0; i < 4; ++i) out[i] = cur[i];
+            for (uint32_t i = 4; i < size; ++i) out[i] = cur[i] - cur[i - 4];
+            break;
+        }
+        case 2: {
+            for (uint32_t i = 0; i < size; ++i) out[i] = cur[i] - up[i];
+            break;
+        }
+        case 3: {
+            for (uint32_t i = 0; i < 4; ++i) out[i] = cur[i] - (up[i] >> 1);
+            for (uint32_t i = 4; i < size; ++i) out[i] = cur[i] - ((cur[i - 4] + up[i]) >> 1);
+            break;
+        }
+        default: {
+            for (uint32_t i = 0; i < 4; ++i) out[i] = cur[i] - up[i];
+            for (uint32_t i = 4; i < size; ++i) out[i] = cur[i] - _paeth(cur[i - 4], up[i], up[i - 4]);
+            break;
+        }
+    }
+}
+
+
+static inline uint32_t _log2(uint32_t v)
+{
+    uint32_t r = 0;
+    while (v >>= 1) ++r;
+    return r;
+}
+
+
+//length (3 ~ 258) to its code (257 ~ 285) and extra bits
+static inline uint32_t _lengthCode(uint32_t len, uint32_t* bits, uint32_t* extra)
+{
+    auto x = len - MIN_MATCH;
+    if (x < 8 || x == 255) {
+        *bits = *extra = 0;
+        return x < 8 ? 257 + x : 285;
+    }
+    auto nb = _log2(x);
+    auto top = (x >> (nb - 2)) & 3;
+    *bits = nb - 2;
+    *extra = x - ((4 + top) << (nb - 2));
+    return 257 + 4 * (nb - 1) + top;
+}
+
+
+//distance (1 ~ 32768) to its code (0 ~ 29) and extra bits
+static inline uint32_t _distCode(uint32_t dist, uint32_t* bits, uint32_t* extra)
+{
+    auto x = dist - 1;
+    if (x < 4) {
+        *bits = *extra = 0;
+        return x;
+    }
+    auto nb = _log2(x);
+    auto top = (x >> (nb - 1)) & 1;
+    *bits = nb - 1;
+    *extra = x - ((2 + top) << (nb - 1));
+    return 2 * nb + top;
+}
+
+
+static void _reserve(PngStream* stream, uint32_t size)
+{
+    if (stream->size + size <= stream->reserved) return;
+    stream->reserved = (stream->size + size) * 2;
+    stream->data = tvg::realloc<uint8_t*>(stream->data, stream->reserved);
+}
+
+
+//the bits are packed least significant bit first, the room must be reserved before
+static inline void _putBits(PngStream* stream, uint32_t value, uint32_t count)
+{
+    stream->bits |= uint64_t(value) << stream->bitCount;
+    stream->bitCount += count;
+    if (stream->bitCount >= 32) {
+        auto p = stream->data + stream->size;
+        p[0] = uint8_t(stream->bits);
+        p[1] = uint8_t(stream->bits >> 8);
+        p[2] = uint8_t(stream->bits >> 16);
+        p[3] = uint8_t(stream->bits >> 24);
+        stream->size += 4;
+        stream->bits >>= 32;
+        stream->bitCount -= 32;
+    }
+}
+
+
+//pad the pending bits to the byte boundary and write them out
+static void _alignBits(PngStream* stream)
+{
+    while (stream->bitCount > 0) {
+        stream->data[stream->size++] = uint8_t(stream->bits);
+        stream->bits >>= 8;
+        stream->bitCount = stream->bitCount > 8 ? stream->bitCount - 8 : 0;
+    }
+    stream->bits = 0;
+}
+
+
+//the huffman code lengths of the minimum redundancy, computed in place over the frequencies in ascending order (Moffat & Katajainen)
+static void _minimumRedundancy(PngSymFreq* a, int n)
+{
+    if (n == 1) {
+        a[0].freq = 1;
+        return;
+    }
+
+    a[0].freq += a[1].freq;
+    int root = 0, leaf = 2;
+    for (int next = 1; next < n - 1; ++next) {
+        if (leaf >= n || a[root].freq < a[leaf].freq) {
+            a[next].freq = a[root].freq;
+            a[root++].freq = next;
+        } else a[next].freq = a[leaf++].freq;
+
+        if (leaf >= n || (root < next && a[root].freq < a[leaf].freq)) {
+            a[next].freq += a[root].freq;
+            a[root++].freq = next;
+        } else a[next].freq += a[leaf++].freq;
+    }
+
+    a[n - 2].freq = 0;
+    for (int next = n - 3; next >= 0; --next) a[next].freq = a[a[next].freq].freq + 1;
+
+    int avail = 1, used = 0, depth = 0, next = n - 1;
+    root = n - 2;
+    while (avail > 0) {
+        while (root >= 0 && int(a[root].freq) == depth) {
+            ++used;
+            --root;
+        }
+        while (avail > used) {
+            a[next--].freq = depth;
+            --avail;
+        }
+        avail = 2 * used;
+        ++depth;
+        used = 0;
+    }
+}
+
+
+//the length limited huffman code lengths of the symbols
+static void _buildLengths(const uint32_t* freq, uint32_t n, uint32_t maxBits, uint8_t* lens)
+{
+    PngSymFreq syms[LITERALS];
+    int used = 0;
+
+    memset(lens, 0, n);
+
+    //insertion sort in ascending order of the frequencies
+    for (uint32_t i = 0; i < n; ++i) {
+        if (freq[i] == 0) continue;
+        auto j = used++;
+        while (j > 0 && syms[j - 1].freq > freq[i]) {
+            syms[j] = syms[j - 1];
+            --j;
+        }
+        syms[j] = {freq[i], uint16_t(i)};
+    }
+    if (used == 0) return;
+
+    _minimumRedundancy(syms, used);
+
+    //fold the too long codes into the max length keeping the kraft sum
+    uint32_t counts[33] = {0};
+    for (int i = 0; i < used; ++i) ++counts[syms[i].freq < 32 ? syms[i].freq : 32];
+    for (uint32_t i = maxBits + 1; i <= 32; ++i) counts[maxBits] += counts[i];
+
+    uint32_t total = 0;
+    for (uint32_t i = maxBits; i > 0; --i) total += counts[i] << (maxBits - i);
+    while (total != (1u << maxBits)) {
+        --counts[maxBits];
+        for (auto i = maxBits - 1; i > 0; --i) {
+            if (counts[i]) {
+                --counts[i];
+                counts[i + 1] += 2;
+                break;
+            }
+        }
+        --total;
+    }
+
+    //the more frequent, the shorter
+    auto j = used;
+    for (uint32_t bits = 1; bits <= maxBits; ++bits) {
+        for (auto c = counts[bits]; c > 0; --c) lens[syms[--j].sym] = bits;
+    }
+}
+
+
+//the canonical huffman codes of the lengths, bit reversed for the lsb first packing
+static void _buildCodes(const uint8_t* lens, uint32_t n, uint16_t* codes)
+{
+    uint32_t counts[16] = {0};
+    uint32_t next[16];
+
+    for (uint32_t i = 0; i < n; ++i) ++counts[lens[i]];
+    counts[0] = 0;
+
+    uint32_t code = 0;
+    for (uint32_t bits = 1; bits < 16; ++bits) {
+        code = (code + counts[bits - 1]) << 1;
+        next[bits] = code;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        if (lens[i] == 0) continue;
+        auto c = next[lens[i]]++;
+        uint32_t r = 0;
+        for (uint32_t b = 0; b < lens[i]; ++b) {
+            r = (r << 1) | (c & 1);
+            c >>= 1;
+        }
+        codes[i] = r;
+    }
+}
+
+
+//deflate requires at least two codes to make a complete tree
+static void _completeTree(uint32_t* freq, uint32_t n)
+{
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (freq[i]) ++used;
+    }
+    for (uint32_t i = 0; used < 2; ++i) {
+        if (freq[i] == 0) {
+            freq[i] = 1;
+            ++used;
+        }
+    }
+}
+
+
+static void _writeStored(PngStream* stream, const uint8_t* data, uint32_t size, bool final)
+{
+    do {
+        auto len = size < STORED_MAX ? size : STORED_MAX;
+        size -= len;
+        _putBits(stream, (final && size == 0) ? 1 : 0, 3);
+        _alignBits(stream);
+        auto p = stream->data + stream->size;
+        p[0] = len & 0xff;
+        p[1] = len >> 8;
+        p[2] = ~len & 0xff;
+        p[3] = (~len >> 8) & 0xff;
+        if (len > 0) memcpy(p + 4, data, len);
+        stream->size += 4 + len;
+        data += len;
+    } while (size > 0);
+}
+
+
+static void _writeSymbols(PngStream* stream, const PngDeflater* d, const uint8_t* litLens, const uint16_t* litCodes, const uint8_t* distLens, const uint16_t* distCodes)
+{
+    uint32_t bits, extra;
+
+    for (uint32_t i = 0; i < d->count; ++i) {
+        auto sym = d->syms[i];
+        auto dist = sym >> 16;
+        if (dist == 0) {
+            _putBits(stream, litCodes[sym], litLens[sym]);
+            continue;
+        }
+        auto code = _lengthCode(sym & 0xffff, &bits, &extra);
+        _putBits(stream, litCodes[code], litLens[code]);
+        if (bits) _putBits(stream, extra, bits);
+        code = _distCode(dist, &bits, &extra);
+        _putBits(stream, distCodes[code], distLens[code]);
+        if (bits) _putBits(stream, extra, bits);
+    }
+    _putBits(stream, litCodes[256], litLens[256]);
+}
+
+
+//write out the symbols of the block in the smallest of the dynamic, fixed and stored blocks
+static void _writeBlock(PngDeflater* d, const uint8_t* data, bool final)
+{
+    auto stream = d->stream;
+
+    //the worst case is the stored one
+    _reserve(stream, d->blockSize + (d->blockSize / STORED_MAX + 1) * 5 + 8);
+
+    d->litFreq[256] = 1;
+    _completeTree(d->litFreq, LITERALS);
+    _completeTree(d->distFreq, DISTANCES);
+
+    uint8_t litLens[LITERALS], distLens[DISTANCES];
+    _buildLengths(d->litFreq, LITERALS, 15, litLens);
+    _buildLengths(d->distFreq, DISTANCES, 15, distLens);
+
+    //the code lengths of both trees, run length encoded
+    uint32_t nlit = LITERALS, ndist = DISTANCES;
+    while (nlit > 257 && litLens[nlit - 1] == 0) --nlit;
+    while (ndist > 1 && distLens[ndist - 1] == 0) --ndist;
+
+    uint8_t lens[LITERALS + DISTANCES];
+    memcpy(lens, litLens, nlit);
+    memcpy(lens + nlit, distLens, ndist);
+    auto total = nlit + ndist;
+
+    uint8_t rle[LITERALS + DISTANCES][2];   //code, extra
+    uint32_t rleCnt = 0;
+    uint32_t clFreq[CODE_LENGTHS] = {0};
+
+    for (uint32_t i = 0; i < total;) {
+        auto v = lens[i];
+        uint32_t run = 1;
+        while (i + run < total && lens[i + run] == v) ++run;
+        i += run;
+        if (v == 0) {
+            while (run >= 11) {
+                auto r = run < 138 ? run : 138;
+                rle[rleCnt][0] = 18;
+                rle[rleCnt++][1] = r - 11;
+                run -= r;
+            }
+            if (run >= 3) {
+                rle[rleCnt][0] = 17;
+                rle[rleCnt++][1] = run - 3;
+                run = 0;
+            }
+        } else {
+            rle[rleCnt][0] = v;
+            rle[rleCnt++][1] = 0;
+            --run;
+            while (run >= 3) {
+                auto r = run < 6 ? run : 6;
+                rle[rleCnt][0] = 16;
+                rle[rleCnt++][1] = r - 3;
+                run -= r;
+            }
+        }
+        while (run-- > 0) {
+            rle[rleCnt][0] = v;
+            rle[rleCnt++][1] = 0;
+        }
+    }
+    for (uint32_t i = 0; i < rleCnt; ++i) ++clFreq[rle[i][0]];
+
+    uint8_t clLens[CODE_LENGTHS];
+    _buildLengths(clFreq, CODE_LENGTHS, 7, clLens);
+    uint32_t ncl = CODE_LENGTHS;
+    while (ncl > 4 && clLens[CODE_LENGTH_ORDER[ncl - 1]] == 0) --ncl;
+
+    //compare the block sizes in bits, the extra bits of the symbols are the same
+    uint64_t dynamicBits = 14 + ncl * 3, fixedBits = 0;
+    for (uint32_t i = 0; i < rleCnt; ++i) {
+        auto c = rle[i][0];
+        dynamicBits += clLens[c] + (c == 16 ? 2 : (c == 17 ? 3 : (c == 18 ? 7 : 0)));
+    }
+    for (uint32_t i = 0; i < LITERALS; ++i) {
+        if (d->litFreq[i] == 0) continue;
+        dynamicBits += uint64_t(d->litFreq[i]) * litLens[i];
+        fixedBits += uint64_t(d->litFreq[i]) * (i < 144 ? 8 : (i < 256 ? 9 : (i < 280 ? 7 : 8)));
+    }
+    uint64_t extraBits = 0;
+    for (uint32_t i = 0; i < DISTANCES; ++i) {
+        dynamicBits += uint64_t(d->distFreq[i]) * distLens[i];
+        fixedBits += uint64_t(d->distFreq[i]) * 5;
+        if (i >= 4) extraBits += uint64_t(d->distFreq[i]) * ((i >> 1) - 1);
+    }
+    for (uint32_t i = 265; i < 285; ++i) extraBits += uint64_t(d->litFreq[i]) * ((i - 261) >> 2);
+    auto storedBits = uint64_t(d->blockSize + (d->blockSize / STORED_MAX + 1) * 5) * 8;
+
+    if (storedBits <= dynamicBits + extraBits && storedBits <= fixedBits + extraBits) {
+        _writeStored(stream, data + d->blockStart, d->blockSize, final);
+    } else if (fixedBits <= dynamicBits) {
+        uint8_t fixedLitLens[288], fixedDistLens[DISTANCES];
+        uint16_t litCodes[288], distCodes[DISTANCES];
+        for (uint32_t i = 0; i < 288; ++i) fixedLitLens[i] = i < 144 ? 8 : (i < 256 ? 9 : (i < 280 ? 7 : 8));
+        memset(fixedDistLens, 5, DISTANCES);
+        _buildCodes(fixedLitLens, 288, litCodes);
+        _buildCodes(fixedDistLens, DISTANCES, distCodes);
+        _putBits(stream, final ? 1 : 0, 1);
+        _putBits(stream, 1, 2);
+        _writeSymbols(stream, d, fixedLitLens, litCodes, fixedDistLens, distCodes);
+    } else {
+        uint16_t litCodes[LITERALS], distCodes[DISTANCES], clCodes[CODE_LENGTHS];
+        _buildCodes(litLens, LITERALS, litCodes);
+        _buildCodes(distLens, DISTANCES, distCodes);
+        _buildCodes(clLens, CODE_LENGTHS, clCodes);
+        _putBits(stream, final ? 1 : 0, 1);
+        _putBits(stream, 2, 2);
+        _putBits(stream, nlit - 257, 5);
+        _putBits(stream, ndist - 1, 5);
+        _putBits(stream, ncl - 4, 4);
+        for (uint32_t i = 0; i < ncl; ++i) _putBits(stream, clLens[CODE_LENGTH_ORDER[i]], 3);
+        for (uint32_t i = 0; i < rleCnt; ++i) {
+            auto c = rle[i][0];
+            _putBits(stream, clCodes[c], clLens[c]);
+            if (c == 16) _putBits(stream, rle[i][1], 2);
+            else if (c == 17) _putBits(stream, rle[i][1], 3);
+            else if (c == 18) _putBits(stream, rle[i][1], 7);
+        }
+        _writeSymbols(stream, d, litLens, litCodes, distLens, distCodes);
+    }
+
+    d->blockStart += d->blockSize;
+    d->blockSize = 0;
+    d->count = 0;
+    memset(d->litFreq, 0, sizeof(d->litFreq));
+    memset(d->distFreq, 0, sizeof(d->distFreq));
+}
+
+
+static inline void _literal(PngDeflater* d, const uint8_t* data, uint8_t c)
+{
+    if (d->count == BLOCK_SYMBOLS) _writeBlock(d, data, false);
+    d->syms[d->count++] = c;
+    ++d->litFreq[c];
+    ++d->blockSize;
+}
+
+
+static inline void _match(PngDeflater* d, const uint8_t* data, uint32_t len, uint32_t dist)
+{
+    if (d->count == BLOCK_SYMBOLS) _writeBlock(d, data, false);
+    d->syms[d->count++] = (dist << 16) | len;
+    uint32_t bits, extra;
+    ++d->litFreq[_lengthCode(len, &bits, &extra)];
+    ++d->distFreq[_distCode(dist, &bits, &extra)];
+    d->blockSize += len;
+}
+
+
+//add the position to the hash chains, returns the previous position of the same hash
+static inline int32_t _insert(PngDeflater* d, const uint8_t* data, uint32_t pos)
+{
+    auto key = (uint32_t(data[pos]) << 16) | (uint32_t(data[pos + 1]) << 8) | data[pos + 2];
+    auto hash = (key * 2654435761u) >> (32 - HASH_BITS);
+    auto cand = d->head[hash];
+    d->prev[pos & WINDOW_MASK] = cand;
+    d->head[hash] = pos;
+    return cand;
+}
+
+
+//the longest match at the position along its hash chain, longer than the given length
+static uint32_t _longestMatch(const PngDeflater* d, const uint8_t* data, uint32_t pos, uint32_t size, int32_t cand, uint32_t best, uint32_t chain, uint32_t nice, uint32_t* dist)
+{
+    auto maxLen = size - pos < MAX_MATCH ? size - pos : MAX_MATCH;
+    if (best >= maxLen) return best;
+    if (nice > maxLen) nice = maxLen;
+
+    //the slots within the window are never overwritten by the newer positions, so the chain is strictly decreasing
+    auto limit = pos >= PNG_WINDOW_SIZE ? int32_t(pos - PNG_WINDOW_SIZE) : -1;
+    auto scan = data + pos;
+
+    while (cand > limit && chain-- > 0) {
+        auto match = data + cand;
+        if (match[best] == scan[best] && match[0] == scan[0] && match[1] == scan[1]) {
+            uint32_t len = 2;
+            while (len < maxLen && match[len] == scan[len]) ++len;
+            if (len > best) {
+                best = len;
+                *dist = pos - cand;
+                if (len >= nice) break;
+            }
+        }
+        cand = d->prev[cand & WINDOW_MASK];
+    }
+    return best;
+}
+
+
+static void _deflateGreedy(PngDeflater* d, const uint8_t* data, uint32_t pos, uint32_t size, uint32_t level)
+{
+    auto& params = LEVELS[level];
+
+    while (pos < size) {
+        uint32_t len = 0, dist = 0;
+        if (pos + MIN_MATCH <= size) {
+            auto cand = _insert(d, data, pos);
+            if (cand >= 0) len = _longestMatch(d, data, pos, size, cand, MIN_MATCH - 1, params.chain, params.nice, &dist);
+            if (len == MIN_MATCH && dist > TOO_FAR) len = 0;
+        }
+        if (len >= MIN_MATCH) {
+            _match(d, data, len, dist);
+            for (auto end = pos + len; ++pos < end;) {
+                if (pos + MIN_MATCH <= size) _insert(d, data, pos);
+            }
+        } else {
+            _literal(d, data, data[pos]);
+            ++pos;
+        }
+    }
+}
+
+
+//a match is taken only if the next position doesn't have a longer one
+static void _deflateLazy(PngDeflater* d, const uint8_t* data, uint32_t pos, uint32_t size, uint32_t level)
+{
+    auto& params = LEVELS[level];
+    uint32_t prevLen = MIN_MATCH - 1, prevDist = 0;
+    auto pending = false;   //a literal at pos - 1 is waiting for the decision
+
+    while (pos < size) {
+        uint32_t len = MIN_MATCH - 1, dist = 0;
+        if (pos + MIN_MATCH <= size) {
+            auto cand = _insert(d, data, pos);
+            if (cand >= 0 && prevLen < params.lazy) {
+                auto chain = prevLen >= params.good ? params.chain >> 2 : params.chain;
+                len = _longestMatch(d, data, pos, size, cand, MIN_MATCH - 1, chain, params.nice, &dist);
+                if (len == MIN_MATCH && dist > TOO_FAR) len = MIN_MATCH - 1;
+            }
+        }
+        if (prevLen >= MIN_MATCH && len <= prevLen) {
+            _match(d, data, prevLen, prevDist);
+            for (auto end = pos - 1 + prevLen; ++pos < end;) {
+                if (pos + MIN_MATCH <= size) _insert(d, data, pos);
+            }
+            pending = false;
+            prevLen = MIN_MATCH - 1;
+        } else {
+            if (pending) _literal(d, data, data[pos - 1]);
+            pending = true;
+            prevLen = len;
+            prevDist = dist;
+            ++pos;
+        }
+    }
+    if (pending) _literal(d, data, data[pos - 1]);
+}
+
+
+static void _chunk(PngWriter* writer, const char* type, const uint8_t* data, uint32_t size)
+{
+    if (writer->failed) return;
+
+    uint8_t head[8] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
+    memcpy(head + 4, type, 4);
+
+    uint32_t crc = 0xffffffff;
+    for (uint32_t i = 4; i < 8; ++i) crc = writer->crc[(crc ^ head[i]) & 0xff] ^ (crc >> 8);
+    for (uint32_t i = 0; i < size; ++i) crc = writer->crc[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    crc ^= 0xffffffff;
+    uint8_t tail[4] = {uint8_t(crc >> 24), uint8_t(crc >> 16), uint8_t(crc >> 8), uint8_t(crc)};
+
+    writer->failed = fwrite(head, 1, 8, writer->f) != 8 || (size > 0 && fwrite(data, 1, size, writer->f) != size) || fwrite(tail, 1, 4, writer->f) != 4;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void pngFilter(const uint8_t* image, uint32_t width, uint32_t begin, uint32_t end, uint8_t* out)
+{
+    auto size = width * 4;
+
+    for (auto y = begin; y < end; ++y) {
+        auto cur = image + y * size;
+        //the first row has nothing above, the sub filter is the best guess
+        if (y == 0) _filterRow(cur, nullptr, size, 1, out);
+        else _filterRow(cur, cur - size, size, _pickFilter(cur, cur - size, size), out);
+        out += size + 1;
+    }
+}
+
+
+uint32_t pngAdler(uint32_t adler, const uint8_t* data, uint32_t size)
+{
+    uint32_t s1 = adler & 0xffff;
+    uint32_t s2 = adler >> 16;
+
+    while (size > 0) {
+        //the max bytes before the sums overflow
+        auto n = size < 5552 ? size : 5552;
+        size -= n;
+        while (n-- > 0) {
+            s1 += *data++;
+            s2 += s1;
+        }
+        s1 %= 65521;
+        s2 %= 65521;
+    }
+    return s1 | (s2 << 16);
+}
+
+
+uint32_t pngAdlerCombine(uint32_t adler1, uint32_t adler2, uint32_t size2)
+{
+    const uint32_t BASE = 65521;
+
+    auto rem = size2 % BASE;
+    auto sum1 = adler1 & 0xffff;
+    auto sum2 = (rem * sum1) % BASE;
+    sum1 += (adler2 & 0xffff) + BASE - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + BASE - rem;
+    if (sum1 >= BASE) sum1 -= BASE;
+    if (sum1 >= BASE) sum1 -= BASE;
+    if (sum2 >= (BASE << 1)) sum2 -= (BASE << 1);
+    if (sum2 >= BASE) sum2 -= BASE;
+    return sum1 | (sum2 << 16);
+}
+
+
+bool pngDeflate(PngStream* stream, const uint8_t* data, uint32_t dictSize, uint32_t size, uint32_t level, bool last)
+{
+    if (level < 1) level = 1;
+    else if (level > 9) level = 9;
+
+    PngDeflater d;
+    memset(&d, 0, sizeof(PngDeflater));
+    d.stream = stream;
+    d.head = tvg::malloc<int32_t*>(sizeof(int32_t) * HASH_SIZE);
+    d.prev = tvg::malloc<int32_t*>(sizeof(int32_t) * PNG_WINDOW_SIZE);
+    d.syms = tvg::malloc<uint32_t*>(sizeof(uint32_t) * BLOCK_SYMBOLS);
+
+    if (!d.head || !d.prev || !d.syms) {
+        tvg::free(d.head);
+        tvg::free(d.prev);
+        tvg::free(d.syms);
+        return false;
+    }
+
+    d.blockStart = dictSize;
+    memset(d.head, 0xff, sizeof(int32_t) * HASH_SIZE);
+
+    //prime the window with the preceding data
+    for (uint32_t pos = 0; pos < dictSize && pos + MIN_MATCH <= size; ++pos) {
+        _insert(&d, data, pos);
+    }
+
+    if (LEVELS[level].lazy == 0) _deflateGreedy(&d, data, dictSize, size, level);
+    else _deflateLazy(&d, data, dictSize, size, level);
+
+    if (d.count > 0) _writeBlock(&d, data, last);
+    else if (last) {
+        //an empty final block
+        _reserve(stream, 8);
+        _putBits(stream, 1, 1);
+        _putBits(stream, 1, 2);
+        _putBits(stream, 0, 7);
+    }
+
+    //an empty stored block aligns the stream to the byte boundary
+    if (!last) {
+        _reserve(stream, 8);
+        _writeStored(stream, nullptr, 0, false);
+    } else _alignBits(stream);
+
+    tvg::free(d.head);
+    tvg::free(d.prev);
+    tvg::free(d.syms);
+
+    return true;
+}
+
+
+bool pngBegin(PngWriter* writer, const char* filename, uint32_t width, uint32_t height)
+{
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+    writer->f = 0;
+    fopen_s(&writer->f, filename, "wb");
+#else
+    writer->f = fopen(filename, "wb");
+#endif
+    if (!writer->f) return false;
+
+    writer->failed = false;
+    writer->buffer = tvg::malloc<uint8_t*>(BUFFER_SIZE);
+    writer->count = 0;
+
+    if (!writer->buffer) {
+        fclose(writer->f);
+        writer->f = nullptr;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < 256; ++i) {
+        auto c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320 ^ (c >> 1) : (c >> 1);
+        writer->crc[i] = c;
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    writer->failed = fwrite(signature, 1, 8, writer->f) != 8;
+
+    //8 bits rgba, no interlace
+    uint8_t header[13] = {uint8_t(width >> 24), uint8_t(width >> 16), uint8_t(width >> 8), uint8_t(width),
+                          uint8_t(height >> 24), uint8_t(height >> 16), uint8_t(height >> 8), uint8_t(height), 8, 6, 0, 0, 0};
+    _chunk(writer, "IHDR", header, 13);
+
+    //zlib header: deflate with the 32k window, the max compression
+    static const uint8_t zlib[2] = {0x78, 0xda};
+    pngWrite(writer, zlib, 2);
+
+    return true;
+}
+
+
+void pngWrite(PngWriter* writer, const uint8_t* data, uint32_t size)
+{
+    while (size > 0) {
+        if (writer->count == BUFFER_SIZE) {
+            _chunk(writer, "IDAT", writer->buffer, writer->count);
+            writer->count = 0;
+        }
+        auto len = BUFFER_SIZE - writer->count;
+        if (len > size) len = size;
+        memcpy(writer->buffer + writer->count, data, len);
+        writer->count += len;
+        data += len;
+        size -= len;
+    }
+}
+
+
+bool pngEnd(PngWriter* writer, uint32_t adler)
+{
+    if (!writer->f) return false;
+
+    uint8_t tail[4] = {uint8_t(adler >> 24), uint8_t(adler >> 16), uint8_t(adler >> 8), uint8_t(adler)};
+    pngWrite(writer, tail, 4);
+    _chunk(writer, "IDAT", writer->buffer, writer->count);
+    _chunk(writer, "IEND", nullptr, 0);
+
+    fclose(writer->f);
+    tvg::free(writer->buffer);
+
+    auto success = !writer->failed;
+    writer->f = nullptr;
+    writer->buffer = nullptr;
+    writer->count = 0;
+
+    return success;
+}
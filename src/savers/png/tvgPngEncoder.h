@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TVG_PNG_ENCODER_H
+#define TVG_PNG_ENCODER_H
+
+#include "tvgCommon.h"
+
+// the filtered bytes compressed in a group, the groups are compressed independently of each other
+#define PNG_GROUP_SIZE (128 * 1024)
+// the deflate window, a group is primed with up to this many preceding bytes as its dictionary
+#define PNG_WINDOW_SIZE (32 * 1024)
+
+
+typedef struct
+{
+    uint8_t* data;      // deflate stream, it starts and ends on the byte boundaries
+    uint32_t size;
+    uint32_t reserved;
+    uint64_t bits;      // pending bits
+    uint32_t bitCount;  // how many bits are pending
+} PngStream;
+
+
+typedef struct
+{
+    FILE* f;
+    uint8_t* buffer;    // the image data is gathered here and written out as IDAT chunks
+    uint32_t count;     // bytes in the buffer
+    uint32_t crc[256];  // crc32 table
+    bool failed;        // the output couldn't be written
+} PngWriter;
+
+
+// Returns the size of a filtered row of an RGBA8 image: the filter type byte and the pixels.
+static inline uint32_t pngStride(uint32_t width)
+{
+    return 1 + width * 4;
+}
+
+// Filters the rows [begin, end) of an RGBA8 image (straight alpha) into out.
+// Each row picks the filter of the minimum sum of absolute differences.
+void pngFilter(const uint8_t* image, uint32_t width, uint32_t begin, uint32_t end, uint8_t* out);
+
+// Updates the adler32 checksum with the data, the initial value is 1.
+uint32_t pngAdler(uint32_t adler, const uint8_t* data, uint32_t size);
+
+// Returns the adler32 checksum of the concatenation of the two data of which the latter size is size2.
+uint32_t pngAdlerCombine(uint32_t adler1, uint32_t adler2, uint32_t size2);
+
+// Compresses data[dictSize, size) into the stream, referencing data[0, dictSize) as the preceding data.
+// The stream is closed with the final block if last, otherwise it's aligned by an empty stored block,
+// so the streams of the consecutive groups can be concatenated into one.
+// The level (1 ~ 9) trades the speed for the size.
+// Returns false if the working memory couldn't be allocated.
+bool pngDeflate(PngStream* stream, const uint8_t* data, uint32_t dictSize, uint32_t size, uint32_t level, bool last);
+
+// Creates a png file of an RGBA8 image and starts its zlib data.
+bool pngBegin(PngWriter* writer, const char* filename, uint32_t width, uint32_t height);
+
+// Appends the deflate stream to the image data in order.
+void pngWrite(PngWriter* writer, const uint8_t* data, uint32_t size);
+
+// Ends the zlib data with its adler32 checksum, closes the file handle and frees the memory used by the PngWriter.
+// Returns false if any of the output couldn't be written.
+bool pngEnd(PngWriter* writer, uint32_t adler);
+
+#endif //TVG_PNG_ENCODER_H
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgPngSaver.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+PngTask::~PngTask()
+{
+    tvg::free(stream.data);
+}
+
+
+void PngTask::run(TVG_UNUSED unsigned tid)
+{
+    //filter the preceding rows again to prime the window, the groups don't wait for each other
+    auto stride = pngStride(width);
+    auto from = begin - std::min(begin, (PNG_WINDOW_SIZE + stride - 1) / stride);
+    auto dictSize = (begin - from) * stride;
+    auto skip = dictSize > PNG_WINDOW_SIZE ? dictSize - PNG_WINDOW_SIZE : 0;
+    size = (end - begin) * stride;
+
+    auto filtered = tvg::malloc<uint8_t*>(dictSize + size);
+    if (!filtered) {
+        failed = true;
+        return;
+    }
+    pngFilter(image, width, from, end, filtered);
+    adler = pngAdler(1, filtered + dictSize, size);
+    failed = !pngDeflate(&stream, filtered + skip, dictSize - skip, dictSize + size - skip, level, last);
+    tvg::free(filtered);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+PngSaver::~PngSaver()
+{
+    close();
+}
+
+
+bool PngSaver::close()
+{
+    auto adler = 1u;
+    ARRAY_FOREACH(p, tasks) {
+        auto task = *p;
+        task->done();
+        if (task->failed) writer.failed = true;
+        else pngWrite(&writer, task->stream.data, task->stream.size);
+        adler = pngAdlerCombine(adler, task->adler, task->size);
+        delete(task);
+    }
+    tasks.clear();
+
+    auto success = writer.f ? pngEnd(&writer, adler) : true;
+
+    //the paint is released with the canvas
+    delete(canvas);
+    canvas = nullptr;
+
+    tvg::free(buffer);
+    buffer = nullptr;
+
+    return success;
+}
+
+
+bool PngSaver::save(Paint* paint, Paint* bg, const char* filename, uint32_t quality)
+{
+    close();
+
+    if (!filename) return false;
+
+    float x, y, vw, vh;
+    x = y = 0;
+    paint->bounds(&x, &y, &vw, &vh);
+
+    //cut off the negative space
+    if (x < 0) vw += x;
+    if (y < 0) vh += y;
+
+    if (vw < FLOAT_EPSILON || vh < FLOAT_EPSILON) {
+        TVGLOG("PNG_SAVER", "Saving paint(%p) has zero view size.", paint);
+        return false;
+    }
+
+    auto w = std::max(1u, static_cast<uint32_t>(vw));
+    auto h = std::max(1u, static_cast<uint32_t>(vh));
+
+    //the straight rgba is the png pixel layout, so the rendered buffer is filtered directly
+    canvas = SwCanvas::gen();
+    buffer = tvg::malloc<uint32_t*>(sizeof(uint32_t) * w * h);
+    if (!canvas || !buffer || !pngBegin(&writer, filename, w, h)) {
+        TVGERR("PNG_SAVER", "Failed png encoding");
+        close();
+        return false;
+    }
+
+    canvas->target(buffer, w, w, h, ColorSpace::ABGR8888S);
+    //a paint can't move over the renderers, keep the background reusable for the next savings
+    if (bg) canvas->push(bg->duplicate());
+    canvas->push(paint);
+    canvas->update();
+    if (canvas->draw(true) == tvg::Result::Success) canvas->sync();
+
+    //the row groups are compressed in parallel, the size of a group doesn't depend on the threads for the same output
+    auto rows = std::max(1u, PNG_GROUP_SIZE / pngStride(w));
+    //the default quality is the balanced level of zlib, the higher levels cost much more time for a little smaller size.
+    auto level = 1 + std::min(quality, 100u) * 5 / 100;
+
+    tasks.reserve((h + rows - 1) / rows);
+    for (uint32_t begin = 0; begin < h; begin += rows) {
+        auto end = std::min(begin + rows, h);
+        tasks.push(new PngTask(reinterpret_cast<uint8_t*>(buffer), w, begin, end, level, end == h));
+    }
+
+    ARRAY_FOREACH(p, tasks) {
+        TaskScheduler::request(*p);
+    }
+
+    return true;
+}
+
+
+bool PngSaver::save(TVG_UNUSED Animation* animation, TVG_UNUSED Paint* bg, TVG_UNUSED const char* filename, TVG_UNUSED uint32_t quality, TVG_UNUSED uint32_t fps)
+{
+    TVGLOG("PNG_SAVER", "Animation is not supported.");
+    return false;
+}
+
+
+bool PngSaver::save(TVG_UNUSED Animation* animation, TVG_UNUSED Paint* bg, TVG_UNUSED SaveFunc func, TVG_UNUSED void* data, TVG_UNUSED uint32_t quality, TVG_UNUSED uint32_t fps)
+{
+    TVGLOG("PNG_SAVER", "Animation is not supported.");
+    return false;
+}
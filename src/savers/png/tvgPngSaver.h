@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_PNGSAVER_H_
+#define _TVG_PNGSAVER_H_
+
+#include "tvgSaveModule.h"
+#include "tvgTaskScheduler.h"
+#include "tvgPngEncoder.h"
+
+namespace tvg
+{
+
+//filters and compresses a group of the rows independently of the others
+struct PngTask : Task
+{
+    const uint8_t* image;
+    PngStream stream{};
+    uint32_t width;
+    uint32_t begin, end;    //rows of the group
+    uint32_t level;
+    uint32_t adler = 1;     //checksum of the filtered rows
+    uint32_t size = 0;      //size of the filtered rows
+    bool last;
+    bool failed = false;    //the memory couldn't be allocated
+
+    PngTask(const uint8_t* image, uint32_t width, uint32_t begin, uint32_t end, uint32_t level, bool last) : image(image), width(width), begin(begin), end(end), level(level), last(last) {}
+    ~PngTask();
+    void run(unsigned tid) override;
+};
+
+
+class PngSaver : public SaveModule
+{
+private:
+    Array<PngTask*> tasks;
+    PngWriter writer{};
+    SwCanvas* canvas = nullptr;
+    uint32_t* buffer = nullptr;
+
+public:
+    ~PngSaver();
+
+    bool save(Paint* paint, Paint* bg, const char* filename, uint32_t quality) override;
+    bool save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps) override;
+    bool save(Animation* animation, Paint* bg, SaveFunc func, void* data, uint32_t quality, uint32_t fps) override;
+    bool close() override;
+};
+
+}
+
+#endif  //_TVG_PNGSAVER_H_
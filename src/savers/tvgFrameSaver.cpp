@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+#include "tvgStr.h"
+#include "tvgFrameSaver.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#ifdef THORVG_THREAD_SUPPORT
+    #define LOCK() lock.lock()
+    #define UNLOCK() lock.unlock()
+#else
+    #define LOCK()
+    #define UNLOCK()
+#endif
+
+
+void FrameTask::run(TVG_UNUSED unsigned tid)
+{
+    saver->work(this);
+}
+
+
+bool FrameSaver::prepare()
+{
+    //use the default fps
+    if (tvg::zero(fps) || fps < 0.0f) {
+        fps = (animation->totalFrame() / animation->duration());
+    }
+
+    delay = (1.0f / fps);
+
+    auto duration = animation->duration();
+    for (auto p = 0.0f; p < duration; p += delay) ++frameCnt;
+
+    //a frame could be encoded against the previous rendered one, the ring keeps both of them alive
+    auto threads = TaskScheduler::threads();
+    if (threads == 0) threads = 1;
+    slotCnt = threads + 2;
+    slots = new Slot[slotCnt];
+    for (uint32_t i = 0; i < slotCnt; ++i) {
+        slots[i].image = tvg::malloc<uint32_t*>(sizeof(uint32_t) * w * h);
+        if (!slots[i].image) return false;
+    }
+
+    if (!begin()) {
+        TVGERR(tag, "Failed encoding");
+        return false;
+    }
+    began = true;
+
+    tasks.reserve(threads);
+    for (uint32_t i = 0; i < threads; ++i) {
+        tasks.push(new FrameTask(this));
+    }
+
+    return true;
+}
+
+
+bool FrameSaver::render(Slot* slot)
+{
+    if (!canvas) {
+        canvas = SwCanvas::gen();
+        if (!canvas) return false;
+        buffer = tvg::realloc<uint32_t*>(buffer, sizeof(uint32_t) * w * h);
+        canvas->target(buffer, w, w, h, cs);
+        //a paint can't move over the renderers, keep the background reusable for the next savings
+        if (bg) canvas->push(bg->duplicate());
+        canvas->push(animation->picture());
+    }
+
+    auto frameNo = animation->totalFrame() * (progress / animation->duration());
+    animation->frame(frameNo);
+    canvas->update();
+    if (canvas->draw(true) == tvg::Result::Success) {
+        canvas->sync();
+    }
+    memcpy(slot->image, buffer, sizeof(uint32_t) * w * h);
+    progress += delay;
+
+    return true;
+}
+
+
+//the count of the works which could be started right now
+uint32_t FrameSaver::ready()
+{
+    uint32_t cnt = 0;
+    if (!writing && slots[written % slotCnt].state == Slot::Encoded) ++cnt;
+    for (auto idx = written; idx < rendered; ++idx) {
+        if (slots[idx % slotCnt].state == Slot::Rendered) ++cnt;
+    }
+    if (!rendering && rendered < frameCnt && rendered + 1 < written + slotCnt) ++cnt;
+    return cnt;
+}
+
+
+//hand the ready works over to the idle tasks. no task waits for the others, the workers are shared with the canvases.
+void FrameSaver::dispatch()
+{
+    if (failed) return;
+
+    auto cnt = ready();
+    ARRAY_FOREACH(p, tasks) {
+        if (looking >= cnt) break;
+        auto task = *p;
+        if (!task->idle) continue;
+        task->done();  //the previous run must be completely returned
+        task->idle = false;
+        ++running;
+        ++looking;
+        TaskScheduler::request(task);
+    }
+}
+
+
+void FrameSaver::work(FrameTask* task)
+{
+#ifdef THORVG_THREAD_SUPPORT
+    unique_lock<mutex> lock(mtx);
+#endif
+
+    while (!failed && written < frameCnt) {
+        //write out the next frame
+        auto idx = written % slotCnt;
+        if (!writing && slots[idx].state == Slot::Encoded) {
+            writing = true;
+            --looking;
+            UNLOCK();
+            auto success = write(idx);
+            LOCK();
+            writing = false;
+            slots[idx].state = Slot::Empty;
+            if (success) ++written;
+            else failed = true;
+            ++looking;
+            dispatch();
+            continue;
+        }
+
+        //encode a rendered frame
+        auto frame = written;
+        for (; frame < rendered; ++frame) {
+            if (slots[frame % slotCnt].state == Slot::Rendered) break;
+        }
+        if (frame < rendered) {
+            idx = frame % slotCnt;
+            slots[idx].state = Slot::Encoding;
+            --looking;
+            auto prev = (frame > 0) ? slots[(frame - 1) % slotCnt].image : nullptr;
+            UNLOCK();
+            encode(idx, slots[idx].image, prev);
+            LOCK();
+            slots[idx].state = Slot::Encoded;
+            ++looking;
+            dispatch();
+            continue;
+        }
+
+        //render the next frame, its slot must not be referred by the unwritten frames anymore
+        if (!rendering && rendered < frameCnt && rendered + 1 < written + slotCnt) {
+            rendering = true;
+            --looking;
+            auto slot = &slots[rendered % slotCnt];
+            UNLOCK();
+            //the frames are processed in parallel already, keep the nested tasks on this thread
+            TaskScheduler::async(false);
+            auto success = render(slot);
+            TaskScheduler::async(true);
+            LOCK();
+            rendering = false;
+            if (success) {
+                slot->state = Slot::Rendered;
+                ++rendered;
+            } else failed = true;
+            ++looking;
+            dispatch();
+            continue;
+        }
+        break;
+    }
+
+    //nothing to do, the next works will be handed over by the busy tasks
+    --looking;
+    task->idle = true;
+    if (--running > 0) return;
+
+    if (began && (failed || written == frameCnt)) {
+        began = false;
+        if (!end() || failed) {
+            failed = true;
+            TVGERR(tag, "Failed encoding");
+        }
+    }
+#ifdef THORVG_THREAD_SUPPORT
+    cv.notify_all();
+#endif
+}
+
+
+bool FrameSaver::start(Animation* animation, Paint* bg, uint32_t quality, uint32_t fps)
+{
+    auto picture = animation->picture();
+    float x, y, vw, vh;
+    x = y = 0;
+    picture->bounds(&x, &y, &vw, &vh);
+
+    //cut off the negative space
+    if (x < 0) vw += x;
+    if (y < 0) vh += y;
+
+    if (vw < FLOAT_EPSILON || vh < FLOAT_EPSILON) {
+        TVGLOG(tag, "Saving animation(%p) has zero view size.", animation);
+        return false;
+    }
+
+    this->w = static_cast<uint32_t>(vw);
+    this->h = static_cast<uint32_t>(vh);
+    this->animation = animation;
+
+    if (bg) {
+        bg->ref();
+        this->bg = bg;
+    }
+    this->quality = quality;
+    this->fps = static_cast<float>(fps);
+
+    if (!prepare()) {
+        this->animation = nullptr;  //the caller takes it back
+        close();
+        return false;
+    }
+
+    //the other tasks join as the works get ready
+    tasks[0]->idle = false;
+    running = looking = 1;
+    TaskScheduler::request(tasks[0]);
+
+    return true;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool FrameSaver::close()
+{
+#ifdef THORVG_THREAD_SUPPORT
+    {
+        unique_lock<mutex> lock(mtx);
+        while (running > 0) cv.wait(lock);
+    }
+#endif
+    ARRAY_FOREACH(p, tasks) {
+        (*p)->done();
+        delete(*p);
+    }
+    tasks.clear();
+
+    //a failed write or an abort by the write function
+    auto success = !failed && written == frameCnt;
+    if (began && !end()) success = false;
+    began = false;
+    clear();
+
+    delete(canvas);
+    canvas = nullptr;
+
+    for (uint32_t i = 0; i < slotCnt; ++i) {
+        tvg::free(slots[i].image);
+    }
+    delete[](slots);
+    slots = nullptr;
+    slotCnt = 0;
+
+    frameCnt = rendered = written = running = looking = 0;
+    rendering = writing = failed = false;
+    progress = 0.0f;
+
+    if (bg) bg->unref();
+    bg = nullptr;
+
+    //animation holds the picture, it must be 1 at the bottom.
+    if (animation && animation->picture()->refCnt() <= 1) delete(animation);
+    animation = nullptr;
+
+    tvg::free(path);
+    path = nullptr;
+    func = nullptr;
+    data = nullptr;
+
+    tvg::free(buffer);
+    buffer = nullptr;
+
+    return success;
+}
+
+
+bool FrameSaver::save(TVG_UNUSED Paint* paint, TVG_UNUSED Paint* bg, TVG_UNUSED const char* filename, TVG_UNUSED uint32_t quality)
+{
+    TVGLOG(tag, "Paint is not supported.");
+    return false;
+}
+
+
+bool FrameSaver::save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps)
+{
+    close();
+
+    if (!filename) return false;
+    this->path = duplicate(filename);
+
+    return start(animation, bg, quality, fps);
+}
+
+
+bool FrameSaver::save(Animation* animation, Paint* bg, SaveFunc func, void* data, uint32_t quality, uint32_t fps)
+{
+    close();
+
+    if (!func) return false;
+    this->func = func;
+    this->data = data;
+
+    return start(animation, bg, quality, fps);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_FRAMESAVER_H_
+#define _TVG_FRAMESAVER_H_
+
+#include "tvgSaveModule.h"
+#include "tvgTaskScheduler.h"
+
+namespace tvg
+{
+
+class FrameSaver;
+
+//a pipeline worker, renders/encodes/writes the frames whichever is ready and leaves when nothing is ready.
+struct FrameTask : Task
+{
+    FrameSaver* saver;
+    bool idle = true;
+
+    FrameTask(FrameSaver* saver) : saver(saver) {}
+    void run(unsigned tid) override;
+};
+
+
+//the animation export pipeline of the frame based formats.
+//the frames are rendered in order by one task at a time, encoded by any tasks concurrently and written in order.
+class FrameSaver : public SaveModule
+{
+private:
+    //a frame slot in the ring buffer, the encoder keeps its own data per slot
+    struct Slot
+    {
+        enum State : uint8_t {Empty = 0, Rendered, Encoding, Encoded};
+
+        uint32_t* image = nullptr;   //rendered frame
+        State state = Empty;
+    };
+
+    Array<FrameTask*> tasks;
+    Slot* slots = nullptr;
+    SwCanvas* canvas = nullptr;
+    uint32_t* buffer = nullptr;
+    float progress = 0.0f;
+
+    //pipeline status
+    uint32_t frameCnt = 0;   //total frames
+    uint32_t rendered = 0;   //count of the rendered frames
+    uint32_t written = 0;    //count of the written frames
+    uint32_t running = 0;    //count of the requested tasks
+    uint32_t looking = 0;    //count of the tasks looking for a work
+    bool began = false;      //the output is opened
+    bool rendering = false;
+    bool writing = false;
+    bool failed = false;
+#ifdef THORVG_THREAD_SUPPORT
+    mutex mtx;
+    condition_variable cv;
+#endif
+
+    bool start(Animation* animation, Paint* bg, uint32_t quality, uint32_t fps);
+    bool prepare();
+    bool render(Slot* slot);
+    uint32_t ready();
+    void dispatch();
+    void work(FrameTask* task);
+
+protected:
+    const char* tag;          //the log tag of the format
+    ColorSpace cs;            //the color space of the rendered frames
+    Animation* animation = nullptr;
+    Paint* bg = nullptr;
+    char *path = nullptr;
+    SaveFunc func = nullptr;  //or write to the function
+    void* data = nullptr;
+    uint32_t w = 0, h = 0;
+    uint32_t slotCnt = 0;
+    uint32_t quality = 100;
+    float fps = 0.0f;
+    float delay = 0.0f;
+
+    FrameSaver(const char* tag, ColorSpace cs) : tag(tag), cs(cs) {}
+
+    //the encoder of the format. begin() opens the output and allocates the data of the slots.
+    virtual bool begin() = 0;
+    //a slot image is encoded, the previous rendered frame is given if there is. it's called concurrently.
+    virtual void encode(uint32_t slot, const uint32_t* image, const uint32_t* prev) = 0;
+    virtual bool write(uint32_t slot) = 0;
+    //finishes the output, it's called once after begin() is succeeded.
+    virtual bool end() = 0;
+    //releases the slot data. the derived savers must close() in their destructors, the hooks are gone in the base one.
+    virtual void clear() = 0;
+
+public:
+    bool save(Paint* paint, Paint* bg, const char* filename, uint32_t quality) override;
+    bool save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps) override;
+    bool save(Animation* animation, Paint* bg, SaveFunc func, void* data, uint32_t quality, uint32_t fps) override;
+    bool close() override;
+
+    friend struct FrameTask;
+};
+
+}
+
+#endif  //_TVG_FRAMESAVER_H_
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstring>
+#include "tvgY4mEncoder.h"
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    #include <immintrin.h>
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+    #include <arm_neon.h>
+#endif
+
+
+#define FRAME_HEADER "FRAME\n"
+#define FRAME_HEADER_SIZE 6
+
+// BT.601 limited range, 8 bits fixed point coefficients of r, g, b
+#define Y_R 66
+#define Y_G 129
+#define Y_B 25
+#define U_R -38
+#define U_G -74
+#define U_B 112
+#define V_R 112
+#define V_G -94
+#define V_B -18
+
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+static inline uint8_t _luma(const uint8_t* p)
+{
+    return 16 + ((Y_R * p[0] + Y_G * p[1] + Y_B * p[2] + 128) >> 8);
+}
+
+
+static inline uint8_t _avg(uint8_t a, uint8_t b)
+{
+    return (a + b + 1) >> 1;
+}
+
+
+//the chroma of the 2x2 pixels, averaged vertically first to be the same as the vectorized one
+static inline void _chroma(const uint8_t* p00, const uint8_t* p01, const uint8_t* p10, const uint8_t* p11, uint8_t* u, uint8_t* v)
+{
+    int c[3];
+    for (int i = 0; i < 3; ++i) c[i] = _avg(_avg(p00[i], p10[i]), _avg(p01[i], p11[i]));
+    *u = 128 + ((U_R * c[0] + U_G * c[1] + U_B * c[2] + 128) >> 8);
+    *v = 128 + ((V_R * c[0] + V_G * c[1] + V_B * c[2] + 128) >> 8);
+}
+
+
+//convert the pixels [x, width) of the two rows, the last odd pixel is paired with itself
+static void _convertRows(const uint8_t* row0, const uint8_t* row1, uint32_t x, uint32_t width, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v)
+{
+    for (; x < width; x += 2) {
+        auto x1 = (x + 1 < width) ? x + 1 : x;
+        y0[x] = _luma(row0 + x * 4);
+        y1[x] = _luma(row1 + x * 4);
+        if (x1 != x) {
+            y0[x1] = _luma(row0 + x1 * 4);
+            y1[x1] = _luma(row1 + x1 * 4);
+        }
+        _chroma(row0 + x * 4, row0 + x1 * 4, row1 + x * 4, row1 + x1 * 4, u + x / 2, v + x / 2);
+    }
+}
+
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+
+//8 pixels of the two rows at once, returns the converted count
+static uint32_t _convertRowsSimd(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v)
+{
+    //Y_G doesn't fit in a signed byte, it's split over the duplicated g: r, g, b, g
+    //the former pair takes as much as it can without the saturation of the signed 16 bits
+    auto ys = _mm_setr_epi8(0, 1, 2, 1, 4, 5, 6, 5, 8, 9, 10, 9, 12, 13, 14, 13);
+    auto yg = 128 - Y_R;
+    auto yc = _mm_set1_epi32(((Y_G - yg) << 24) | (Y_B << 16) | (yg << 8) | Y_R);
+    auto uc = _mm_set1_epi32(((U_B & 0xff) << 16) | ((U_G & 0xff) << 8) | (U_R & 0xff));
+    auto vc = _mm_set1_epi32(((V_B & 0xff) << 16) | ((V_G & 0xff) << 8) | (V_R & 0xff));
+    auto yRound = _mm_set1_epi16(128);
+    auto yOffset = _mm_set1_epi16(16);
+    auto uvRound = _mm_set1_epi16(128);
+
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        auto a0 = _mm_loadu_si128((const __m128i*)(row0 + x * 4));
+        auto a1 = _mm_loadu_si128((const __m128i*)(row0 + x * 4 + 16));
+        auto b0 = _mm_loadu_si128((const __m128i*)(row1 + x * 4));
+        auto b1 = _mm_loadu_si128((const __m128i*)(row1 + x * 4 + 16));
+
+        //the pairs of r, g and b, g added horizontally, the sum fits in the unsigned 16 bits
+        auto l0 = _mm_hadd_epi16(_mm_maddubs_epi16(_mm_shuffle_epi8(a0, ys), yc), _mm_maddubs_epi16(_mm_shuffle_epi8(a1, ys), yc));
+        auto l1 = _mm_hadd_epi16(_mm_maddubs_epi16(_mm_shuffle_epi8(b0, ys), yc), _mm_maddubs_epi16(_mm_shuffle_epi8(b1, ys), yc));
+        l0 = _mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(l0, yRound), 8), yOffset);
+        l1 = _mm_add_epi16(_mm_srli_epi16(_mm_add_epi16(l1, yRound), 8), yOffset);
+        _mm_storel_epi64((__m128i*)(y0 + x), _mm_packus_epi16(l0, l0));
+        _mm_storel_epi64((__m128i*)(y1 + x), _mm_packus_epi16(l1, l1));
+
+        //average the rows, then the even and odd pixels
+        auto m0 = _mm_castsi128_ps(_mm_avg_epu8(a0, b0));
+        auto m1 = _mm_castsi128_ps(_mm_avg_epu8(a1, b1));
+        auto even = _mm_castps_si128(_mm_shuffle_ps(m0, m1, _MM_SHUFFLE(2, 0, 2, 0)));
+        auto odd = _mm_castps_si128(_mm_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 1, 3, 1)));
+        auto c = _mm_avg_epu8(even, odd);
+
+        //4 u and 4 v
+        auto uv = _mm_hadd_epi16(_mm_maddubs_epi16(c, uc), _mm_maddubs_epi16(c, vc));
+        uv = _mm_add_epi16(_mm_srai_epi16(_mm_add_epi16(uv, uvRound), 8), uvRound);
+        uv = _mm_packus_epi16(uv, uv);
+        auto u4 = _mm_cvtsi128_si32(uv);
+        auto v4 = _mm_cvtsi128_si32(_mm_srli_si128(uv, 4));
+        memcpy(u + x / 2, &u4, 4);
+        memcpy(v + x / 2, &v4, 4);
+    }
+    return x;
+}
+
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+
+//8 pixels of the two rows at once, returns the converted count
+static uint32_t _convertRowsSimd(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v)
+{
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        auto a = vld4_u8(row0 + x * 4);
+        auto b = vld4_u8(row1 + x * 4);
+
+        auto l0 = vmlal_u8(vmlal_u8(vmull_u8(a.val[0], vdup_n_u8(Y_R)), a.val[1], vdup_n_u8(Y_G)), a.val[2], vdup_n_u8(Y_B));
+        auto l1 = vmlal_u8(vmlal_u8(vmull_u8(b.val[0], vdup_n_u8(Y_R)), b.val[1], vdup_n_u8(Y_G)), b.val[2], vdup_n_u8(Y_B));
+        vst1_u8(y0 + x, vadd_u8(vrshrn_n_u16(l0, 8), vdup_n_u8(16)));
+        vst1_u8(y1 + x, vadd_u8(vrshrn_n_u16(l1, 8), vdup_n_u8(16)));
+
+        //average the rows, then the even and odd pixels
+        int16x4_t c[3];
+        for (int i = 0; i < 3; ++i) {
+            c[i] = vreinterpret_s16_u16(vrshr_n_u16(vpaddl_u8(vrhadd_u8(a.val[i], b.val[i])), 1));
+        }
+
+        auto u4 = vmla_n_s16(vmla_n_s16(vmul_n_s16(c[0], U_R), c[1], U_G), c[2], U_B);
+        auto v4 = vmla_n_s16(vmla_n_s16(vmul_n_s16(c[0], V_R), c[1], V_G), c[2], V_B);
+        auto uv = vaddq_s16(vrshrq_n_s16(vcombine_s16(u4, v4), 8), vdupq_n_s16(128));
+        auto p = vqmovun_s16(uv);
+        vst1_lane_u32((uint32_t*)(u + x / 2), vreinterpret_u32_u8(p), 0);
+        vst1_lane_u32((uint32_t*)(v + x / 2), vreinterpret_u32_u8(p), 1);
+    }
+    return x;
+}
+
+#else
+
+static uint32_t _convertRowsSimd(TVG_UNUSED const uint8_t* row0, TVG_UNUSED const uint8_t* row1, TVG_UNUSED uint32_t width, TVG_UNUSED uint8_t* y0, TVG_UNUSED uint8_t* y1, TVG_UNUSED uint8_t* u, TVG_UNUSED uint8_t* v)
+{
+    return 0;
+}
+
+#endif
+
+
+static bool _write(Y4mWriter* writer, const uint8_t* data, uint32_t size)
+{
+    if (writer->failed) return false;
+    if (writer->f) writer->failed = (fwrite(data, 1, size, writer->f) != size);
+    else writer->failed = !writer->func(data, size, writer->data);
+    return !writer->failed;
+}
+
+
+static bool _begin(Y4mWriter* writer, uint32_t width, uint32_t height, float fps)
+{
+    writer->failed = false;
+
+    //the frame rate as a ratio, in milli frames unless it's an integer
+    auto milli = static_cast<uint32_t>(fps * 1000.0f + 0.5f);
+    auto num = (milli % 1000 == 0) ? milli / 1000 : milli;
+    auto den = (milli % 1000 == 0) ? 1 : 1000;
+
+    char header[128];
+    auto size = snprintf(header, sizeof(header), "YUV4MPEG2 W%u H%u F%u:%u Ip A1:1 C420jpeg\n", width, height, num, den);
+    return _write(writer, (const uint8_t*)header, size);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+uint32_t y4mFrameSize(uint32_t width, uint32_t height)
+{
+    return FRAME_HEADER_SIZE + width * height + 2 * ((width + 1) / 2) * ((height + 1) / 2);
+}
+
+
+bool y4mBegin(Y4mWriter* writer, const char* filename, uint32_t width, uint32_t height, float fps)
+{
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+    writer->f = 0;
+    fopen_s(&writer->f, filename, "wb");
+#else
+    writer->f = fopen(filename, "wb");
+#endif
+    if (!writer->f) return false;
+
+    writer->func = nullptr;
+
+    return _begin(writer, width, height, fps);
+}
+
+
+bool y4mBegin(Y4mWriter* writer, tvg::SaveFunc func, void* data, uint32_t width, uint32_t height, float fps)
+{
+    if (!func) return false;
+
+    writer->f = nullptr;
+    writer->func = func;
+    writer->data = data;
+
+    return _begin(writer, width, height, fps);
+}
+
+
+void y4mConvert(const uint8_t* image, uint32_t width, uint32_t height, uint8_t* frame)
+{
+    memcpy(frame, FRAME_HEADER, FRAME_HEADER_SIZE);
+
+    auto y = frame + FRAME_HEADER_SIZE;
+    auto cw = (width + 1) / 2;
+    auto u = y + width * height;
+    auto v = u + cw * ((height + 1) / 2);
+    auto stride = width * 4;
+
+    //a pair of the rows at once, the last odd row is paired with itself
+    for (uint32_t i = 0; i < height; i += 2) {
+        auto row0 = image + i * stride;
+        auto row1 = (i + 1 < height) ? row0 + stride : row0;
+        auto y0 = y + i * width;
+        auto y1 = (i + 1 < height) ? y0 + width : y0;
+        auto x = _convertRowsSimd(row0, row1, width, y0, y1, u, v);
+        _convertRows(row0, row1, x, width, y0, y1, u, v);
+        u += cw;
+        v += cw;
+    }
+}
+
+
+bool y4mWriteFrame(Y4mWriter* writer, const uint8_t* frame, uint32_t size)
+{
+    if (!writer->f && !writer->func) return false;
+    return _write(writer, frame, size);
+}
+
+
+bool y4mEnd(Y4mWriter* writer)
+{
+    if (writer->f) {
+        writer->failed |= (fclose(writer->f) != 0);
+        writer->f = nullptr;
+    }
+    writer->func = nullptr;
+    writer->data = nullptr;
+    return !writer->failed;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TVG_Y4M_ENCODER_H
+#define TVG_Y4M_ENCODER_H
+
+#include "tvgCommon.h"
+#include "tvgSaveModule.h"
+
+
+typedef struct
+{
+    FILE* f;            // output file, or
+    tvg::SaveFunc func; // output function with its data
+    void* data;
+    bool failed;        // the output couldn't be written
+} Y4mWriter;
+
+
+// Returns the size of a frame in bytes: the frame header and the YUV 4:2:0 planes.
+uint32_t y4mFrameSize(uint32_t width, uint32_t height);
+
+// Creates a y4m stream of the given frame rate and writes its header.
+bool y4mBegin(Y4mWriter* writer, const char* filename, uint32_t width, uint32_t height, float fps);
+
+// Same as above, but the data is passed to the given function.
+bool y4mBegin(Y4mWriter* writer, tvg::SaveFunc func, void* data, uint32_t width, uint32_t height, float fps);
+
+// Converts an RGBA8 image (premultiplied, i.e. composed over black) into a frame of y4mFrameSize() bytes.
+// The colors are converted to BT.601 limited range, the chroma is averaged over each 2x2 pixels.
+// The frames are independent of each other, so they can be converted concurrently.
+void y4mConvert(const uint8_t* image, uint32_t width, uint32_t height, uint8_t* frame);
+
+// Writes out a converted frame, the frames must be written in order.
+bool y4mWriteFrame(Y4mWriter* writer, const uint8_t* frame, uint32_t size);
+
+// Closes the file handle. Returns false if any of the output couldn't be written.
+bool y4mEnd(Y4mWriter* writer);
+
+#endif //TVG_Y4M_ENCODER_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 - 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgY4mSaver.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+bool Y4mSaver::begin()
+{
+    frames = tvg::calloc<uint8_t**>(slotCnt, sizeof(uint8_t*));
+    if (!frames) return false;
+
+    for (uint32_t i = 0; i < slotCnt; ++i) {
+        frames[i] = tvg::malloc<uint8_t*>(y4mFrameSize(w, h));
+        if (!frames[i]) return false;
+    }
+
+    auto began = path ? y4mBegin(&writer, path, w, h, fps) : y4mBegin(&writer, func, data, w, h, fps);
+    if (!began) y4mEnd(&writer);
+    return began;
+}
+
+
+void Y4mSaver::encode(uint32_t slot, const uint32_t* image, TVG_UNUSED const uint32_t* prev)
+{
+    y4mConvert(reinterpret_cast<const uint8_t*>(image), w, h, frames[slot]);
+}
+
+
+bool Y4mSaver::write(uint32_t slot)
+{
+    return y4mWriteFrame(&writer, frames[slot], y4mFrameSize(w, h));
+}
+
+
+bool Y4mSaver::end()
+{
+    return y4mEnd(&writer);
+}
+
+
+void Y4mSaver::clear()
+{
+    if (!frames) return;
+
+    for (uint32_t i = 0; i < slotCnt; ++i) {
+        tvg::free(frames[i]);
+    }
+    tvg::free(frames);
+    frames = nullptr;
+}
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+Y4mSaver::~Y4mSaver()
+{
+    close();
+}
+
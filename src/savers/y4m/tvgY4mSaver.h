@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023 - 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_Y4MSAVER_H_
+#define _TVG_Y4MSAVER_H_
+
+#include "tvgFrameSaver.h"
+#include "tvgY4mEncoder.h"
+
+namespace tvg
+{
+
+class Y4mSaver : public FrameSaver
+{
+private:
+    Y4mWriter writer{};
+    uint8_t** frames = nullptr;  //converted frame per slot
+
+    bool begin() override;
+    void encode(uint32_t slot, const uint32_t* image, const uint32_t* prev) override;
+    bool write(uint32_t slot) override;
+    bool end() override;
+    void clear() override;
+
+public:
+    //the premultiplied colors are the ones composed over black
+    Y4mSaver() : FrameSaver("Y4M_SAVER", ColorSpace::ABGR8888) {}
+    ~Y4mSaver();
+};
+
+}
+
+#endif  //_TVG_Y4MSAVER_H_
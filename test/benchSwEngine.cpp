@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Micro benchmarks of the software rasterizer kernels.
+ * The kernels are measured in isolation on synthetic rle spans and surfaces.
+ * The kernels with the vector variants are measured with the c reference as well as the compiled simd level.
+ *
+ * Usage: tvgSwBench [kernel name filter]
+ */
+
+#include <thorvg.h>
+#include <chrono>
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include "config.h"
+#include "tvgSwCommon.h"
+#include "tvgSwRasterC.h"
+
+using namespace tvg;
+using namespace std;
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    static constexpr const char* SIMD = "avx";
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+    static constexpr const char* SIMD = "neon";
+#else
+    static constexpr const char* SIMD = "c";
+#endif
+
+static constexpr int32_t WIDTH = 1024;
+static constexpr int32_t HEIGHT = 1024;
+static constexpr uint32_t ROUNDS = 5;
+static constexpr double ROUND_TIME = 1e7;    //10ms in nanoseconds
+
+static const char* filter = nullptr;
+static uint32_t seed = 0x12345678;
+static volatile uint32_t sink;               //keep the kernel outputs alive
+
+
+static uint32_t _random()
+{
+    seed = seed * 1664525 + 1013904223;
+    return seed;
+}
+
+
+//premultiplied pixels of random colors and alpha
+static uint32_t* _buffer(uint32_t cnt)
+{
+    auto buffer = tvg::malloc<uint32_t*>(sizeof(uint32_t) * cnt);
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto c = _random();
+        buffer[i] = PREMULTIPLY(c | 0x000000ff, A(c));
+    }
+    return buffer;
+}
+
+
+static void _surface(SwSurface& surface, uint32_t* buffer, int32_t w, int32_t h)
+{
+    surface.buf32 = buffer;
+    surface.stride = w;
+    surface.w = w;
+    surface.h = h;
+    surface.cs = ColorSpace::ABGR8888;
+    surface.channelSize = sizeof(uint32_t);
+    surface.premultiplied = true;
+    rasterCompositor(&surface);
+}
+
+
+//spans of the given length and coverage along the rows, one pixel gap in between
+static SwRle* _rle(uint16_t len, uint8_t coverage, uint64_t& pixels)
+{
+    auto rle = new SwRle;
+    pixels = 0;
+
+    for (int32_t y = 0; y < HEIGHT; ++y) {
+        for (int32_t x = 0; x + len <= WIDTH; x += len + 1) {
+            rle->spans.push({uint16_t(x), uint16_t(y), len, coverage});
+            pixels += len;
+        }
+    }
+    return rle;
+}
+
+
+static uint64_t _count(const SwRle* rle)
+{
+    uint64_t pixels = 0;
+    ARRAY_FOREACH(span, rle->spans) pixels += span->len;
+    return pixels;
+}
+
+
+static void _circle(RenderPath& path, float cx, float cy, float r)
+{
+    constexpr auto K = 0.552284f;
+    auto k = r * K;
+    path.moveTo({cx + r, cy});
+    path.cubicTo({cx + r, cy + k}, {cx + k, cy + r}, {cx, cy + r});
+    path.cubicTo({cx - k, cy + r}, {cx - r, cy + k}, {cx - r, cy});
+    path.cubicTo({cx - r, cy - k}, {cx - k, cy - r}, {cx, cy - r});
+    path.cubicTo({cx + k, cy - r}, {cx + r, cy - k}, {cx + r, cy});
+    path.close();
+}
+
+
+static void _star(RenderPath& path, float cx, float cy, float r, uint32_t spikes)
+{
+    for (uint32_t i = 0; i < spikes * 2; ++i) {
+        auto radius = (i % 2) ? r * 0.4f : r;
+        auto angle = MATH_PI * float(i) / float(spikes);
+        Point pt = {cx + radius * cosf(angle), cy + radius * sinf(angle)};
+        if (i == 0) path.moveTo(pt);
+        else path.lineTo(pt);
+    }
+    path.close();
+}
+
+
+//a few sample geometries: a large curved shape, a sharp polygon and many small shapes like glyphs
+static void _path(RenderPath& path, const char* name)
+{
+    if (!strcmp(name, "circle")) {
+        _circle(path, WIDTH * 0.5f, HEIGHT * 0.5f, WIDTH * 0.45f);
+    } else if (!strcmp(name, "star128")) {
+        _star(path, WIDTH * 0.5f, HEIGHT * 0.5f, WIDTH * 0.45f, 128);
+    } else {
+        for (int32_t y = 8; y < HEIGHT; y += 16) {
+            for (int32_t x = 8; x < WIDTH; x += 16) {
+                _circle(path, float(x), float(y), 6.0f);
+            }
+        }
+    }
+}
+
+
+//runs the kernel until a round takes enough time and reports the best average time per unit of the rounds
+template<typename Kernel>
+static void _bench(const char* kernel, const char* level, const char* params, uint64_t units, const char* unit, Kernel run)
+{
+    if (filter && !strstr(kernel, filter)) return;
+
+    run();
+
+    uint32_t iterations = 1;
+    while (true) {
+        auto begin = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; ++i) run();
+        auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count();
+        if (elapsed >= ROUND_TIME || iterations >= (1u << 20)) break;
+        iterations <<= 1;
+    }
+
+    auto best = DBL_MAX;
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        auto begin = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; ++i) run();
+        auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count();
+        best = std::min(best, elapsed / iterations);
+    }
+
+    printf("%-26s %-5s %-22s %10.3f ns/%s\n", kernel, level, params, best / double(units), unit);
+    fflush(stdout);
+}
+
+
+static void _benchPixels(uint32_t* buffer)
+{
+    char params[32];
+    uint32_t color = 0xff336699;
+
+    for (auto len : {4, 16, 64, 1024}) {
+        snprintf(params, sizeof(params), "span %d", len);
+        auto run = [&](bool simd) {
+            for (int32_t y = 0; y < HEIGHT; ++y) {
+                auto dst = buffer + y * WIDTH;
+                for (int32_t x = 0; x + len <= WIDTH; x += len) {
+                    if (simd) rasterPixel32(dst, color, x, len);
+                    else cRasterPixels<uint32_t>(dst, color, x, len);
+                }
+            }
+            sink = buffer[0];
+        };
+        _bench("rasterPixel32(color)", "c", params, WIDTH * HEIGHT, "px", [&]{ run(false); });
+        if (strcmp(SIMD, "c")) _bench("rasterPixel32(color)", SIMD, params, WIDTH * HEIGHT, "px", [&]{ run(true); });
+    }
+
+    auto src = _buffer(WIDTH * HEIGHT);
+
+    for (auto opacity : {255, 128}) {
+        snprintf(params, sizeof(params), "opacity %d", opacity);
+        _bench("rasterPixel32(image)", "c", params, WIDTH * HEIGHT, "px", [&]{
+            for (int32_t y = 0; y < HEIGHT; ++y) rasterPixel32(buffer + y * WIDTH, src + y * WIDTH, WIDTH, opacity);
+            sink = buffer[0];
+        });
+        _bench("rasterTranslucentPixel32", "c", params, WIDTH * HEIGHT, "px", [&]{
+            for (int32_t y = 0; y < HEIGHT; ++y) rasterTranslucentPixel32(buffer + y * WIDTH, src + y * WIDTH, WIDTH, opacity);
+            sink = buffer[0];
+        });
+    }
+
+    tvg::free(src);
+}
+
+
+static void _benchRles(SwSurface& surface)
+{
+    char params[32];
+    RenderRegion bbox = {{0, 0}, {WIDTH, HEIGHT}};
+
+    for (auto len : {1, 4, 16, 64, 256, 1024}) {
+        for (auto coverage : {255, 128}) {
+            uint64_t pixels;
+            SwShape shape;
+            shape.rle = _rle(len, coverage, pixels);
+            snprintf(params, sizeof(params), "span %d cov %d", len, coverage);
+
+            //solid, the full coverage spans go through rasterPixel32()
+            _bench("_rasterSolidRle", coverage == 255 ? SIMD : "c", params, pixels, "px", [&]{
+                RenderColor c = {51, 102, 153, 255};
+                rasterShape(&surface, &shape, bbox, c);
+                sink = surface.buf32[0];
+            });
+
+            //translucent
+            if (strcmp(SIMD, "c")) {
+                _bench("_rasterTranslucentRle", "c", params, pixels, "px", [&]{
+                    RenderColor c = {25, 51, 76, 128};
+                    cRasterTranslucentRle(&surface, shape.rle, bbox, c);
+                    sink = surface.buf32[0];
+                });
+            }
+            _bench("_rasterTranslucentRle", SIMD, params, pixels, "px", [&]{
+                RenderColor c = {51, 102, 153, 128};
+                rasterShape(&surface, &shape, bbox, c);
+                sink = surface.buf32[0];
+            });
+
+            //blending
+            surface.blender = opBlendMultiply;
+            _bench("_rasterBlendingRle", "c", params, pixels, "px", [&]{
+                RenderColor c = {51, 102, 153, 128};
+                rasterShape(&surface, &shape, bbox, c);
+                sink = surface.buf32[0];
+            });
+            surface.blender = nullptr;
+
+            rleFree(shape.rle);
+        }
+    }
+}
+
+
+static void _benchRects(SwSurface& surface)
+{
+    char params[32];
+
+    for (auto w : {4, 16, 64, 1024}) {
+        RenderRegion bbox = {{0, 0}, {w, HEIGHT}};
+        SwShape shape;
+        shape.fastTrack = true;
+        snprintf(params, sizeof(params), "%dx%d", w, HEIGHT);
+        auto pixels = uint64_t(w) * HEIGHT;
+
+        _bench("_rasterSolidRect", SIMD, params, pixels, "px", [&]{
+            RenderColor c = {51, 102, 153, 255};
+            rasterShape(&surface, &shape, bbox, c);
+            sink = surface.buf32[0];
+        });
+
+        if (strcmp(SIMD, "c")) {
+            _bench("_rasterTranslucentRect", "c", params, pixels, "px", [&]{
+                RenderColor c = {25, 51, 76, 128};
+                cRasterTranslucentRect(&surface, bbox, c);
+                sink = surface.buf32[0];
+            });
+        }
+        _bench("_rasterTranslucentRect", SIMD, params, pixels, "px", [&]{
+            RenderColor c = {51, 102, 153, 128};
+            rasterShape(&surface, &shape, bbox, c);
+            sink = surface.buf32[0];
+        });
+
+        surface.blender = opBlendMultiply;
+        _bench("_rasterBlendingRect", "c", params, pixels, "px", [&]{
+            RenderColor c = {51, 102, 153, 128};
+            rasterShape(&surface, &shape, bbox, c);
+            sink = surface.buf32[0];
+        });
+        surface.blender = nullptr;
+    }
+}
+
+
+static void _benchFills(SwSurface& surface)
+{
+    static const char* spreads[] = {"pad", "reflect", "repeat"};
+    char params[32];
+    RenderRegion bbox = {{0, 0}, {WIDTH, HEIGHT}};
+    Matrix identity = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+    uint64_t pixels;
+    SwShape shape;
+    shape.rle = _rle(64, 255, pixels);
+
+    for (auto translucent : {false, true}) {
+        Fill::ColorStop stops[] = {{0.0f, 255, 0, 0, 255}, {0.5f, 0, 255, 0, uint8_t(translucent ? 128 : 255)}, {1.0f, 0, 0, 255, 255}};
+        for (auto spread : {FillSpread::Pad, FillSpread::Reflect, FillSpread::Repeat}) {
+            unique_ptr<Fill> fills[] = {unique_ptr<Fill>(LinearGradient::gen()), unique_ptr<Fill>(RadialGradient::gen())};
+            static_cast<LinearGradient*>(fills[0].get())->linear(WIDTH * 0.25f, HEIGHT * 0.25f, WIDTH * 0.75f, HEIGHT * 0.75f);
+            static_cast<RadialGradient*>(fills[1].get())->radial(WIDTH * 0.5f, HEIGHT * 0.5f, WIDTH * 0.25f, WIDTH * 0.4f, HEIGHT * 0.4f, 0.0f);
+
+            for (auto& fdata : fills) {
+                fdata->colorStops(stops, 3);
+                fdata->spread(spread);
+
+                shape.fill = tvg::calloc<SwFill*>(1, sizeof(SwFill));
+                if (!fillGenColorTable(shape.fill, fdata.get(), identity, &surface, 255, true)) {
+                    fillFree(shape.fill);
+                    continue;
+                }
+                auto kernel = (fdata->type() == Type::LinearGradient) ? "fillLinear" : "fillRadial";
+
+                //rect
+                snprintf(params, sizeof(params), "rect %s%s", spreads[int(spread)], translucent ? " alpha" : "");
+                shape.fastTrack = true;
+                _bench(kernel, "c", params, uint64_t(WIDTH) * HEIGHT, "px", [&]{
+                    rasterGradientShape(&surface, &shape, bbox, fdata.get(), 255);
+                    sink = surface.buf32[0];
+                });
+
+                //rle
+                snprintf(params, sizeof(params), "span 64 %s%s", spreads[int(spread)], translucent ? " alpha" : "");
+                shape.fastTrack = false;
+                _bench(kernel, "c", params, pixels, "px", [&]{
+                    rasterGradientShape(&surface, &shape, bbox, fdata.get(), 255);
+                    sink = surface.buf32[0];
+                });
+
+                fillFree(shape.fill);
+                shape.fill = nullptr;
+            }
+        }
+    }
+    rleFree(shape.rle);
+}
+
+
+static void _benchBlenders()
+{
+    constexpr uint32_t CNT = 64 * 1024;
+
+    struct {
+        const char* name;
+        SwBlender op;
+    } blenders[] = {
+        {"opBlendDifference", opBlendDifference}, {"opBlendExclusion", opBlendExclusion}, {"opBlendAdd", opBlendAdd},
+        {"opBlendScreen", opBlendScreen}, {"opBlendMultiply", opBlendMultiply}, {"opBlendOverlay", opBlendOverlay},
+        {"opBlendDarken", opBlendDarken}, {"opBlendLighten", opBlendLighten}, {"opBlendColorDodge", opBlendColorDodge},
+        {"opBlendColorBurn", opBlendColorBurn}, {"opBlendHardLight", opBlendHardLight}, {"opBlendSoftLight", opBlendSoftLight},
+        {"opBlendHue", opBlendHue}, {"opBlendSaturation", opBlendSaturation}, {"opBlendColor", opBlendColor},
+        {"opBlendLuminosity", opBlendLuminosity}
+    };
+
+    struct {
+        const char* name;
+        SwBlenderA op;
+    } blendersA[] = {
+        {"opBlendInterp", opBlendInterp}, {"opBlendNormal", opBlendNormal}, {"opBlendPreNormal", opBlendPreNormal}, {"opBlendSrcOver", opBlendSrcOver}
+    };
+
+    auto src = _buffer(CNT);
+    auto dst = _buffer(CNT);
+
+    for (auto& blender : blendersA) {
+        _bench(blender.name, "c", "alpha 128", CNT, "px", [&]{
+            for (uint32_t i = 0; i < CNT; ++i) dst[i] = blender.op(src[i], dst[i], 128);
+            sink = dst[0];
+        });
+    }
+
+    for (auto& blender : blenders) {
+        _bench(blender.name, "c", "", CNT, "px", [&]{
+            for (uint32_t i = 0; i < CNT; ++i) dst[i] = blender.op(src[i], dst[i]);
+            sink = dst[0];
+        });
+    }
+
+    tvg::free(src);
+    tvg::free(dst);
+}
+
+
+static void _benchGaussian()
+{
+    constexpr int32_t SIZE = 512;
+    char params[32];
+
+    auto front = _buffer(SIZE * SIZE);
+    auto back = _buffer(SIZE * SIZE);
+
+    SwCompositor cmp, buffer;
+    cmp.image.buf32 = front;
+    cmp.image.stride = cmp.image.w = cmp.image.h = SIZE;
+    cmp.image.channelSize = sizeof(uint32_t);
+    cmp.bbox = {{0, 0}, {SIZE, SIZE}};
+    buffer.image = cmp.image;
+    buffer.image.buf32 = back;
+
+    SwSurface surface;
+    _surface(surface, front, SIZE, SIZE);
+    surface.compositor = &buffer;
+
+    Matrix identity = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+    for (auto sigma : {2.0f, 10.0f, 40.0f}) {
+        for (auto direction : {1, 0}) {
+            RenderEffectGaussianBlur blur;
+            blur.sigma = sigma;
+            blur.direction = direction;
+            blur.border = 0;
+            blur.quality = 100;
+            effectGaussianBlurUpdate(&blur, identity);
+            if (blur.valid) {
+                snprintf(params, sizeof(params), "sigma %d %s", int(sigma), direction == 1 ? "horizontal" : "both");
+                _bench("_gaussianFilter", "c", params, SIZE * SIZE, "px", [&]{
+                    effectGaussianBlur(&cmp, &surface, &blur);
+                    sink = cmp.image.buf32[0];
+                });
+            }
+            tvg::free(blur.rd);
+        }
+    }
+
+    //the buffers might be swapped by the effect
+    tvg::free(cmp.image.buf32);
+    tvg::free(buffer.image.buf32);
+}
+
+
+static void _benchRle()
+{
+    RenderRegion bbox = {{0, 0}, {WIDTH, HEIGHT}};
+    Matrix identity = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+    for (auto name : {"circle", "star128", "circles4096"}) {
+        RenderPath path;
+        _path(path, name);
+
+        SwOutline outline{};
+        outline.fillRule = FillRule::NonZero;
+        shapeGenOutline(&outline, path.cmds.data, path.cmds.count, path.pts.data, identity);
+
+        for (auto antiAlias : {true, false}) {
+            auto rle = rleRender(nullptr, &outline, bbox, antiAlias);
+            auto pixels = _count(rle);
+            char params[32];
+            snprintf(params, sizeof(params), "%s%s", name, antiAlias ? " aa" : "");
+            _bench("rleRender", "c", params, pixels, "px", [&]{
+                rleReset(rle);
+                rleRender(rle, &outline, bbox, antiAlias);
+                sink = rle->spans.count;
+            });
+            rleFree(rle);
+        }
+    }
+}
+
+
+static void _benchStroke()
+{
+    Matrix identity = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+    for (auto name : {"circle", "star128", "circles4096"}) {
+        RenderShape rshape;
+        _path(rshape.path, name);
+        rshape.stroke = new RenderStroke;
+        rshape.stroke->width = 4.0f;
+
+        SwOutline outline{};
+        outline.fillRule = FillRule::NonZero;
+        shapeGenOutline(&outline, rshape.path.cmds.data, rshape.path.cmds.count, rshape.path.pts.data, identity);
+
+        for (auto join : {StrokeJoin::Bevel, StrokeJoin::Round, StrokeJoin::Miter}) {
+            static const char* joins[] = {"miter", "round", "bevel"};
+            rshape.stroke->join = join;
+            auto stroke = tvg::calloc<SwStroke*>(1, sizeof(SwStroke));
+            char params[32];
+            snprintf(params, sizeof(params), "%s %s", name, joins[int(join)]);
+            _bench("strokeParseOutline", "c", params, outline.pts.count, "pt", [&]{
+                strokeReset(stroke, &rshape, identity);
+                strokeParseOutline(stroke, outline);
+                sink = stroke->borders[0].ptsCnt;
+            });
+            strokeFree(stroke);
+        }
+    }
+}
+
+
+static void _benchDownScaler(SwSurface& surface)
+{
+    constexpr uint32_t SIZE = 2048;
+
+    SwImage image;
+    image.buf32 = _buffer(SIZE * SIZE);
+    image.w = image.h = image.stride = SIZE;
+    image.channelSize = sizeof(uint32_t);
+    image.scaled = true;
+
+    for (auto scale : {0.4f, 0.25f, 0.1f}) {
+        image.scale = scale;
+        Matrix transform = {scale, 0, 0, 0, scale, 0, 0, 0, 1};
+        auto size = int32_t(SIZE * scale);
+        RenderRegion bbox = {{0, 0}, {size, size}};
+        char params[32];
+        snprintf(params, sizeof(params), "scale %.2f", scale);
+        _bench("_interpDownScaler", "c", params, uint64_t(size) * size, "px", [&]{
+            rasterScaledImage(&surface, image, transform, bbox, 255);
+            sink = surface.buf32[0];
+        });
+    }
+
+    tvg::free(image.buf32);
+}
+
+/************************************************************************/
+/* Main Code                                                            */
+/************************************************************************/
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) filter = argv[1];
+
+    if (Initializer::init(0) != Result::Success) return 1;
+
+    printf("ThorVG SW Engine Kernels (SIMD: %s, Surface: %dx%d)\n", SIMD, WIDTH, HEIGHT);
+    printf("%-26s %-5s %-22s %13s\n", "kernel", "level", "params", "time");
+
+    auto buffer = _buffer(WIDTH * HEIGHT);
+
+    SwSurface surface;
+    _surface(surface, buffer, WIDTH, HEIGHT);
+
+    _benchPixels(buffer);
+    _benchRles(surface);
+    _benchRects(surface);
+    _benchFills(surface);
+    _benchBlenders();
+    _benchGaussian();
+    _benchRle();
+    _benchStroke();
+    _benchDownScaler(surface);
+
+    tvg::free(buffer);
+
+    Initializer::term();
+
+    return 0;
+}
@@ -129,4 +129,68 @@ TEST_CASE("Lottie Marker", "[tvgLottie]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+//Renders the given frame of the text animation into the buffer
+static void _render(SwCanvas* canvas, Animation* animation, float frame, uint32_t* buffer, uint32_t size)
+{
+    memset(buffer, 0, size * size * sizeof(uint32_t));
+    animation->frame(frame);
+    REQUIRE(canvas->update() == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+}
+
+static Animation* _textAnimation(SwCanvas* canvas, const string& data, uint32_t* buffer, uint32_t size)
+{
+    auto animation = Animation::gen();
+    auto picture = animation->picture();
+    REQUIRE(picture->load(data.c_str(), data.size(), "lottie", nullptr, true) == Result::Success);
+    REQUIRE(picture->size(float(size), float(size)) == Result::Success);
+    REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+    REQUIRE(canvas->push(picture) == Result::Success);
+    return animation;
+}
+
+TEST_CASE("Lottie Text Glyphs Reuse", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+
+    ifstream file(TEST_DIR"/test9.json");
+    REQUIRE(file.is_open());
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    //the text of the first visible layer turns into the same glyphs in the other order, then into the shorter one
+    auto key = string(R"("t":"START","j":2,"tr":0,"lh":85.2,"ls":0,"fc":[1,1,1]},"t":0})");
+    auto pos = data.rfind(key);
+    REQUIRE(pos != string::npos);
+    auto animated = data;
+    animated.insert(pos + key.size(), R"(,{"s":{"s":71,"f":"OmnesMedium","t":"TRATS","j":2,"tr":0,"lh":85.2,"ls":0,"fc":[1,1,1]},"t":3})"
+                                      R"(,{"s":{"s":71,"f":"OmnesMedium","t":"RAT","j":2,"tr":0,"lh":85.2,"ls":0,"fc":[1,1,1]},"t":6})");
+
+    {
+        const uint32_t size = 200;
+        uint32_t buffer[size * size];
+        uint32_t expected[size * size];
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        auto animation = unique_ptr<Animation>(_textAnimation(canvas.get(), animated, buffer, size));
+
+        //the glyph shapes of the previous frames must not leak into the next ones
+        struct {float frame; const char* text;} frames[] = {{0.0f, "START"}, {4.0f, "TRATS"}, {1.0f, "START"}, {7.0f, "RAT"}, {5.0f, "TRATS"}, {0.0f, "START"}};
+        for (auto& frame : frames) {
+            _render(canvas.get(), animation.get(), frame.frame, buffer, size);
+
+            //the same frame with the static text which is built freshly
+            auto reference = data;
+            reference.replace(pos + 5, 5, frame.text);
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            auto animation2 = unique_ptr<Animation>(_textAnimation(canvas2.get(), reference, expected, size));
+            _render(canvas2.get(), animation2.get(), frame.frame, expected, size);
+
+            REQUIRE(memcmp(buffer, expected, sizeof(buffer)) == 0);
+        }
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
\ No newline at end of file
@@ -23,13 +23,88 @@
 #include <thorvg.h>
 #include <fstream>
 #include <cstring>
+#include <vector>
 #include "config.h"
 #include "catch.hpp"
+#if defined(TVG_STATIC) && (defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT))
+    #include "../src/loaders/jpg/tvgJpgd.h"
+#endif
+#if defined(THORVG_FILE_IO_SUPPORT) && !defined(_WIN32)
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
 
 using namespace tvg;
 using namespace std;
 
 
+#if defined(THORVG_JPG_LOADER_SUPPORT) || defined(THORVG_WEBP_LOADER_SUPPORT)
+
+//Renders the picture in the given size from the top left corner of the canvas
+static void _render(SwCanvas* canvas, Picture* picture, float size)
+{
+    REQUIRE(picture->size(size, size) == Result::Success);
+    REQUIRE(canvas->push(picture) == Result::Success);
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+    REQUIRE(canvas->remove(picture) == Result::Success);
+}
+
+//Verifies the 512x512 image is decoded in the bitmap size by the size hint.
+//The bitmap drawn in its own size is copied as it is, so the copy scaled up must be the same with the decoded bitmap scaled up.
+static void _hinted(const char* path, float hint, uint32_t bitmap)
+{
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    REQUIRE(canvas);
+
+    vector<uint32_t> buffer(512 * 512);
+    REQUIRE(canvas->target(buffer.data(), 512, 512, 512, ColorSpace::ARGB8888) == Result::Success);
+
+    auto picture = Picture::gen();
+    REQUIRE(picture);
+    picture->ref();
+
+    //The size given before loading is kept and lets the image be decoded in a reduced size
+    REQUIRE(picture->size(hint, hint) == Result::Success);
+    REQUIRE(picture->load(path) == Result::Success);
+
+    float w, h;
+    REQUIRE(picture->size(&w, &h) == Result::Success);
+    REQUIRE(w == hint);
+    REQUIRE(h == hint);
+
+    _render(canvas.get(), picture, float(bitmap));
+    vector<uint32_t> pixels(bitmap * bitmap);
+    for (uint32_t y = 0; y < bitmap; ++y) memcpy(&pixels[y * bitmap], &buffer[y * 512], bitmap * sizeof(uint32_t));
+    REQUIRE(pixels.front() != 0);
+    REQUIRE(pixels.back() != 0);
+
+    auto copy = Picture::gen();
+    REQUIRE(copy);
+    copy->ref();
+    REQUIRE(copy->load(pixels.data(), bitmap, bitmap, ColorSpace::ARGB8888, true) == Result::Success);
+
+    _render(canvas.get(), copy, 512);
+    auto expected = buffer;
+    _render(canvas.get(), picture, 512);
+    REQUIRE(memcmp(buffer.data(), expected.data(), 512 * 512 * sizeof(uint32_t)) == 0);
+
+    //the full decoding has more details than the scaled up bitmap
+    auto full = Picture::gen();
+    REQUIRE(full);
+    full->ref();
+    REQUIRE(full->load(path) == Result::Success);
+    _render(canvas.get(), full, 512);
+    REQUIRE(memcmp(buffer.data(), expected.data(), 512 * 512 * sizeof(uint32_t)) != 0);
+
+    full->unref();
+    copy->unref();
+    picture->unref();
+}
+
+#endif
+
 TEST_CASE("Picture Creation", "[tvgPicture]")
 {
     auto picture = unique_ptr<Picture>(Picture::gen());
@@ -227,6 +302,337 @@ TEST_CASE("Load SVG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Load SVG Path Data Numbers", "[tvgPicture]")
+{
+    //Fuzz the path data number conversion against the generic one(toFloat) of the line attributes
+    static const char* formats[] = {"%.0f", "%.1f", "%.3f", "%.6f", "%.9f", "%e", "%.2E", "%g", "%.12g"};
+    static constexpr int CNT = 512;
+
+    string path = "M";
+    string lines;
+    string coord[4];
+    char prev[64] = "";
+    uint32_t seed = 12345;
+
+    for (int i = 0; i < CNT; ++i) {
+        seed = seed * 1103515245 + 12345;
+        auto mag = powf(10.0f, float(int(seed >> 16) % 9 - 4));
+        seed = seed * 1103515245 + 12345;
+        auto val = (float(seed >> 8) / float(1 << 24) - 0.5f) * mag;
+
+        char buf[64];
+        snprintf(buf, sizeof(buf), formats[(seed >> 4) % (sizeof(formats) / sizeof(formats[0]))], val);
+
+        //strip the leading zero (ex: "0.5" -> ".5") to exercise the compact forms
+        auto str = buf;
+        if ((seed & 0x10000) && !strncmp(str, "0.", 2)) ++str;
+
+        //mix up the separators, they can be omitted if the next number is not ambiguous
+        if (i > 0) {
+            if (str[0] == '-' || (str[0] == '.' && strchr(prev, '.'))) {
+                if (seed & 0x20000) path += ",";
+            } else path += (seed & 0x40000) ? "," : " ";
+        }
+        path += str;
+        if (i == 1) path += "L";
+        strcpy(prev, str);
+
+        //the same numbers as the line coordinates: a line per two points
+        coord[i % 4] = str;
+        if (i % 4 == 3) lines += "<line x1=\"" + coord[0] + "\" y1=\"" + coord[1] + "\" x2=\"" + coord[2] + "\" y2=\"" + coord[3] + "\"/>";
+    }
+
+    auto header = string("<svg viewBox=\"0 0 100 100\" xmlns=\"http://www.w3.org/2000/svg\">");
+    auto svg = header + "<path d=\"" + path + "\"/></svg>";
+    auto ref = header + lines + "</svg>";
+
+    //collect the points of all the shapes in order
+    auto f = [](const tvg::Paint* paint, void* data) -> bool
+    {
+        if (paint->type() == Type::Shape) {
+            const Point* pts;
+            uint32_t ptsCnt;
+            static_cast<const Shape*>(paint)->path(nullptr, nullptr, &pts, &ptsCnt);
+            auto ret = static_cast<vector<Point>*>(data);
+            ret->insert(ret->end(), pts, pts + ptsCnt);
+        }
+        return true;
+    };
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto accessor = unique_ptr<Accessor>(Accessor::gen());
+
+        vector<Point> pts;
+        auto picture = unique_ptr<Picture>(Picture::gen());
+        REQUIRE(picture->load(svg.c_str(), svg.size(), "svg", nullptr, true) == Result::Success);
+        REQUIRE(accessor->set(picture.get(), f, &pts) == Result::Success);
+
+        vector<Point> expected;
+        auto picture2 = unique_ptr<Picture>(Picture::gen());
+        REQUIRE(picture2->load(ref.c_str(), ref.size(), "svg", nullptr, true) == Result::Success);
+        REQUIRE(accessor->set(picture2.get(), f, &expected) == Result::Success);
+
+        REQUIRE(pts.size() == CNT / 2);
+        REQUIRE(expected.size() == CNT / 2);
+
+        //both conversions scale the whole significand once, they must agree exactly
+        for (size_t i = 0; i < pts.size(); ++i) {
+            REQUIRE(pts[i].x == expected[i].x);
+            REQUIRE(pts[i].y == expected[i].y);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load SVG Data with CSS Style", "[tvgPicture]")
+{
+    static const char* svg = "<svg viewBox=\"0 0 100 100\" xmlns=\"http://www.w3.org/2000/svg\"><circle id=\"c0\" class=\"b\" r=\"5\"/><style>.a{fill:#ff0000} rect.a{fill:#00ff00} .b{fill:#0000ff} .a{fill:#ffffff} rect{stroke:#000000}</style><rect id=\"r0\" class=\"a\" width=\"10\" height=\"10\"/><circle id=\"c1\" class=\"a\" r=\"5\"/><rect id=\"r1\" class=\"c\" width=\"10\" height=\"10\"/></svg>";
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto picture = unique_ptr<Picture>(Picture::gen());
+        REQUIRE(picture->load(svg, strlen(svg), "svg") == Result::Success);
+
+        auto accessor = unique_ptr<Accessor>(Accessor::gen());
+        auto f = [](const tvg::Paint* paint, void* data) -> bool
+        {
+            if (paint->type() != Type::Shape) return true;
+            auto shape = static_cast<const Shape*>(paint);
+            uint8_t r, g, b;
+            shape->fill(&r, &g, &b);
+
+            //postponed: the class rule is declared after the node
+            if (paint->id == Accessor::id("c0")) {
+                REQUIRE((r == 0 && g == 0 && b == 255));
+            //tag.name has higher priority than .name
+            } else if (paint->id == Accessor::id("r0")) {
+                REQUIRE((r == 0 && g == 255 && b == 0));
+            //the first declared rule wins
+            } else if (paint->id == Accessor::id("c1")) {
+                REQUIRE((r == 255 && g == 0 && b == 0));
+            //no class rule, the tag rule only
+            } else if (paint->id == Accessor::id("r1")) {
+                REQUIRE((r == 0 && g == 0 && b == 0));
+                REQUIRE(shape->strokeWidth() > 0.0f);
+            } else return true;
+            ++(*static_cast<int*>(data));
+            return true;
+        };
+        auto cnt = 0;
+        REQUIRE(accessor->set(picture.get(), f, &cnt) == Result::Success);
+        REQUIRE(cnt == 4);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load SVG Data with independent groups", "[tvgPicture]")
+{
+    static const char* svg = "<svg viewBox=\"0 0 100 100\" xmlns=\"http://www.w3.org/2000/svg\"><defs><clipPath id=\"c\"><rect width=\"50\" height=\"50\"/></clipPath></defs><g fill=\"#ff0000\"><path d=\"M0 0h40v40H0z\"/><circle cx=\"20\" cy=\"20\" r=\"10\" fill=\"#00ff00\"/></g><g clip-path=\"url(#c)\"><rect x=\"30\" y=\"30\" width=\"40\" height=\"40\" fill=\"#0000ff\"/></g><g opacity=\"0.5\"><g transform=\"translate(50 50)\"><rect width=\"50\" height=\"50\"/></g></g><path d=\"M0 90h100v10H0z\"/><g stroke=\"#000000\"><line x1=\"0\" y1=\"0\" x2=\"100\" y2=\"100\"/></g></svg>";
+
+    //The multi-threaded scene build must produce the same result as the serial one
+    uint32_t* buffers[2];
+    uint32_t threads[2] = {0, 4};
+
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init(threads[i]) == Result::Success);
+        {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas);
+
+            buffers[i] = new uint32_t[100*100];
+            REQUIRE(canvas->target(buffers[i], 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+            auto picture = Picture::gen();
+            REQUIRE(picture->load(svg, strlen(svg), "svg") == Result::Success);
+            REQUIRE(canvas->push(picture) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+
+    REQUIRE(memcmp(buffers[0], buffers[1], 100 * 100 * sizeof(uint32_t)) == 0);
+
+    delete[] buffers[0];
+    delete[] buffers[1];
+}
+
+#ifdef THORVG_SVG_CULLING_SUPPORT
+
+TEST_CASE("Load SVG Data with viewport culling", "[tvgPicture]")
+{
+    //a grid of top-level elements, large enough to be spatially indexed
+    string svg = "<svg viewBox=\"0 0 80 80\" xmlns=\"http://www.w3.org/2000/svg\">";
+    char buf[128];
+    for (int i = 0; i < 64; ++i) {
+        snprintf(buf, sizeof(buf), "<rect x=\"%d\" y=\"%d\" width=\"8\" height=\"8\" fill=\"#%02x%02x80\" stroke=\"#000\" stroke-width=\"2\"/>", (i % 8) * 10, (i / 8) * 10, i * 4, 255 - i * 4);
+        svg += buf;
+    }
+    svg += "</svg>";
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t full[80*80];
+        uint32_t tile[80*80];
+
+        REQUIRE(canvas->target(full, 80, 80, 80, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(svg.c_str(), svg.size(), "svg") == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //every tile must be identical to the corresponding region of the whole rendering
+        REQUIRE(canvas->target(tile, 80, 80, 80, ColorSpace::ARGB8888) == Result::Success);
+
+        for (int t = 0; t < 4; ++t) {
+            auto x = (t % 2) * 40;
+            auto y = (t / 2) * 40;
+            memset(tile, 0, sizeof(tile));
+            REQUIRE(canvas->viewport(x, y, 40, 40) == Result::Success);
+            REQUIRE(canvas->draw(false) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            for (int j = y; j < y + 40; ++j) {
+                REQUIRE(memcmp(tile + j * 80 + x, full + j * 80 + x, 40 * sizeof(uint32_t)) == 0);
+            }
+        }
+
+        //move the last element(culled now) into the first tile, it must not be culled by the stale bounds.
+        auto accessor = unique_ptr<Accessor>(Accessor::gen());
+        auto f = [](const tvg::Paint* paint, void* data) -> bool
+        {
+            if (paint->type() == Type::Shape) *static_cast<const Paint**>(data) = paint;
+            return true;
+        };
+        const Paint* last = nullptr;
+        REQUIRE(accessor->set(picture, f, &last) == Result::Success);
+        REQUIRE(last);
+        auto layer = const_cast<Scene*>(static_cast<const Scene*>(last->parent()));
+        REQUIRE(layer);
+        auto first = const_cast<Paint*>(layer->paints().front());
+        REQUIRE(const_cast<Paint*>(last)->translate(-55.0f, -55.0f) == Result::Success);
+
+        memset(tile, 0, sizeof(tile));
+        REQUIRE(canvas->viewport(0, 0, 40, 40) == Result::Success);
+        REQUIRE(canvas->draw(false) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(canvas->target(full, 80, 80, 80, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        for (int j = 0; j < 40; ++j) {
+            REQUIRE(memcmp(tile + j * 80, full + j * 80, 40 * sizeof(uint32_t)) == 0);
+        }
+
+        //the culled element must be shown again once it's detached from the document
+        REQUIRE(canvas->target(tile, 80, 80, 80, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->viewport(40, 40, 40, 40) == Result::Success);
+        REQUIRE(canvas->draw(false) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        first->ref();
+        REQUIRE(layer->remove(first) == Result::Success);
+        REQUIRE(canvas->push(first) == Result::Success);
+        first->unref(false);
+        REQUIRE(canvas->draw(false) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        memset(tile, 0, sizeof(tile));
+        REQUIRE(canvas->viewport(0, 0, 40, 40) == Result::Success);
+        REQUIRE(canvas->draw(false) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(first->visible());
+        REQUIRE(tile[4 * 80 + 4] == 0xff00ff80);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+#if defined(THORVG_SVG_CACHE_DIR) && defined(THORVG_FILE_IO_SUPPORT) && !defined(_WIN32)
+
+TEST_CASE("Load SVG Data with the persistent cache", "[tvgPicture]")
+{
+    static const char* svg = "<svg viewBox=\"0 0 100 100\" xmlns=\"http://www.w3.org/2000/svg\"><defs><linearGradient id=\"l\"><stop offset=\"0\" stop-color=\"#ff0000\"/><stop offset=\"1\" stop-color=\"#0000ff\"/></linearGradient><clipPath id=\"c\"><circle cx=\"50\" cy=\"50\" r=\"40\"/></clipPath></defs><g clip-path=\"url(#c)\"><rect width=\"100\" height=\"100\" fill=\"url(#l)\"/></g><path d=\"M10 90L90 10\" stroke=\"#00ff00\" stroke-width=\"5\" stroke-dasharray=\"5 3\"/></svg>";
+
+    //the directory could be shared with the others, only the entries of the same content size are taken care of.
+    auto dir = THORVG_SVG_CACHE_DIR;
+    mkdir(dir, 0700);
+
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "-%08x.tvgs", (uint32_t)strlen(svg));
+    auto slen = strlen(suffix);
+
+    auto entry = [&](string& path, struct stat& st, bool clear) -> int {
+        int cnt = 0;
+        auto d = opendir(dir);
+        if (!d) return 0;
+        while (auto e = readdir(d)) {
+            auto len = strlen(e->d_name);
+            if (len < slen || strcmp(e->d_name + len - slen, suffix)) continue;
+            path = string(dir) + "/" + e->d_name;
+            if (clear) remove(path.c_str());
+            else ++cnt;
+        }
+        closedir(d);
+        if (cnt == 1) stat(path.c_str(), &st);
+        return cnt;
+    };
+
+    //1st: build and store the scene, 2nd: restore the scene from the cache
+    uint32_t* buffers[2];
+    string path;
+    struct stat st[2];
+
+    entry(path, st[0], true);
+
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init() == Result::Success);
+        {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas);
+
+            buffers[i] = new uint32_t[100*100];
+            REQUIRE(canvas->target(buffers[i], 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+            auto picture = Picture::gen();
+            REQUIRE(picture->load(svg, strlen(svg), "svg") == Result::Success);
+
+            float w, h;
+            REQUIRE(picture->size(&w, &h) == Result::Success);
+            REQUIRE(w == 100);
+            REQUIRE(h == 100);
+
+            REQUIRE(canvas->push(picture) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+
+        REQUIRE(entry(path, st[i], false) == 1);
+    }
+
+    //a miss replaces the entry with a new file, the hit leaves it untouched
+    REQUIRE(st[0].st_ino == st[1].st_ino);
+    REQUIRE(st[0].st_mtime == st[1].st_mtime);
+
+    REQUIRE(memcmp(buffers[0], buffers[1], 100 * 100 * sizeof(uint32_t)) == 0);
+
+    REQUIRE(remove(path.c_str()) == 0);
+
+    delete[] buffers[0];
+    delete[] buffers[1];
+}
+
+#endif
+
 #endif
 
 #ifdef THORVG_PNG_LOADER_SUPPORT
@@ -294,6 +700,403 @@ TEST_CASE("Load PNG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+//A minimal png encoder to control the filter of each row and the deflate blocks
+struct PngWriter
+{
+    vector<uint8_t> data;
+    uint32_t bits = 0, bitCnt = 0;
+
+    void bit(uint32_t value, uint32_t cnt)
+    {
+        bits |= value << bitCnt;
+        bitCnt += cnt;
+        while (bitCnt >= 8) {
+            data.push_back(uint8_t(bits));
+            bits >>= 8;
+            bitCnt -= 8;
+        }
+    }
+
+    //huffman codes are packed from the most significant bit
+    void code(uint32_t value, uint32_t cnt)
+    {
+        for (uint32_t i = cnt; i > 0; --i) bit((value >> (i - 1)) & 1, 1);
+    }
+
+    void flush()
+    {
+        if (bitCnt > 0) bit(0, 8 - bitCnt);
+    }
+
+    void be32(uint32_t value)
+    {
+        for (int i = 3; i >= 0; --i) data.push_back(uint8_t(value >> (i * 8)));
+    }
+
+    void literal(uint32_t value)
+    {
+        if (value < 144) code(0x30 + value, 8);
+        else if (value < 256) code(0x190 + value - 144, 9);
+        else if (value < 280) code(value - 256, 7);
+        else code(0xc0 + value - 280, 8);
+    }
+
+    void match(uint32_t length, uint32_t distance)
+    {
+        static const uint16_t lbase[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const uint8_t lextra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const uint16_t dbase[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        static const uint8_t dextra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        auto l = 28;
+        while (lbase[l] > length) --l;
+        literal(257 + l);
+        bit(length - lbase[l], lextra[l]);
+
+        auto d = 29;
+        while (dbase[d] > distance) --d;
+        code(d, 5);
+        bit(distance - dbase[d], dextra[d]);
+    }
+
+    void chunk(const char* type, const vector<uint8_t>& body)
+    {
+        be32(uint32_t(body.size()));
+        auto begin = data.size();
+        data.insert(data.end(), type, type + 4);
+        data.insert(data.end(), body.begin(), body.end());
+        uint32_t crc = 0xffffffff;
+        for (auto i = begin; i < data.size(); ++i) {
+            crc ^= data[i];
+            for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xedb88320 & (0u - (crc & 1)));
+        }
+        be32(~crc);
+    }
+};
+
+static uint8_t _paeth(int a, int b, int c)
+{
+    auto p = a + b - c;
+    auto pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    if (pb <= pc) return b;
+    return c;
+}
+
+//rows are filtered with the none, sub, up, average and paeth filters in turn, from the given one
+static vector<uint8_t> _png(const uint8_t* pixels, uint32_t w, uint32_t h, uint32_t bpp, uint32_t first, bool compress)
+{
+    auto stride = w * bpp;
+    vector<uint8_t> raw;
+    for (uint32_t y = 0; y < h; ++y) {
+        auto filter = (y + first) % 5;
+        raw.push_back(filter);
+        auto cur = pixels + y * stride;
+        auto up = y > 0 ? cur - stride : nullptr;
+        for (uint32_t x = 0; x < stride; ++x) {
+            int a = x >= bpp ? cur[x - bpp] : 0;
+            int b = up ? up[x] : 0;
+            int c = (up && x >= bpp) ? up[x - bpp] : 0;
+            uint8_t pred[] = {0, uint8_t(a), uint8_t(b), uint8_t((a + b) / 2), _paeth(a, b, c)};
+            raw.push_back(uint8_t(cur[x] - pred[filter]));
+        }
+    }
+
+    PngWriter zlib;
+    zlib.data = {0x78, 0x01};
+    if (compress) {
+        //a fixed huffman block with the greedy lz77 matches, including the overlapped ones
+        zlib.bit(1, 1);
+        zlib.bit(1, 2);
+        for (uint32_t i = 0; i < raw.size();) {
+            uint32_t length = 0, distance = 0;
+            for (uint32_t d = 1; d <= i && d <= 1024; ++d) {
+                uint32_t l = 0;
+                while (l < 258 && i + l < raw.size() && raw[i + l] == raw[i + l - d]) ++l;
+                if (l > length) {
+                    length = l;
+                    distance = d;
+                }
+            }
+            if (length >= 3) {
+                zlib.match(length, distance);
+                i += length;
+            } else zlib.literal(raw[i++]);
+        }
+        zlib.literal(256);
+        zlib.flush();
+    } else {
+        //stored blocks
+        for (uint32_t i = 0; i < raw.size(); i += 1000) {
+            uint32_t size = min(uint32_t(raw.size()) - i, 1000u);
+            zlib.bit(i + size == raw.size() ? 1 : 0, 1);
+            zlib.bit(0, 2);
+            zlib.flush();
+            zlib.data.push_back(uint8_t(size));
+            zlib.data.push_back(uint8_t(size >> 8));
+            zlib.data.push_back(uint8_t(~size));
+            zlib.data.push_back(uint8_t(~size >> 8));
+            zlib.data.insert(zlib.data.end(), raw.begin() + i, raw.begin() + i + size);
+        }
+    }
+    uint32_t s1 = 1, s2 = 0;
+    for (auto v : raw) {
+        s1 = (s1 + v) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    zlib.be32((s2 << 16) | s1);
+
+    PngWriter png;
+    png.data = {0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a};
+    vector<uint8_t> header = {uint8_t(w >> 24), uint8_t(w >> 16), uint8_t(w >> 8), uint8_t(w), uint8_t(h >> 24), uint8_t(h >> 16), uint8_t(h >> 8), uint8_t(h), 8, uint8_t(bpp == 4 ? 6 : 2), 0, 0, 0};
+    png.chunk("IHDR", header);
+    png.chunk("IDAT", zlib.data);
+    png.chunk("IEND", {});
+    return png.data;
+}
+
+TEST_CASE("Load PNG data with all the filter types", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //odd width to leave the remainders of the vectorized unfilters
+        const uint32_t w = 61, h = 25;
+
+        uint32_t buffer[w * h];
+        uint32_t expected[w * h];
+
+        auto render = [&](Picture* picture, uint32_t* buffer) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, w, w, h, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->push(picture) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        //gradients with the noise, the flat runs and the repeated rows
+        uint32_t seed = 12345;
+        vector<uint8_t> rgba(w * h * 4);
+        for (uint32_t y = 0; y < h; ++y) {
+            for (uint32_t x = 0; x < w; ++x) {
+                auto p = &rgba[(y * w + x) * 4];
+                seed = seed * 1103515245 + 12345;
+                if (y % 7 == 3) memcpy(p, p - w * 4, 4);
+                else if (x > w / 2 && x < w * 3 / 4) p[0] = p[1] = p[2] = p[3] = 200;
+                else {
+                    p[0] = uint8_t(x * 4 + (seed >> 28));
+                    p[1] = uint8_t(y * 9);
+                    p[2] = uint8_t(seed >> 16);
+                    p[3] = uint8_t(255 - x);
+                }
+            }
+        }
+
+        for (uint32_t bpp = 3; bpp <= 4; ++bpp) {
+            //the reference is the raw image with the same straight pixels
+            vector<uint32_t> pixels(w * h);
+            vector<uint8_t> packed(w * h * bpp);
+            for (uint32_t i = 0; i < w * h; ++i) {
+                auto p = &rgba[i * 4];
+                auto a = bpp == 4 ? p[3] : 255;
+                pixels[i] = (uint32_t(a) << 24) | (p[2] << 16) | (p[1] << 8) | p[0];
+                memcpy(&packed[i * bpp], p, bpp);
+            }
+
+            auto raw = Picture::gen();
+            REQUIRE(raw->load(pixels.data(), w, h, ColorSpace::ABGR8888S, true) == Result::Success);
+            render(raw, expected);
+
+            //every filter also comes to the first row which has no previous one
+            for (uint32_t first = 0; first < 5; ++first) {
+                for (auto compress : {false, true}) {
+                    auto png = _png(packed.data(), w, h, bpp, first, compress);
+
+                    auto picture = Picture::gen();
+                    REQUIRE(picture->load((const char*)png.data(), uint32_t(png.size()), "png", nullptr, true) == Result::Success);
+                    render(picture, buffer);
+
+                    REQUIRE(memcmp(buffer, expected, sizeof(buffer)) == 0);
+                }
+            }
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#ifndef _WIN32
+
+TEST_CASE("Load PNG file with the image cache budget", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    REQUIRE(Initializer::cache(1024) == Result::Success);
+    {
+        ifstream file(TEST_DIR"/test.png", ios::in | ios::binary | ios::ate);
+        REQUIRE(file.is_open());
+        auto size = (uint32_t)file.tellg();
+        file.seekg(0);
+        auto data = (char*)malloc(size);
+        file.read(data, size);
+        file.close();
+
+        auto data2 = (char*)malloc(size);
+        memcpy(data2, data, size);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        picture->ref();
+        REQUIRE(picture->load(data, size, "png", "", true) == Result::Success);
+
+        auto picture2 = Picture::gen();
+        REQUIRE(picture2);
+        REQUIRE(picture2->load(data2, size, "png", "", true) == Result::Success);
+
+        free(data);
+        free(data2);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        uint32_t expected[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(picture->size(100, 100) == Result::Success);
+
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        memcpy(expected, buffer, sizeof(buffer));
+        REQUIRE(canvas->remove(picture) == Result::Success);
+
+    #ifdef THORVG_FILE_IO_SUPPORT
+        //a file image is decoded again from the path, the file is replaced to see the eviction.
+        char dir[] = "/tmp/tvgImageCacheXXXXXX";
+        REQUIRE(mkdtemp(dir));
+        auto path = string(dir) + "/test.png";
+        {
+            ifstream in(TEST_DIR"/test.png", ios::binary);
+            ofstream out(path, ios::binary);
+            out << in.rdbuf();
+        }
+
+        auto picture3 = Picture::gen();
+        REQUIRE(picture3);
+        picture3->ref();
+        REQUIRE(picture3->load(path.c_str()) == Result::Success);
+        REQUIRE(picture3->size(100, 100) == Result::Success);
+        REQUIRE(canvas->push(picture3) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(expected, buffer, sizeof(buffer)) == 0);
+        REQUIRE(canvas->remove(picture3) == Result::Success);
+
+        {
+            vector<uint8_t> blue(16 * 16 * 4);
+            for (uint32_t i = 0; i < blue.size(); i += 4) blue[i + 2] = blue[i + 3] = 255;
+            auto png = _png(blue.data(), 16, 16, 4, 0, false);
+            ofstream out(path, ios::binary | ios::trunc);
+            out.write((const char*)png.data(), png.size());
+        }
+    #endif
+
+        //the unused image is evicted over the budget
+        auto shape = Shape::gen();
+        REQUIRE(shape);
+        REQUIRE(shape->appendRect(0, 0, 50, 50) == Result::Success);
+        REQUIRE(shape->fill(255, 0, 0) == Result::Success);
+        REQUIRE(canvas->push(shape) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(canvas->remove() == Result::Success);
+
+        //decoded again on demand
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(expected, buffer, sizeof(buffer)) == 0);
+        REQUIRE(canvas->remove() == Result::Success);
+
+    #ifdef THORVG_FILE_IO_SUPPORT
+        //the replaced file is decoded only if the previous pixels were evicted
+        REQUIRE(canvas->push(picture3) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(buffer[50 * 100 + 50] == 0xff0000ff);
+        REQUIRE(canvas->remove() == Result::Success);
+        picture3->unref();
+
+        REQUIRE(unlink(path.c_str()) == 0);
+        REQUIRE(rmdir(dir) == 0);
+    #endif
+
+        //the same contents share the decoded image regardless of the data pointers
+        REQUIRE(picture2->size(100, 100) == Result::Success);
+        REQUIRE(canvas->push(picture2) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(expected, buffer, sizeof(buffer)) == 0);
+        REQUIRE(canvas->remove() == Result::Success);
+
+        //the different contents of the same size and the same checksum(djb2) must not share the decoded image
+        uint8_t red[8 * 8 * 4] = {}, green[8 * 8 * 4] = {};
+        for (uint32_t i = 0; i < sizeof(red); i += 4) {
+            red[i] = red[i + 3] = 255;
+            green[i + 1] = green[i + 3] = 255;
+        }
+        auto png = _png(red, 8, 8, 4, 0, false);
+        auto png2 = _png(green, 8, 8, 4, 0, false);
+        REQUIRE(png.size() == png2.size());
+
+        //the trailing bytes after the IEND chunk are ignored by the decoder, they make up the checksum.
+        auto djb2 = [](const vector<uint8_t>& data) {
+            uint64_t hash = 5381;
+            for (auto c : data) hash = hash * 33 + c;
+            return hash;
+        };
+        png.resize(png.size() + 13, 0);
+        auto target = djb2(png);
+        auto hash = djb2(png2);
+        for (int i = 0; i < 13; ++i) hash *= 33;
+        auto remain = target - hash;
+        uint8_t digits[13];
+        for (int i = 12; i >= 0; --i) {
+            digits[i] = uint8_t(remain % 33);
+            remain /= 33;
+        }
+        png2.insert(png2.end(), digits, digits + 13);
+        REQUIRE(djb2(png) == djb2(png2));
+        REQUIRE(memcmp(png.data(), png2.data(), png.size()) != 0);
+
+        auto picture4 = Picture::gen();
+        REQUIRE(picture4->load((const char*)png.data(), png.size(), "png", "", true) == Result::Success);
+        auto picture5 = Picture::gen();
+        REQUIRE(picture5->load((const char*)png2.data(), png2.size(), "png", "", true) == Result::Success);
+        REQUIRE(picture4->size(100, 100) == Result::Success);
+        REQUIRE(picture5->size(100, 100) == Result::Success);
+        REQUIRE(canvas->push(picture4) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(buffer[50 * 100 + 50] == 0xffff0000);
+        REQUIRE(canvas->remove() == Result::Success);
+        REQUIRE(canvas->push(picture5) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(buffer[50 * 100 + 50] == 0xff00ff00);
+        REQUIRE(canvas->remove() == Result::Success);
+
+        //the evicted image is still decoded again after the image cache is disabled
+        REQUIRE(Initializer::cache(0) == Result::Success);
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(expected, buffer, sizeof(buffer)) == 0);
+
+        picture->unref();
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
 #endif
 
 #ifdef THORVG_JPG_LOADER_SUPPORT
@@ -363,6 +1166,41 @@ TEST_CASE("Load JPG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+#if defined(TVG_STATIC) && (defined(THORVG_AVX_VECTOR_SUPPORT) || defined(THORVG_NEON_VECTOR_SUPPORT))
+
+TEST_CASE("Load JPG file by the vector and the scalar paths", "[tvgPicture]")
+{
+    //the vector idct and color conversion must reproduce the scalar decoding bit by bit
+    int w, h, w2, h2;
+    auto simd = jpgdHeader(TEST_DIR"/test.jpg", &w, &h);
+    auto scalar = jpgdHeader(TEST_DIR"/test.jpg", &w2, &h2);
+    REQUIRE(simd);
+    REQUIRE(scalar);
+    REQUIRE(w == w2);
+    REQUIRE(h == h2);
+
+    auto decoded = jpgdDecompress(simd, 0, true);
+    auto expected = jpgdDecompress(scalar, 0, false);
+    REQUIRE(decoded);
+    REQUIRE(expected);
+    REQUIRE(memcmp(decoded, expected, w * h * 4) == 0);
+
+    free(decoded);
+    free(expected);
+    jpgdDelete(simd);
+    jpgdDelete(scalar);
+}
+
+#endif
+
+TEST_CASE("Load JPG file in the hinted size", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    //the 1/4 scale is the smallest one which is not smaller than the hint
+    _hinted(TEST_DIR"/test.jpg", 100, 128);
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
 
 #ifdef THORVG_WEBP_LOADER_SUPPORT
@@ -430,5 +1268,13 @@ TEST_CASE("Load WEBP file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Load WEBP file in the hinted size", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    //the image is rescaled to the hint while decoding
+    _hinted(TEST_DIR"/test.webp", 100, 100);
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
 
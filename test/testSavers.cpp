@@ -22,6 +22,10 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
 #include "config.h"
 #include "catch.hpp"
 
@@ -34,6 +38,57 @@ TEST_CASE("Saver Creation", "[tvgSavers]")
     REQUIRE(saver);
 }
 
+#if (defined(THORVG_GIF_SAVER_SUPPORT) || defined(THORVG_Y4M_SAVER_SUPPORT)) && defined(THORVG_LOTTIE_LOADER_SUPPORT)
+
+//gathers the streamed output
+static bool _write(const uint8_t* chunk, uint32_t size, void* data)
+{
+    static_cast<string*>(data)->append(reinterpret_cast<const char*>(chunk), size);
+    return true;
+}
+
+//pixel aligned rectangles jumping around, the frames are rendered in the exact colors on any backend.
+static string _rectsLottie()
+{
+    string json = "{\"v\":\"5.7.0\",\"fr\":10,\"ip\":0,\"op\":10,\"w\":64,\"h\":64,\"layers\":[";
+    const char* colors[] = {"[1,0,0,1]", "[0,0.5,1,1]", "[0.2,0.8,0.2,1]", "[1,1,0,1]"};
+    for (int i = 0; i < 4; ++i) {
+        char buf[512];
+        snprintf(buf, sizeof(buf), "%s{\"ty\":4,\"ip\":0,\"op\":10,\"st\":0,\"ks\":{\"p\":{\"a\":1,\"k\":[{\"t\":0,\"s\":[%d,%d],\"h\":1},{\"t\":%d,\"s\":[%d,%d],\"h\":1},{\"t\":%d,\"s\":[%d,%d]}]}},"
+                 "\"shapes\":[{\"ty\":\"rc\",\"p\":{\"a\":0,\"k\":[0,0]},\"s\":{\"a\":0,\"k\":[%d,%d]},\"r\":{\"a\":0,\"k\":0}},{\"ty\":\"fl\",\"c\":{\"a\":0,\"k\":%s},\"o\":{\"a\":0,\"k\":100}}]}",
+                 i ? "," : "", 10 + i * 12, 12 + i * 8, 3 + i, 20 + i * 10, 40 - i * 6, 8, 30 - i * 4, 20 + i * 9, 12 + i * 4, 16 - i * 2, colors[i]);
+        json += buf;
+    }
+    json += "]}";
+    return json;
+}
+
+#endif
+
+#if ((defined(THORVG_GIF_SAVER_SUPPORT) || defined(THORVG_Y4M_SAVER_SUPPORT)) && defined(THORVG_LOTTIE_LOADER_SUPPORT)) || (defined(THORVG_PNG_SAVER_SUPPORT) && defined(THORVG_SVG_LOADER_SUPPORT))
+
+//saves with the given threads, the output is the file of the path if it's given or the streamed data. empty on failure.
+static string _save(uint32_t threads, const char* path, const function<Result(Saver* saver, string* output)>& save)
+{
+    string output;
+    if (Initializer::init(threads) != Result::Success) return output;
+    auto saved = false;
+    {
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        saved = save(saver.get(), &output) == Result::Success && saver->sync() == Result::Success;
+    }
+    Initializer::term();
+    if (!saved) return string();
+
+    if (path) {
+        ifstream file(path, ios::binary);
+        output.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+    return output;
+}
+
+#endif
+
 #if defined(THORVG_GIF_SAVER_SUPPORT) && defined(THORVG_LOTTIE_LOADER_SUPPORT)
 
 TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
@@ -49,7 +104,7 @@ TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
 
         auto saver =  unique_ptr<Saver>(Saver::gen());
         REQUIRE(saver);
-        REQUIRE(saver->save(animation, TEST_DIR"/test.gif") == Result::Success);
+        REQUIRE(saver->save(animation, TEST_OUTPUT_DIR"/test.gif") == Result::Success);
         REQUIRE(saver->sync() == Result::Success);
 
         //with a background
@@ -66,9 +121,497 @@ TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
         REQUIRE(bg->appendRect(0, 0, 100, 100) == Result::Success);
 
         REQUIRE(saver->background(bg) == Result::Success);
-        REQUIRE(saver->save(animation2, TEST_DIR"/test.gif") == Result::Success);
+        REQUIRE(saver->save(animation2, TEST_OUTPUT_DIR"/test.gif") == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+static string _saveGif(uint32_t threads, uint32_t quality)
+{
+    return _save(threads, TEST_OUTPUT_DIR"/test.gif", [&](Saver* saver, string*) {
+        auto animation = Animation::gen();
+        if (animation->picture()->load(TEST_DIR"/test.json") != Result::Success) {
+            delete(animation);
+            return Result::Unknown;
+        }
+        animation->picture()->size(100, 100);
+
+        auto bg = Shape::gen();
+        bg->fill(255, 255, 255);
+        bg->appendRect(0, 0, 100, 100);
+        saver->background(bg);
+
+        return saver->save(animation, TEST_OUTPUT_DIR"/test.gif", quality);
+    });
+}
+
+TEST_CASE("Save a lottie into gif with threads", "[tvgSavers]") {
+    //the frames are encoded in parallel, the result must be the same as the sequential one.
+    auto sequential = _saveGif(0, 100);
+    REQUIRE(sequential.size() > 6);
+    REQUIRE(sequential.compare(0, 6, "GIF89a") == 0);
+    REQUIRE(sequential.back() == 0x3b);
+    REQUIRE(_saveGif(3, 100) == sequential);
+
+    //histogram quantizer
+    auto fast = _saveGif(0, 50);
+    REQUIRE(fast.size() > 6);
+    REQUIRE(fast.compare(0, 6, "GIF89a") == 0);
+    REQUIRE(fast.back() == 0x3b);
+    REQUIRE(fast != sequential);
+    REQUIRE(_saveGif(3, 50) == fast);
+}
+
+TEST_CASE("Save a lottie into gif through a function", "[tvgSavers]") {
+    auto expected = _saveGif(0, 100);
+    REQUIRE(!expected.empty());
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        struct Output {
+            string data;
+            uint32_t calls = 0;
+            uint32_t limit = UINT32_MAX;
+        };
+
+        auto write = [](const uint8_t* chunk, uint32_t size, void* data) -> bool {
+            auto output = static_cast<Output*>(data);
+            if (output->calls++ >= output->limit) return false;
+            output->data.append(reinterpret_cast<const char*>(chunk), size);
+            return true;
+        };
+
+        auto load = []() {
+            auto animation = Animation::gen();
+            auto picture = animation->picture();
+            picture->load(TEST_DIR"/test.json");
+            picture->size(100, 100);
+            return animation;
+        };
+
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver);
+
+        auto bg = Shape::gen();
+        REQUIRE(bg->fill(255, 255, 255) == Result::Success);
+        REQUIRE(bg->appendRect(0, 0, 100, 100) == Result::Success);
+        REQUIRE(saver->background(bg) == Result::Success);
+
+        //invalid arguments
+        REQUIRE(saver->save(nullptr, "gif", write, nullptr) == Result::InvalidArguments);
+        REQUIRE(saver->save(load(), "gif", nullptr, nullptr) == Result::InvalidArguments);
+        REQUIRE(saver->save(load(), "png", write, nullptr) == Result::NonSupport);
+
+        //the same data as the file, streamed frame by frame
+        Output output;
+        REQUIRE(saver->save(load(), "gif", write, &output) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+        REQUIRE(output.data == expected);
+        REQUIRE(output.calls > 1);
+
+        //aborted by the function
+        Output aborted;
+        aborted.limit = 2;
+        REQUIRE(saver->save(load(), "gif", write, &aborted) == Result::Success);
+        REQUIRE(saver->sync() == Result::Unknown);
+        REQUIRE(aborted.calls == 3);
+        REQUIRE(aborted.data == expected.substr(0, aborted.data.size()));
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Save a gif with the golden outputs", "[tvgSavers]")
+{
+    //the encoded streams must not be changed by the encoder optimizations, fnv-1a hashes of the known outputs.
+    struct Golden {
+        uint32_t quality;
+        bool background;
+        size_t size;
+        uint64_t hash;
+    } goldens[] = {
+        {100, false, 9803, 0x62e29bfbdfd344bcULL},
+        {100, true, 8862, 0xe9d01fbdce44bca0ULL},
+        {50, false, 9803, 0xaaff19627f620fa0ULL},
+        {50, true, 8862, 0x8d0204a93cca4ffbULL}
+    };
+
+    auto json = _rectsLottie();
+
+    REQUIRE(Initializer::init() == Result::Success);
+    for (auto& golden : goldens) {
+        auto animation = Animation::gen();
+        REQUIRE(animation->picture()->load(json.c_str(), json.size(), "lottie", nullptr, true) == Result::Success);
+
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        if (golden.background) {
+            auto bg = Shape::gen();
+            REQUIRE(bg->fill(255, 255, 255) == Result::Success);
+            REQUIRE(bg->appendRect(0, 0, 64, 64) == Result::Success);
+            REQUIRE(saver->background(bg) == Result::Success);
+        }
+
+        string output;
+        REQUIRE(saver->save(animation, "gif", _write, &output, golden.quality) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (auto c : output) hash = (hash ^ uint8_t(c)) * 0x100000001b3ULL;
+        REQUIRE(output.size() == golden.size);
+        REQUIRE(hash == golden.hash);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Save a gif with the changed areas of the frames", "[tvgSavers]")
+{
+    struct Rect {
+        uint32_t x, y, w, h;
+    };
+
+    //the image descriptors of the gif stream
+    auto rects = [](const string& gif) {
+        vector<Rect> rects;
+        auto p = reinterpret_cast<const uint8_t*>(gif.data());
+        auto end = p + gif.size();
+        p += 13 + 3 * (2 << (p[10] & 0x07));  //header, screen descriptor and the global color table
+        auto blocks = [&]() { while (p < end && *p) p += *p + 1; ++p; };
+        while (p < end && *p != 0x3b) {
+            if (*p == 0x21) {
+                p += 2;
+                blocks();
+            } else if (*p == 0x2c) {
+                rects.push_back({uint32_t(p[1] | p[2] << 8), uint32_t(p[3] | p[4] << 8), uint32_t(p[5] | p[6] << 8), uint32_t(p[7] | p[8] << 8)});
+                p += 10 + ((p[9] & 0x80) ? 3 * (2 << (p[9] & 0x07)) : 0) + 1;
+                blocks();
+            } else break;
+        }
+        return rects;
+    };
+
+    auto json = _rectsLottie();
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto background = [](Saver* saver) {
+            auto bg = Shape::gen();
+            bg->fill(255, 255, 255);
+            bg->appendRect(0, 0, 64, 64);
+            if (saver) saver->background(bg);
+            return bg;
+        };
+
+        //the frames of the saver are rendered for the expected areas
+        auto reference = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(reference->picture()->load(json.c_str(), json.size(), "lottie", nullptr, true) == Result::Success);
+        REQUIRE(reference->totalFrame() == 10.0f);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        static uint32_t frames[10][64 * 64];
+        static uint32_t visibles[10][64 * 64];
+        for (int bg = 0; bg < 2; ++bg) {
+            auto buffers = bg ? frames : visibles;
+            for (int i = 0; i < 10; ++i) {
+                REQUIRE(canvas->target(buffers[i], 64, 64, 64, ColorSpace::ARGB8888) == Result::Success);
+                if (i == 0) {
+                    REQUIRE(canvas->remove() == Result::Success);
+                    if (bg) REQUIRE(canvas->push(background(nullptr)) == Result::Success);
+                    REQUIRE(canvas->push(reference->picture()) == Result::Success);
+                }
+                reference->frame(float(i));
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+            }
+        }
+
+        //the bounding box of the pixels passing the test, 1x1 if nothing passes
+        auto bounds = [](function<bool(uint32_t x, uint32_t y)> test) {
+            uint32_t x0 = 64, y0 = 64, x1 = 0, y1 = 0;
+            for (uint32_t y = 0; y < 64; ++y) {
+                for (uint32_t x = 0; x < 64; ++x) {
+                    if (!test(x, y)) continue;
+                    x0 = std::min(x0, x);
+                    y0 = std::min(y0, y);
+                    x1 = std::max(x1, x + 1);
+                    y1 = std::max(y1, y + 1);
+                }
+            }
+            if (x1 <= x0) return Rect{0, 0, 1, 1};
+            return Rect{x0, y0, x1 - x0, y1 - y0};
+        };
+
+        for (int bg = 0; bg < 2; ++bg) {
+            auto animation = Animation::gen();
+            REQUIRE(animation->picture()->load(json.c_str(), json.size(), "lottie", nullptr, true) == Result::Success);
+
+            auto saver = unique_ptr<Saver>(Saver::gen());
+            if (bg) background(saver.get());
+
+            string output;
+            REQUIRE(saver->save(animation, "gif", _write, &output) == Result::Success);
+            REQUIRE(saver->sync() == Result::Success);
+
+            auto result = rects(output);
+            REQUIRE(result.size() == 10);
+
+            uint32_t minimals = 0;
+            for (int i = 0; i < 10; ++i) {
+                Rect expected;
+                if (bg) {
+                    //the changed pixels from the previous frame, the first frame is the whole canvas.
+                    if (i == 0) expected = {0, 0, 64, 64};
+                    else expected = bounds([&](uint32_t x, uint32_t y) { return frames[i][y * 64 + x] != frames[i - 1][y * 64 + x]; });
+                } else {
+                    //the visible pixels, the frame area is cleared before the next one.
+                    expected = bounds([&](uint32_t x, uint32_t y) { return (visibles[i][y * 64 + x] >> 24) >= 127; });
+                }
+                REQUIRE(result[i].x == expected.x);
+                REQUIRE(result[i].y == expected.y);
+                REQUIRE(result[i].w == expected.w);
+                REQUIRE(result[i].h == expected.h);
+                if (result[i].w == 1 && result[i].h == 1) ++minimals;
+            }
+            //the unchanged frames are written in the minimal area
+            REQUIRE(minimals == (bg ? 4 : 0));
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+#if defined(THORVG_PNG_SAVER_SUPPORT) && defined(THORVG_SVG_LOADER_SUPPORT)
+
+static string _savePng(uint32_t threads, uint32_t quality)
+{
+    return _save(threads, TEST_OUTPUT_DIR"/test.save.png", [&](Saver* saver, string*) {
+        auto picture = Picture::gen();
+        if (picture->load(TEST_DIR"/tiger.svg") != Result::Success) {
+            delete(picture);
+            return Result::Unknown;
+        }
+        picture->size(300, 300);
+        return saver->save(picture, TEST_OUTPUT_DIR"/test.save.png", quality);
+    });
+}
+
+TEST_CASE("Save a svg into png", "[tvgSavers]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        REQUIRE(picture->load(TEST_DIR"/tiger.svg") == Result::Success);
+        REQUIRE(picture->size(200, 100) == Result::Success);
+
+        auto bg = Shape::gen();
+        REQUIRE(bg->fill(255, 255, 255) == Result::Success);
+        REQUIRE(bg->appendRect(0, 0, 200, 100) == Result::Success);
+        REQUIRE(saver->background(bg) == Result::Success);
+
+        REQUIRE(saver->save(picture, TEST_OUTPUT_DIR"/test.save.png") == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        //read it back
+        auto saved = Picture::gen();
+        REQUIRE(saved);
+        REQUIRE(saved->load(TEST_OUTPUT_DIR"/test.save.png") == Result::Success);
+        float w, h;
+        REQUIRE(saved->size(&w, &h) == Result::Success);
+        REQUIRE(w == 200);
+        REQUIRE(h == 100);
+
+        //the same pixels as the rendering, they are opaque on the background
+        static uint32_t expected[200 * 100], actual[200 * 100];
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(expected, 200, 200, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto bg2 = Shape::gen();
+        REQUIRE(bg2->fill(255, 255, 255) == Result::Success);
+        REQUIRE(bg2->appendRect(0, 0, 200, 100) == Result::Success);
+        auto picture2 = Picture::gen();
+        REQUIRE(picture2->load(TEST_DIR"/tiger.svg") == Result::Success);
+        REQUIRE(picture2->size(200, 100) == Result::Success);
+        REQUIRE(canvas->push(bg2) == Result::Success);
+        REQUIRE(canvas->push(picture2) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(canvas->target(actual, 200, 200, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->remove() == Result::Success);
+        REQUIRE(canvas->push(saved) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(memcmp(expected, actual, sizeof(expected)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Save a svg into png with threads", "[tvgSavers]")
+{
+    //the row groups are compressed in parallel, the result must be the same as the sequential one.
+    auto sequential = _savePng(0, 100);
+    REQUIRE(sequential.size() > 8);
+    REQUIRE(sequential.compare(0, 8, "\x89PNG\r\n\x1a\n") == 0);
+    REQUIRE(sequential.compare(sequential.size() - 8, 4, "IEND") == 0);
+    REQUIRE(_savePng(3, 100) == sequential);
+
+    //the fastest compression
+    auto fast = _savePng(0, 0);
+    REQUIRE(fast.compare(0, 8, "\x89PNG\r\n\x1a\n") == 0);
+    REQUIRE(fast != sequential);
+    REQUIRE(_savePng(3, 0) == fast);
+}
+
+#endif
+
+#if defined(THORVG_Y4M_SAVER_SUPPORT) && defined(THORVG_LOTTIE_LOADER_SUPPORT)
+
+static string _saveY4m(uint32_t threads)
+{
+    return _save(threads, nullptr, [&](Saver* saver, string* output) {
+        auto animation = Animation::gen();
+        if (animation->picture()->load(TEST_DIR"/test.json") != Result::Success) {
+            delete(animation);
+            return Result::Unknown;
+        }
+        animation->picture()->size(99, 100);
+
+        return saver->save(animation, "y4m", _write, output);
+    });
+}
+
+TEST_CASE("Save a lottie into y4m", "[tvgSavers]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver);
+
+        //paint is not supported
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        REQUIRE(picture->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(saver->save(picture, TEST_OUTPUT_DIR"/test.y4m") == Result::Unknown);
+
+        auto animation = Animation::gen();
+        REQUIRE(animation);
+        REQUIRE(animation->picture()->load(TEST_DIR"/test.json") == Result::Success);
+        REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+        REQUIRE(saver->save(animation, TEST_OUTPUT_DIR"/test.y4m", 100, 30) == Result::Success);
         REQUIRE(saver->sync() == Result::Success);
     }
     REQUIRE(Initializer::term() == Result::Success);
+
+    ifstream file(TEST_OUTPUT_DIR"/test.y4m", ios::binary);
+    string data(istreambuf_iterator<char>(file), {});
+    REQUIRE(data.compare(0, 39, "YUV4MPEG2 W100 H100 F30:1 Ip A1:1 C420j") == 0);
+
+    //the high frame rates are kept
+    auto output = _save(0, nullptr, [](Saver* saver, string* output) {
+        auto animation = Animation::gen();
+        animation->picture()->load(TEST_DIR"/test.json");
+        animation->picture()->size(100, 100);
+        return saver->save(animation, "y4m", _write, output, 100, 120);
+    });
+    REQUIRE(output.compare(0, 40, "YUV4MPEG2 W100 H100 F120:1 Ip A1:1 C420j") == 0);
 }
-#endif
\ No newline at end of file
+
+TEST_CASE("Save a lottie into y4m with threads", "[tvgSavers]")
+{
+    //the frames are rendered ahead and converted in parallel, the result must be the same as the sequential one.
+    auto sequential = _saveY4m(0);
+    auto header = sequential.find('\n') + 1;
+    REQUIRE(header > 1);
+
+    //the odd width has the chroma of the rounded up width
+    auto frameSize = 6 + 99 * 100 + 2 * 50 * 50;
+    REQUIRE(sequential.size() > header);
+    REQUIRE((sequential.size() - header) % frameSize == 0);
+    for (auto i = header; i < sequential.size(); i += frameSize) {
+        REQUIRE(sequential.compare(i, 6, "FRAME\n") == 0);
+    }
+    REQUIRE(_saveY4m(3) == sequential);
+}
+
+TEST_CASE("Save a y4m with the known colors", "[tvgSavers]")
+{
+    //the odd size has the vectorized body, the scalar tail and the last row paired with itself
+    const uint32_t w = 61, h = 61;
+    auto json = _rectsLottie();
+
+    auto load = [&]() {
+        auto animation = Animation::gen();
+        animation->picture()->load(json.c_str(), json.size(), "lottie", nullptr, true);
+        animation->picture()->size(w, h);
+        return animation;
+    };
+    auto background = []() {
+        auto bg = Shape::gen();
+        bg->fill(255, 0, 0);
+        bg->appendRect(0, 0, 64, 64);
+        return bg;
+    };
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //the first frame in the premultiplied colors
+        vector<uint32_t> image(w * h);
+        auto reference = unique_ptr<Animation>(load());
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(image.data(), w, w, h, ColorSpace::ABGR8888) == Result::Success);
+        REQUIRE(canvas->push(background()) == Result::Success);
+        REQUIRE(canvas->push(reference->picture()) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        string output;
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver->background(background()) == Result::Success);
+        REQUIRE(saver->save(load(), "y4m", _write, &output) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        REQUIRE(output.compare(0, 39, "YUV4MPEG2 W61 H61 F10:1 Ip A1:1 C420jpe") == 0);
+        auto frame = output.find("FRAME\n");
+        REQUIRE(frame != string::npos);
+        auto yuv = reinterpret_cast<const uint8_t*>(output.data()) + frame + 6;
+        auto cw = (w + 1) / 2, ch = (h + 1) / 2;
+        auto u = yuv + w * h;
+        auto v = u + cw * ch;
+
+        //bt.601 limited range of the red background
+        REQUIRE(yuv[0] == 82);
+        REQUIRE(u[0] == 90);
+        REQUIRE(v[0] == 240);
+
+        //the scalar reference of the whole frame, the vectorized conversion must give the same values
+        auto px = [&](uint32_t x, uint32_t y) { return reinterpret_cast<const uint8_t*>(&image[min(y, h - 1) * w + min(x, w - 1)]); };
+        auto avg = [](int a, int b) { return (a + b + 1) >> 1; };
+        vector<uint8_t> expected(w * h + 2 * cw * ch);
+        for (uint32_t y = 0; y < h; ++y) {
+            for (uint32_t x = 0; x < w; ++x) {
+                auto p = px(x, y);
+                expected[y * w + x] = 16 + ((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8);
+            }
+        }
+        for (uint32_t y = 0; y < ch; ++y) {
+            for (uint32_t x = 0; x < cw; ++x) {
+                int c[3];
+                for (int i = 0; i < 3; ++i) {
+                    c[i] = avg(avg(px(x * 2, y * 2)[i], px(x * 2, y * 2 + 1)[i]), avg(px(x * 2 + 1, y * 2)[i], px(x * 2 + 1, y * 2 + 1)[i]));
+                }
+                expected[w * h + y * cw + x] = 128 + ((-38 * c[0] - 74 * c[1] + 112 * c[2] + 128) >> 8);
+                expected[w * h + cw * ch + y * cw + x] = 128 + ((112 * c[0] - 94 * c[1] - 18 * c[2] + 128) >> 8);
+            }
+        }
+        REQUIRE(memcmp(yuv, expected.data(), expected.size()) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
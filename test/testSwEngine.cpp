@@ -377,6 +377,63 @@ TEST_CASE("Image Draw", "[tvgSwEngine]")
 
     REQUIRE(Initializer::term() == Result::Success);
 }
+
+TEST_CASE("Image Downscaled Draw", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[16*16];
+        REQUIRE(canvas->target(buffer, 16, 16, 16, ColorSpace::ARGB8888) == Result::Success);
+
+        //1px checker pattern which must be averaged to the gray
+        auto data = (uint32_t*)malloc(sizeof(uint32_t) * (256*256));
+        for (int y = 0; y < 256; ++y) {
+            for (int x = 0; x < 256; ++x) {
+                data[y * 256 + x] = ((x + y) % 2) ? 0xffffffff : 0xff000000;
+            }
+        }
+
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+        REQUIRE(picture->load(data, 256, 256, ColorSpace::ARGB8888, true) == Result::Success);
+        REQUIRE(picture->size(16, 16) == Result::Success);
+
+        auto clipper = Shape::gen();
+        REQUIRE(clipper);
+        REQUIRE(clipper->appendCircle(8, 8, 6, 6) == Result::Success);
+
+        auto picture2 = picture->duplicate();
+        REQUIRE(picture2);
+        REQUIRE(picture2->clip(clipper) == Result::Success);
+
+        //scaled image
+        REQUIRE(canvas->push(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        for (int i = 0; i < 16*16; ++i) {
+            REQUIRE((buffer[i] >> 24) == 0xff);
+            REQUIRE(abs((int)(buffer[i] & 0xff) - 128) <= 2);
+        }
+
+        //scaled rle image
+        REQUIRE(canvas->remove() == Result::Success);
+        REQUIRE(canvas->push(picture2) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(abs((int)(buffer[8 * 16 + 8] & 0xff) - 128) <= 2);
+        REQUIRE(buffer[0] == 0);
+
+        free(data);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+
 TEST_CASE("Rect Draw", "[tvgSwEngine]")
 {
     REQUIRE(Initializer::init() == Result::Success);
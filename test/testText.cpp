@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <cstring>
+#include <vector>
 #include <thorvg.h>
 #include "config.h"
 #include "catch.hpp"
@@ -164,4 +165,218 @@ TEST_CASE("Text with composite glyphs", "[tvgText]")
     Initializer::term();
 }
 
+TEST_CASE("Text with the cached glyphs", "[tvgText]")
+{
+    Initializer::init();
+
+    REQUIRE(Text::load(TEST_DIR"/Arial.ttf") == tvg::Result::Success);
+
+    auto text = unique_ptr<Text>(Text::gen());
+    REQUIRE(text->font("Arial", 80) == tvg::Result::Success);
+    REQUIRE(text->text("0123") == tvg::Result::Success);
+
+    float x, y, w, h;
+    REQUIRE(text->bounds(&x, &y, &w, &h) == tvg::Result::Success);
+
+    //reuse the glyphs that were decoded by the previous texts
+    auto text2 = unique_ptr<Text>(Text::gen());
+    REQUIRE(text2->font("Arial", 80) == tvg::Result::Success);
+    REQUIRE(text2->text("3210") == tvg::Result::Success);
+    REQUIRE(text2->text("0123") == tvg::Result::Success);
+
+    float x2, y2, w2, h2;
+    REQUIRE(text2->bounds(&x2, &y2, &w2, &h2) == tvg::Result::Success);
+
+    REQUIRE(x == Approx(x2));
+    REQUIRE(y == Approx(y2));
+    REQUIRE(w == Approx(w2));
+    REQUIRE(h == Approx(h2));
+    REQUIRE(w > 0.0f);
+
+    Initializer::term();
+}
+
+TEST_CASE("Text with the edited contents", "[tvgText]")
+{
+    Initializer::init();
+
+    REQUIRE(Text::load(TEST_DIR"/Arial.ttf") == tvg::Result::Success);
+
+    auto text = unique_ptr<Text>(Text::gen());
+    REQUIRE(text->font("Arial", 80) == tvg::Result::Success);
+    REQUIRE(text->text("AVAV") == tvg::Result::Success);
+
+    float x, y, w, h;
+    REQUIRE(text->bounds(&x, &y, &w, &h) == tvg::Result::Success);
+
+    //relayout the glyphs after the changed one only
+    auto text2 = unique_ptr<Text>(Text::gen());
+    REQUIRE(text2->font("Arial", 80) == tvg::Result::Success);
+    REQUIRE(text2->text("AVTo thorvg") == tvg::Result::Success);
+    REQUIRE(text2->bounds(nullptr, nullptr, nullptr, nullptr) == tvg::Result::Success);
+    REQUIRE(text2->text("AV") == tvg::Result::Success);
+    REQUIRE(text2->bounds(nullptr, nullptr, nullptr, nullptr) == tvg::Result::Success);
+    REQUIRE(text2->text("AVAV") == tvg::Result::Success);
+
+    float x2, y2, w2, h2;
+    REQUIRE(text2->bounds(&x2, &y2, &w2, &h2) == tvg::Result::Success);
+
+    REQUIRE(x == Approx(x2));
+    REQUIRE(y == Approx(y2));
+    REQUIRE(w == Approx(w2));
+    REQUIRE(h == Approx(h2));
+
+    //the font size is applied without the relayout
+    REQUIRE(text2->font("Arial", 40) == tvg::Result::Success);
+    REQUIRE(text2->bounds(&x2, &y2, &w2, &h2) == tvg::Result::Success);
+    REQUIRE(w2 == Approx(w * 0.5f));
+    REQUIRE(h2 == Approx(h * 0.5f));
+
+    Initializer::term();
+}
+
+TEST_CASE("Text with the small font size", "[tvgText]")
+{
+    Initializer::init();
+
+    REQUIRE(Text::load(TEST_DIR"/Arial.ttf") == tvg::Result::Success);
+
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    uint32_t buffer[200*60];
+    REQUIRE(canvas->target(buffer, 200, 200, 60, ColorSpace::ARGB8888) == Result::Success);
+
+    //the same labels in the different pixel positions must be identical
+    for (int i = 0; i < 2; ++i) {
+        auto text = Text::gen();
+        REQUIRE(text->font("Arial", 12) == tvg::Result::Success);
+        REQUIRE(text->text("ThorVG 0123") == tvg::Result::Success);
+        REQUIRE(text->fill(255, 255, 255) == tvg::Result::Success);
+        REQUIRE(text->translate(2.25f + i * 100, 3.5f + i * 30) == tvg::Result::Success);
+        REQUIRE(canvas->push(text) == Result::Success);
+    }
+
+    REQUIRE(canvas->draw(true) == Result::Success);
+    REQUIRE(canvas->sync() == Result::Success);
+
+    auto drawn = 0;
+    auto diff = 0;
+    for (int y = 0; y < 30; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            auto a = int(buffer[y * 200 + x] >> 24);
+            auto b = int(buffer[(y + 30) * 200 + x + 100] >> 24);
+            if (abs(a - b) > diff) diff = abs(a - b);
+            if (a > 0) ++drawn;
+        }
+    }
+    REQUIRE(drawn > 0);
+    REQUIRE(diff <= 2);
+
+    Initializer::term();
+}
+
+//A minimal font of the square glyphs with the given cmap (format 12) groups and the kerning subtables.
+static vector<uint8_t> _font(const vector<uint32_t>& groups, const vector<vector<int>>& kerns)
+{
+    vector<uint8_t> cmap, glyf, head(54), hhea(36), hmtx, kern, loca;
+
+    auto u16 = [](vector<uint8_t>& t, uint32_t v) { t.push_back(uint8_t(v >> 8)); t.push_back(uint8_t(v)); };
+    auto u32 = [&](vector<uint8_t>& t, uint32_t v) { u16(t, v >> 16); u16(t, v & 0xffff); };
+    auto set16 = [](vector<uint8_t>& t, uint32_t at, uint32_t v) { t[at] = uint8_t(v >> 8); t[at + 1] = uint8_t(v); };
+
+    //unicode full repertory, format 12
+    u16(cmap, 0); u16(cmap, 1);
+    u16(cmap, 0); u16(cmap, 4); u32(cmap, 12);
+    u16(cmap, 12); u16(cmap, 0); u32(cmap, 16 + uint32_t(groups.size()) * 4); u32(cmap, 0); u32(cmap, uint32_t(groups.size() / 3));
+    for (auto v : groups) u32(cmap, v);
+
+    //glyph 0: empty, glyph 1 ~ 3: 500x500 squares
+    u16(loca, 0);
+    u16(loca, 0);
+    for (int i = 1; i < 4; ++i) {
+        u16(glyf, 1); u16(glyf, 0); u16(glyf, 0); u16(glyf, 500); u16(glyf, 500);
+        u16(glyf, 3); u16(glyf, 0);
+        for (int j = 0; j < 4; ++j) glyf.push_back(0x01);
+        for (auto v : {0, 500, 0, -500}) u16(glyf, uint16_t(v));
+        for (auto v : {0, 0, 500, 0}) u16(glyf, uint16_t(v));
+        u16(glyf, 0);
+        u16(loca, uint32_t(glyf.size() / 2));
+    }
+
+    set16(head, 18, 1000);      //units per em
+    set16(hhea, 4, 800);        //ascent
+    set16(hhea, 6, uint16_t(-200));
+    set16(hhea, 34, 4);         //long metrics
+    for (int i = 0; i < 4; ++i) {
+        u16(hmtx, 1000);
+        u16(hmtx, 0);
+    }
+
+    //horizontal kerning subtables, format 0: {left, right, value, ...}
+    u16(kern, 0); u16(kern, uint32_t(kerns.size()));
+    for (auto& sub : kerns) {
+        auto cnt = uint32_t(sub.size() / 3);
+        u16(kern, 0); u16(kern, 14 + cnt * 6); kern.push_back(0); kern.push_back(0x01);
+        u16(kern, cnt); u16(kern, 0); u16(kern, 0); u16(kern, 0);
+        for (auto v : sub) u16(kern, uint16_t(v));
+    }
+
+    //the tables in the tag order
+    vector<pair<const char*, vector<uint8_t>*>> tables = {{"cmap", &cmap}, {"glyf", &glyf}, {"head", &head}, {"hhea", &hhea}, {"hmtx", &hmtx}, {"kern", &kern}, {"loca", &loca}};
+    vector<uint8_t> font;
+    u32(font, 0x00010000); u16(font, uint32_t(tables.size())); u16(font, 0); u16(font, 0); u16(font, 0);
+    auto offset = uint32_t(12 + tables.size() * 16);
+    for (auto& t : tables) {
+        font.insert(font.end(), t.first, t.first + 4);
+        u32(font, 0); u32(font, offset); u32(font, uint32_t(t.second->size()));
+        offset += uint32_t(t.second->size() + 3) & ~3u;
+    }
+    for (auto& t : tables) {
+        font.insert(font.end(), t.second->begin(), t.second->end());
+        font.resize((font.size() + 3) & ~size_t(3));
+    }
+    return font;
+}
+
+
+static float _width(const char* str)
+{
+    auto text = unique_ptr<Text>(Text::gen());
+    if (text->font("Square", 100) != tvg::Result::Success) return 0.0f;
+    if (text->text(str) != tvg::Result::Success) return 0.0f;
+    float w;
+    if (text->bounds(nullptr, nullptr, &w, nullptr) != tvg::Result::Success) return 0.0f;
+    return w;
+}
+
+
+TEST_CASE("Text with the crafted cmap and kerning tables", "[tvgText]")
+{
+    //'A', 'B': the codepoint pages, U+0100: an oversized group left to the subtable lookup.
+    //the many full range groups must not stall the font open.
+    vector<uint32_t> groups = {0x41, 0x42, 1};
+    for (int i = 0; i < 4096; ++i) {
+        groups.push_back(0x100);
+        groups.push_back(0x10ffff);
+        groups.push_back(3);
+    }
+
+    //the first one of the duplicated pairs wins
+    vector<vector<int>> kerns = {{1, 2, -150, 1, 2, -100}};
+
+    auto font = _font(groups, kerns);
+
+    Initializer::init();
+
+    REQUIRE(Text::load("Square", (const char*)font.data(), uint32_t(font.size()), "ttf", true) == tvg::Result::Success);
+
+    auto AA = _width("AA");
+    REQUIRE(AA > 0.0f);
+    REQUIRE(_width("A\xc4\x80") == Approx(AA));     //U+0100
+    REQUIRE(_width("AB") == Approx(AA * (850.0f + 500.0f) / (1000.0f + 500.0f)));
+
+    REQUIRE(Text::load("Square", nullptr, 0) == tvg::Result::Success);
+
+    Initializer::term();
+}
+
 #endif
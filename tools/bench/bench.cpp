@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2025 the ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string.h>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <thorvg.h>
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #ifndef PATH_MAX
+        #define PATH_MAX MAX_PATH
+    #endif
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <limits.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace tvg;
+
+
+//the per frame phases in milliseconds
+struct Phases
+{
+   vector<double> update;  //scene update including the animation frame
+   vector<double> draw;    //raster requests, the rasterization itself if no threads
+   vector<double> sync;    //waiting for the rasterization and the post effects
+   vector<double> frame;   //sum of the above
+};
+
+
+struct App
+{
+private:
+   char full[PATH_MAX];    //full path
+   uint32_t width = 512;
+   uint32_t height = 512;
+   uint32_t frames = 100;
+   uint32_t warmup = 10;
+   uint32_t threads = thread::hardware_concurrency();
+   string engine = "sw";
+   const char* output = nullptr;
+   vector<uint32_t> buffer;
+   stringstream results;
+   uint32_t count = 0;
+
+   void helpMsg()
+   {
+      cout << "Usage: \n   tvg-bench [file] or [folder] [-r resolution] [-n frames] [-w warm-up frames] [-t threads] [-e engine] [-o output]\n\n"
+              "Renders the SVG, Lottie and image files and reports the per phase timings in JSON.\n"
+              "Static contents are moved by a sub-pixel every frame to be fully redrawn.\n"
+              "Only the sw engine is supported, the gl and wg engines require the window contexts of the platforms.\n\n"
+              "Examples: \n    $ tvg-bench input.json\n    $ tvg-bench input.svg -r 1024x1024 -n 300\n    $ tvg-bench folder -t 4 -w 20\n    $ tvg-bench folder -t 0 -o result.json\n\n";
+   }
+
+   bool validate(const string& name)
+   {
+      static const char* extns[] = {".svg", ".json", ".lot", ".png", ".jpg", ".jpeg", ".webp"};
+
+      for (auto extn : extns) {
+         auto len = strlen(extn);
+         if (name.size() > len && name.compare(name.size() - len, len, extn) == 0) return true;
+      }
+      return false;
+   }
+
+   static double elapsed(chrono::steady_clock::time_point& begin)
+   {
+      auto now = chrono::steady_clock::now();
+      auto ms = chrono::duration<double, milli>(now - begin).count();
+      begin = now;
+      return ms;
+   }
+
+   //nearest-rank percentile of the sorted samples
+   static double percentile(const vector<double>& sorted, double p)
+   {
+      auto rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+      return sorted[rank > 0 ? rank - 1 : 0];
+   }
+
+   static void report(stringstream& out, const char* name, vector<double> samples)
+   {
+      sort(samples.begin(), samples.end());
+      double sum = 0.0;
+      for (auto s : samples) sum += s;
+
+      out << "\"" << name << "\": {\"min\": " << samples.front() << ", \"mean\": " << sum / samples.size()
+          << ", \"p50\": " << percentile(samples, 50) << ", \"p90\": " << percentile(samples, 90)
+          << ", \"p99\": " << percentile(samples, 99) << ", \"max\": " << samples.back() << "}";
+   }
+
+   static string escape(const string& str)
+   {
+      string out;
+      for (auto c : str) {
+         if (c == '"' || c == '\\') out += '\\';
+         out += c;
+      }
+      return out;
+   }
+
+   bool run(const string& path, Phases& phases, double& load, const char*& type)
+   {
+      auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+      if (!canvas || canvas->target(buffer.data(), width, width, height, ColorSpace::ARGB8888) != Result::Success) return false;
+
+      auto begin = chrono::steady_clock::now();
+
+      auto animation = unique_ptr<Animation>(Animation::gen());
+      auto picture = animation->picture();
+      if (picture->load(path.c_str()) != Result::Success) return false;
+
+      //fit in the canvas keeping the aspect ratio
+      float w, h;
+      picture->size(&w, &h);
+      if (w <= 0.0f || h <= 0.0f) return false;
+      auto scale = min(width / w, height / h);
+      picture->size(w * scale, h * scale);
+
+      load = elapsed(begin);
+
+      auto totalFrame = animation->totalFrame();
+      type = (totalFrame > 0.0f) ? "animation" : "static";
+
+      canvas->push(picture);
+
+      for (uint32_t i = 0; i < warmup + frames; ++i) {
+         begin = chrono::steady_clock::now();
+
+         if (totalFrame > 0.0f) animation->frame(totalFrame * static_cast<float>(i % frames) / static_cast<float>(frames));
+         else picture->translate((i % 2) ? 0.01f : 0.0f, 0.0f);
+         canvas->update();
+         auto update = elapsed(begin);
+         canvas->draw(true);
+         auto draw = elapsed(begin);
+         canvas->sync();
+         auto sync = elapsed(begin);
+
+         if (i < warmup) continue;
+
+         phases.update.push_back(update);
+         phases.draw.push_back(draw);
+         phases.sync.push_back(sync);
+         phases.frame.push_back(update + draw + sync);
+      }
+
+      //the animation holds the picture
+      canvas->remove();
+
+      return true;
+   }
+
+   void bench(const string& path)
+   {
+      Phases phases;
+      double load = 0.0;
+      const char* type = nullptr;
+
+      if (!run(path, phases, load, type)) {
+         cerr << "Failed to benchmark : " << path << endl;
+         return;
+      }
+
+      if (count++ > 0) results << ",\n";
+      results << "    {\"file\": \"" << escape(path) << "\", \"type\": \"" << type << "\", \"load\": " << load << ",\n     ";
+      report(results, "update", phases.update);
+      results << ",\n     ";
+      report(results, "draw", phases.draw);
+      results << ",\n     ";
+      report(results, "sync", phases.sync);
+      results << ",\n     ";
+      report(results, "frame", phases.frame);
+      results << "}";
+
+      cerr << "Benchmarked : " << path << endl;
+   }
+
+   const char* realPath(const char* path)
+   {
+#ifdef _WIN32
+      return _fullpath(full, path, PATH_MAX);
+#else
+      return realpath(path, full);
+#endif
+   }
+
+   bool isDirectory(const char* path)
+   {
+#ifdef _WIN32
+      DWORD attr = GetFileAttributes(path);
+      if (attr == INVALID_FILE_ATTRIBUTES) return false;
+      return attr & FILE_ATTRIBUTE_DIRECTORY;
+#else
+      struct stat buf;
+      if (stat(path, &buf) != 0) return false;
+      return S_ISDIR(buf.st_mode);
+#endif
+   }
+
+   //the files in the name order for the reproducible results
+   bool handleDirectory(const string& path)
+   {
+        vector<string> files;
+#ifdef _WIN32
+        //open directory
+        WIN32_FIND_DATA fd;
+        HANDLE h = FindFirstFileEx((path + "\\*").c_str(), FindExInfoBasic, &fd, FindExSearchNameMatch, NULL, 0);
+        if (h == INVALID_HANDLE_VALUE) {
+            cerr << "Couldn't open directory \"" << path.c_str() << "\"." << endl;
+            return false;
+        }
+        //List directories
+        do {
+            if (*fd.cFileName == '.' || *fd.cFileName == '$') continue;
+            string name = path + '\\' + fd.cFileName;
+            //sub directory
+            if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) files.push_back(name + '\\');
+            //file
+            else if (validate(name)) files.push_back(name);
+        } while (FindNextFile(h, &fd));
+
+        FindClose(h);
+#else
+        //open directory
+        auto dir = opendir(path.c_str());
+        if (!dir) {
+            cerr << "Couldn't open directory \"" << path.c_str() << "\"." << endl;
+            return false;
+        }
+        //List directories
+        while (auto entry = readdir(dir)) {
+            if (*entry->d_name == '.' || *entry->d_name == '$') continue;
+            string name = path + '/' + entry->d_name;
+            //sub directory
+            if (entry->d_type == DT_DIR) files.push_back(name + '/');
+            //file
+            else if (validate(name)) files.push_back(name);
+        }
+        closedir(dir);
+#endif
+        sort(files.begin(), files.end());
+        for (auto& name : files) {
+            if (name.back() == '/' || name.back() == '\\') handleDirectory(name.substr(0, name.size() - 1));
+            else bench(name);
+        }
+        return true;
+    }
+
+public:
+   int setup(int argc, char** argv)
+   {
+      //Collect input files
+      vector<const char*> inputs;
+
+      for (int i = 1; i < argc; ++i) {
+         const char* p = argv[i];
+         if (*p == '-') {
+            const char* p_arg = (i + 1 < argc) ? argv[++i] : nullptr;
+
+            //image resolution
+            if (p[1] == 'r') {
+               if (!p_arg) {
+                  cerr << "Error: Missing resolution attribute. Expected eg. -r 600x600." << endl;
+                  return 1;
+               }
+
+               const char* x = strchr(p_arg, 'x');
+               auto w = x ? atoi(p_arg) : 0;
+               auto h = x ? atoi(x + 1) : 0;
+               if (w <= 0 || h <= 0) {
+                  cerr << "Error: Resolution (" << p_arg << ") is corrupted. Expected eg. -r 600x600." << endl;
+                  return 1;
+               }
+               width = w;
+               height = h;
+            //frames
+            } else if (p[1] == 'n') {
+               if (!p_arg || atoi(p_arg) <= 0) {
+                  cerr << "Error: Missing frame count. Expected eg. -n 100." << endl;
+                  return 1;
+               }
+               frames = atoi(p_arg);
+            //warm-up frames
+            } else if (p[1] == 'w') {
+               if (!p_arg || atoi(p_arg) < 0) {
+                  cerr << "Error: Missing warm-up frame count. Expected eg. -w 10." << endl;
+                  return 1;
+               }
+               warmup = atoi(p_arg);
+            //threads
+            } else if (p[1] == 't') {
+               if (!p_arg || atoi(p_arg) < 0) {
+                  cerr << "Error: Missing thread count. Expected eg. -t 4." << endl;
+                  return 1;
+               }
+               threads = atoi(p_arg);
+            //engine
+            } else if (p[1] == 'e') {
+               if (!p_arg) {
+                  cerr << "Error: Missing engine name. Expected eg. -e sw." << endl;
+                  return 1;
+               }
+               engine = p_arg;
+               //gl and wg require the window contexts of the platforms
+               if (engine != "sw") {
+                  cerr << "Error: Engine (" << p_arg << ") is not supported. Expected eg. -e sw." << endl;
+                  return 1;
+               }
+            //output file
+            } else if (p[1] == 'o') {
+               if (!p_arg) {
+                  cerr << "Error: Missing output file. Expected eg. -o result.json." << endl;
+                  return 1;
+               }
+               output = p_arg;
+            } else {
+               cerr << "Warning: Unknown flag (" << p << ")." << endl;
+            }
+         } else {
+            inputs.push_back(argv[i]);
+         }
+      }
+
+      //No Input
+      if (inputs.empty()) {
+         helpMsg();
+         return 0;
+      }
+
+      if (Initializer::init(threads) != Result::Success) {
+         cerr << "Error: Failed to initialize the engine." << endl;
+         return 1;
+      }
+
+      buffer.resize(width * height);
+
+      for (auto input : inputs) {
+         auto path = realPath(input);
+         if (!path) {
+            cerr << "Invalid file or path name: \"" << input << "\"" << endl;
+            continue;
+         }
+
+         if (isDirectory(path)) handleDirectory(path);
+         else if (validate(path)) bench(path);
+      }
+
+      Initializer::term();
+
+      stringstream json;
+      json << "{\n  \"engine\": \"" << engine << "\", \"threads\": " << threads << ", \"width\": " << width << ", \"height\": " << height
+           << ", \"frames\": " << frames << ", \"warmup\": " << warmup << ",\n  \"results\": [\n" << results.str() << "\n  ]\n}\n";
+
+      if (output) {
+         ofstream file(output);
+         if (!file) {
+            cerr << "Error: Couldn't write \"" << output << "\"." << endl;
+            return 1;
+         }
+         file << json.str();
+      } else cout << json.str();
+
+      return 0;
+   }
+};
+
+
+int main(int argc, char **argv)
+{
+   App app;
+   return app.setup(argc, argv);
+}
@@ -47,6 +47,7 @@ struct App
 private:
    char full[PATH_MAX];    //full path
    uint32_t fps = 30;
+   uint32_t quality = 100;
    uint32_t width = 600;
    uint32_t height = 600;
    uint8_t r, g, b;        //background color
@@ -54,7 +55,7 @@ private:
 
    void helpMsg()
    {
-      cout << "Usage: \n   tvg-lottie2gif [Lottie file] or [Lottie folder] [-r resolution] [-f fps] [-b background color]\n\nExamples: \n    $ tvg-lottie2gif input.json\n    $ tvg-lottie2gif input.json -r 600x600\n    $ tvg-lottie2gif input.json -f 30\n    $ tvg-lottie2gif input.json -r 600x600 -f 30\n    $ tvg-lottie2gif lottiefolder\n    $ tvg-lottie2gif lottiefolder -r 600x600 -f 30 -b fa7410\n\n";
+      cout << "Usage: \n   tvg-lottie2gif [Lottie file] or [Lottie folder] [-r resolution] [-f fps] [-b background color] [-q quality]\n\nExamples: \n    $ tvg-lottie2gif input.json\n    $ tvg-lottie2gif input.json -r 600x600\n    $ tvg-lottie2gif input.json -f 30\n    $ tvg-lottie2gif input.json -r 600x600 -f 30\n    $ tvg-lottie2gif lottiefolder\n    $ tvg-lottie2gif lottiefolder -r 600x600 -f 30 -b fa7410\n    $ tvg-lottie2gif lottiefolder -q 50\n\n";
    }
 
    bool validate(string& lottieName)
@@ -90,7 +91,7 @@ private:
          bg->appendRect(0, 0, width * scale, height * scale);
          saver->background(bg);
       }
-      if (saver->save(animation, out.c_str(), 100, fps) != Result::Success) return false;
+      if (saver->save(animation, out.c_str(), quality, fps) != Result::Success) return false;
       if (saver->sync() != Result::Success) return false;
 
       if (Initializer::term() != Result::Success) return false;
@@ -228,6 +229,13 @@ public:
                   return 1;
                }
                fps = atoi(p_arg);
+            //quality
+            } else if (p[1] == 'q') {
+               if (!p_arg) {
+                  cout << "Error: Missing quality value. Expected eg. -q 50." << endl;
+                  return 1;
+               }
+               quality = atoi(p_arg);
             } else if (p[1] == 'b') {
                //background color
                if (!p_arg) {